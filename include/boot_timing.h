@@ -0,0 +1,41 @@
+#pragma once
+//
+// Časy jednotlivých fází startu (µs od spuštění aplikace, micros()).
+//
+// Start je rozdělený podle toho, co je po výpadku napájení vidět nejdřív:
+//   setup() (jádro 1): DMX/IR driver → konfigurace z NVS → signálová úloha
+//   UI úloha (jádro 0): displej → LittleFS (show) → WiFi AP ve vlastní úloze
+// Signálová cesta tak nečeká na displej, WiFi ani formátování flash.
+//
+// Každá fáze se zapíše jen poprvé (z libovolné úlohy – 32bitový zápis je
+// atomický). Souhrn jde na sériovou linku a do /metrics.
+//
+#include <Arduino.h>
+#include "req_arena.h"
+
+// Cíl: od startu aplikace po připravenost přijmout/poslat IR (BOOT_SIGNAL_READY)
+#define BOOT_TARGET_IR_READY_MS 250
+
+enum BootPhase : uint8_t {
+  BOOT_SETUP,          // začátek setup()
+  BOOT_SIGNAL_IO,      // DMX driver a IR přijímač/vysílač nainstalovány
+  BOOT_CONFIG,         // konfigurace načtena z NVS
+  BOOT_SIGNAL_READY,   // signálová úloha běží (a případně obnovila poslední režim)
+  BOOT_DISPLAY,        // displej inicializován, první obrazovka vykreslena
+  BOOT_STORAGE,        // LittleFS připojen, úloha show běží
+  BOOT_WIFI,           // AP a HTTP server běží
+  BOOT_FIRST_IR,       // první IR spouštěč (přijatý kód v IR→DMX / odeslaný v DMX→IR)
+  BOOT_PHASES
+};
+
+void bootMark(BootPhase phase);
+
+// 0 = fáze ještě neproběhla
+uint32_t bootPhaseUs(BootPhase phase);
+const char *bootPhaseName(BootPhase phase);
+
+// Souhrn na Serial (volá UI úloha, až doběhnou fáze před BOOT_FIRST_IR)
+void bootReport();
+
+// Řádky boot_<fáze>_us do /metrics
+void appendBootMetrics(ArenaText &out);
@@ -0,0 +1,77 @@
+#pragma once
+//
+// Celá konfigurace převodníku jako jeden binární blob – záloha, klonování
+// a atomické uložení do NVS (jeden klíč = jeden zápis, který buď proběhne
+// celý, nebo vůbec).
+//
+//   hlavička (16 B): "DXCF" | u8 verze | u8 flags | u16 rezerva | u32 LE délka dat | u32 LE CRC-32 dat
+//   data:            sekce { u8 id | u16 LE délka | obsah }...
+//
+// Neznámé sekce se při čtení přeskočí a chybějící ponechají výchozí hodnoty,
+// takže starší firmware přečte novější blob se stejnou hlavní verzí a naopak.
+// Všechna čísla jsou little-endian, struktury se neukládají "jak leží v paměti".
+// Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+#include "cue_engine.h"
+#include "dmx_merge.h"
+#include "output_curves.h"
+#include "ir_nudge.h"
+
+#define CONFIG_MAGIC       "DXCF"
+#define CONFIG_VERSION     1
+#define CONFIG_HEADER_SIZE 16
+#define CONFIG_MAX_SIZE    2048
+
+#define CONFIG_SCENES      6
+#define CONFIG_SCENE_CH    64
+#define CONFIG_MERGE_PRIOS 4      // priority v sekci MERGE (MERGE_SRC_INPUT je v THRU)
+
+enum ConfigSection : uint8_t {
+  CFG_SEC_IR_CODES = 1,   // 6 × u32 (kanály 1..6)
+  CFG_SEC_SCENES   = 2,   // 6 × 64 B
+  CFG_SEC_CUES     = 3,   // u8 počet | 16 × {u8 scéna, u16 fade ms, u16 wait ms}
+  CFG_SEC_CHASE    = 4,   // u8 počet | 16 × u8 scéna | u16 BPM | u8 fade %
+  CFG_SEC_CUE_IR   = 5,   // u8 CueMode | 3 × u32 (GO, BACK, PAUSE)
+  CFG_SEC_MERGE    = 6,   // 4 × u8 priorita (scéna, cue, show, web) | 64 B bitmapa LTP kanálů
+  CFG_SEC_THRU     = 7,   // u8 priorita vstupu v průchozím režimu
+  CFG_SEC_CURVES   = 8,   // u8 počet profilů | počet × {u8 typ, u8 gamma×10, u8 min, u8 max, u8 inverze, 5 × u8 bod}
+                          // | 256 B profil kanálu po 4 bitech (kanál 2k v dolní polovině bajtu k)
+  CFG_SEC_NUDGE    = 9    // u8 počet akcí | počet × {u32 kód, u8 NudgeKind, u8 skupina}
+                          // | u8 počet skupin | počet × 64 B bitmapa | u8 krok | u16 rampa start, max [/s] | u16 zrychlení ms
+};
+
+enum ConfigError : uint8_t {
+  CONFIG_OK,
+  CONFIG_ERR_SIZE,        // kratší než hlavička / delší než CONFIG_MAX_SIZE / nesedí délka
+  CONFIG_ERR_MAGIC,
+  CONFIG_ERR_VERSION,     // novější hlavní verze
+  CONFIG_ERR_CRC,
+  CONFIG_ERR_SECTION      // poškozená sekce
+};
+
+struct DeviceConfig {
+  uint32_t irCodes[8];                          // index 1..6
+  uint8_t  scenes[CONFIG_SCENES][CONFIG_SCENE_CH];
+  CueList  cueList;
+  Chase    chase;
+  CueMode  cueMode;
+  uint32_t cueIrCodes[3];
+  uint8_t  mergePriorities[MERGE_SOURCES];
+  uint8_t  mergeLtpBits[MERGE_CHANNELS / 8];
+  CurveConfig curves;
+  NudgeConfig nudge;
+};
+
+// Výchozí (tovární) konfigurace
+void configDefaults(DeviceConfig &cfg);
+
+// Zapíše blob do out; vrací délku, 0 = nevejde se do max
+size_t configSerialize(const DeviceConfig &cfg, uint8_t *out, size_t max);
+
+// Ověří celý blob (hlavička, CRC, sekce) a teprve pak ho přepíše do cfg –
+// při chybě zůstane cfg beze změny
+ConfigError configParse(const uint8_t *in, size_t len, DeviceConfig &cfg);
+
+const char *configErrorName(ConfigError err);
@@ -0,0 +1,17 @@
+#pragma once
+//
+// CRC-32 (IEEE 802.3, stejné jako zlib/PNG: poly 0xEDB88320, init a xorout 0xFFFFFFFF).
+// Bez tabulky – data jsou malá a flash/RAM jsou dražší než pár cyklů.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+// Průběžný výpočet: crc = crc32Update(0, ...); crc = crc32Update(crc, ...)
+static inline uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
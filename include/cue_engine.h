@@ -0,0 +1,121 @@
+#pragma once
+//
+// Cue list a chase nad uloženými scénami.
+//
+// Čistý C++ bez Arduina a bez vlastních hodin: čas dostává tick() zvenku,
+// takže se dá spouštět na PC se simulovanými hodinami a výsledek je pro
+// stejnou posloupnost časů vždy stejný. V zařízení ho volá signálová úloha
+// jednou za vysílaný DMX rámec s časem odvozeným z počtu rámců (CUE_TICK_MS).
+//
+// Cue list: GO přejde na další cue (prolínání z aktuálního výstupu za fadeMs),
+// BACK na předchozí, cue s waitMs > 0 po dokončení prolínání a čekání
+// pokračuje sám. Chase: kroky se střídají v rytmu BPM, fadePct udává podíl
+// kroku, po který se prolíná z předchozího; GO/BACK posune o krok.
+// PAUSE zmrazí čas (prolínání i chase stojí), další PAUSE pokračuje.
+//
+// Časy se počítají vždy od začátku cue/chase, ne přičítáním po ticích,
+// takže se ani při dlouhém běhu nic nenačítá a neujíždí.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define CUE_MAX_CUES   16
+#define CUE_MAX_STEPS  16
+#define CUE_CHANNELS   64      // = SIGNAL_SCENE_CH
+#define CUE_TICK_MS    25      // perioda vysílání v IR→DMX (40 Hz)
+#define CUE_NONE       0xFF
+
+enum CueMode : uint8_t {
+  CUE_MODE_OFF,     // jen statické scény podle IR kódů
+  CUE_MODE_LIST,
+  CUE_MODE_CHASE
+};
+
+enum CueCommand : uint8_t {
+  CUE_GO,
+  CUE_BACK,
+  CUE_PAUSE
+};
+
+struct Cue {
+  uint8_t  scene;    // 0..5
+  uint16_t fadeMs;
+  uint16_t waitMs;   // 0 = čeká na GO, jinak automatické pokračování
+};
+
+struct CueList {
+  uint8_t count;
+  Cue     cues[CUE_MAX_CUES];
+};
+
+struct Chase {
+  uint8_t  count;
+  uint8_t  steps[CUE_MAX_STEPS];   // scény 0..5
+  uint16_t bpm;
+  uint8_t  fadePct;                // 0 = skok, 100 = prolínání celý krok
+};
+
+// Stav pro UI
+struct CueStatus {
+  CueMode mode;
+  bool    active;     // výstup řídí engine (ne statická scéna)
+  bool    paused;
+  uint8_t index;      // cue nebo krok chase, CUE_NONE = před prvním GO
+  uint8_t count;
+};
+
+class CueEngine {
+ public:
+  CueEngine();
+
+  // Scény čte engine přímo z pole vlastníka (signálová úloha)
+  void setScenes(const uint8_t (*scenes)[CUE_CHANNELS], uint8_t count);
+  void setCueList(const CueList &list);
+  void setChase(const Chase &chase);
+  void setMode(CueMode mode);
+
+  // Výstup převzala statická scéna – engine se uvolní, další GO prolíná z ní
+  void release(const uint8_t *levels);
+
+  void command(CueCommand cmd, uint32_t nowMs);
+
+  // Spočítá výstup pro čas nowMs. false = engine výstup neřídí.
+  bool tick(uint32_t nowMs, uint8_t *out);
+
+  CueStatus status() const;
+
+ private:
+  uint32_t localTime(uint32_t nowMs) const;
+  void startCue(uint8_t index, uint32_t t);
+  void renderList(uint32_t t, uint8_t *out);
+  void renderChase(uint32_t t, uint8_t *out);
+  const uint8_t *sceneLevels(uint8_t scene) const;
+
+  const uint8_t (*scenes)[CUE_CHANNELS];
+  uint8_t  sceneCount;
+  CueList  list;
+  Chase    chase;
+  CueMode  mode;
+
+  bool     active;
+  bool     paused;
+  uint32_t pausedAt;     // lokální čas v okamžiku pauzy
+  uint32_t pauseTotal;   // součet pauz – lokální čas = now - pauseTotal
+
+  // cue list
+  uint8_t  cur;
+  uint32_t cueStart;
+  uint8_t  from[CUE_CHANNELS];    // výstup v okamžiku GO
+  uint8_t  last[CUE_CHANNELS];    // poslední výstup
+
+  // chase
+  uint32_t chaseStart;
+  int32_t  stepOffset;            // posun z GO/BACK
+  uint8_t  lastStep;              // naposledy vykreslený krok (pro status)
+};
+
+// Lineární prolínání a → b, pos/len v 0..1 (celočíselně, bez driftu)
+static inline uint8_t cueMix(uint8_t a, uint8_t b, uint32_t pos, uint32_t len) {
+  if (!len || pos >= len) return b;
+  return (uint8_t)(a + ((int32_t)b - a) * (int32_t)pos / (int32_t)len);
+}
@@ -0,0 +1,38 @@
+#pragma once
+//
+// Detekce změny DMX rámce proti předchozímu.
+//
+// Pult posílá skoro pořád stejný rámec. FrameStore si u každého zveřejněného
+// rámce poznamená, jestli se od předchozího liší (changedSeq), a /dmx?since=
+// pak monitoru, který rámec už má, kanály znovu neposílá. Porovnává se po
+// 32bitových slovech (128 porovnání na 512 kanálů).
+//
+// Bitmapu změněných kanálů pro DMX→IR nepoužíváme: hrany na kanálech 1..6
+// jsou šest porovnání bajtů a displej už kreslí jen změněné widgety, takže
+// bitmapa rámec jen zdražila (tools/host_bench.py dmx_change).
+//
+// Kanály se čtou po slovech, proto musí začínat na hranici 4 B
+// (DmxFrame::slots + 1, frame_store.h). Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define DMX_CHANGE_CHANNELS 512
+
+class DmxChangeDetector {
+ public:
+  DmxChangeDetector() { reset(); }
+
+  // Další rámec se bere jako změněný (nový režim, výpadek signálu)
+  void reset();
+
+  // Porovná kanály 1..count (channels[0] = kanál 1, zarovnáno na 4 B)
+  // s minulým rámcem a zapamatuje si je. Kanály, které z kratšího rámce
+  // vypadly, se berou jako změna na 0. Vrací true, pokud se rámec liší.
+  bool update(const uint8_t *channels, uint16_t count);
+
+ private:
+  uint32_t prev_[DMX_CHANGE_CHANNELS / 4];
+  uint16_t prevCount_;
+  bool     all_;
+};
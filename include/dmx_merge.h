@@ -0,0 +1,93 @@
+#pragma once
+//
+// Slučování více zdrojů DMX do jednoho výstupního univerza.
+//
+// Každý zdroj má prioritu a pokrytí (které kanály právě řídí). Pro každý kanál
+// rozhoduje nejvyšší priorita mezi zdroji, které ho pokrývají; mezi zdroji se
+// stejnou prioritou platí HTP (vyšší hodnota), nebo LTP (poslední změna) pro
+// kanály označené setLtp(). Nepokrytý kanál je 0.
+//
+// merge() běží jednou za vysílaný rámec nad celým univerzem a zpracovává
+// 4 kanály najednou v 32bitových slovech (SWAR max/maska bez větvení);
+// dmxMergeScalar() je referenční verze po bajtech pro benchmark a kontrolu.
+// Čistý C++ bez Arduina – jde spustit i na PC.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define MERGE_CHANNELS  512
+#define MERGE_WORDS     (MERGE_CHANNELS / 4)
+#define MERGE_SOURCES   5
+
+enum MergeSource : uint8_t {
+  MERGE_SRC_SCENE,    // statická scéna vybraná IR kódem
+  MERGE_SRC_CUE,      // cue list / chase
+  MERGE_SRC_SHOW,     // přehrávaný záznam
+  MERGE_SRC_WEB,      // živé přepsání kanálů z webu
+  MERGE_SRC_INPUT     // přijaté univerzum v průchozím režimu (dmx_thru.h)
+};
+
+// Vstup pod scénou = IR scény kanály přepisují; stejná priorita = HTP vkládání
+#define MERGE_DEFAULT_PRIORITIES { 100, 100, 150, 200, 50 }
+
+class DmxMerger {
+ public:
+  DmxMerger();
+
+  void setPriority(MergeSource src, uint8_t prio) { prio_[src] = prio; }
+  uint8_t priority(MergeSource src) const { return prio_[src]; }
+
+  // Kanál ch (0 = DMX kanál 1) se slučuje LTP místo HTP
+  void setLtp(uint16_t ch, bool ltp);
+  bool isLtp(uint16_t ch) const;
+
+  // Zdroj řídí kanály 0..count-1 (předchozí pokrytí se nahradí)
+  void setLevels(MergeSource src, const uint8_t *levels, uint16_t count);
+  // Zdroj řídí jeden kanál (přidá ho k pokrytí)
+  void setChannel(MergeSource src, uint16_t ch, uint8_t level);
+  // Zdroj přestane řídit všechny kanály
+  void release(MergeSource src);
+  bool active(MergeSource src) const { return extent_[src] != 0; }
+
+  // Sloučí zdroje do out[0..]; vrací počet kanálů k vyslání (nejvyšší pokrytý
+  // kanál + 1, 0 = žádný zdroj) – za ním se out nemění
+  uint16_t merge(uint8_t *out);
+
+  // Referenční slučování po bajtech (stejný výsledek jako merge())
+  uint16_t mergeScalar(uint8_t *out) const;
+
+ private:
+  void updateOwner(MergeSource src, uint16_t ch, uint8_t level, bool covered);
+
+  union Plane {
+    uint32_t w[MERGE_WORDS];
+    uint8_t  b[MERGE_CHANNELS];
+  };
+
+  Plane    levels_[MERGE_SOURCES];
+  Plane    cover_[MERGE_SOURCES];    // 0xFF = kanál řídí zdroj
+  Plane    ltp_;                     // 0xFF = kanál je LTP
+  uint8_t  owner_[MERGE_CHANNELS];   // zdroj s poslední změnou (LTP)
+  uint8_t  prio_[MERGE_SOURCES];
+  uint16_t extent_[MERGE_SOURCES];   // nejvyšší pokrytý kanál + 1
+  bool     anyLtp_;
+};
+
+struct DmxMergeBench {
+  uint32_t iterations;
+  uint32_t scalarUs;
+  uint32_t wordUs;
+  bool     match;     // oba kernely daly stejný výsledek
+};
+
+// Benchmark 512 kanálů × 4 zdroje (2 priority, část kanálů LTP).
+// nowUs = zdroj času (micros() v zařízení, steady_clock na PC).
+DmxMergeBench dmxMergeBench(uint32_t iterations, uint32_t (*nowUs)());
+
+// Bajtový max 4 kanálů najednou: bit 8 součtu (a | 0x100) - b říká a >= b
+static inline uint32_t mergeMaxU8x4(uint32_t a, uint32_t b) {
+  uint32_t geE = (((a & 0x00FF00FF) | 0x01000100) - (b & 0x00FF00FF)) & 0x01000100;
+  uint32_t geO = ((((a >> 8) & 0x00FF00FF) | 0x01000100) - ((b >> 8) & 0x00FF00FF)) & 0x01000100;
+  uint32_t mask = ((geE >> 8) * 0xFF) | (((geO >> 8) * 0xFF) << 8);
+  return (a & mask) | (b & ~mask);
+}
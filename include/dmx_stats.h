@@ -0,0 +1,73 @@
+#pragma once
+//
+// Statistiky zdraví DMX vstupu – počty rámců, jitter intervalu, chyby a start kódy.
+// Neobsahuje nic z Arduina ani esp_dmx, takže jde přeložit i na PC.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+// Výsledek jednoho pokusu o příjem DMX rámce
+enum DmxFrameResult : uint8_t {
+  DMX_FRAME_OK = 0,
+  DMX_FRAME_NONE,            // žádný nový rámec (neblokující čtení)
+  DMX_FRAME_UART_ERROR,      // přetečení UART FIFO / kolize dat
+  DMX_FRAME_BREAK_ERROR,     // chybný break / framing (improper slot)
+  DMX_FRAME_SHORT,           // méně slotů, než potřebujeme pro mapované kanály
+  DMX_FRAME_BAD_START_CODE   // start kód != 0x00 (RDM, text, SIP...)
+};
+
+// Minimální počet slotů (start kód + kanály 1..6), aby rámec šel použít
+#define DMX_STATS_MIN_SLOTS 7
+// Po jaké době bez platného rámce hlásíme ztrátu signálu (DMX512: 1 s)
+#define DMX_STATS_LOSS_US 1000000UL
+
+struct DmxStatsSnapshot {
+  // poslední uzavřená sekunda
+  uint16_t framesPerSec;
+  uint16_t errorsPerSec;
+  // kumulativní čítače od vstupu do režimu
+  uint32_t framesTotal;
+  uint32_t uartErrors;
+  uint32_t breakErrors;
+  uint32_t shortFrames;
+  uint32_t badStartCodes;
+  uint32_t signalLosses;
+  // rozměry rámce
+  uint16_t lastSlots;
+  uint16_t minSlots;
+  uint16_t maxSlots;
+  uint8_t  lastBadStartCode;
+  // intervaly mezi rámci (µs)
+  uint32_t intervalAvgUs;
+  uint32_t jitterUs;        // klouzavý průměr |odchylky| od průměrného intervalu
+  uint32_t intervalMaxUs;   // maximum za poslední sekundu
+  bool     signalPresent;
+};
+
+class DmxStats {
+ public:
+  DmxStats() { reset(); }
+
+  void reset();
+
+  // Zaznamená výsledek jednoho čtení. Vrací true, pokud je rámec platný
+  // a smí pokračovat dál do IR logiky.
+  bool record(DmxFrameResult result, uint32_t nowUs, size_t slots, uint8_t startCode);
+
+  // Volat pravidelně – uzavírá sekundová okna a hlídá ztrátu signálu
+  void tick(uint32_t nowUs);
+
+  const DmxStatsSnapshot& snapshot() const { return snap; }
+
+ private:
+  DmxStatsSnapshot snap;
+  uint32_t windowStartUs;
+  uint32_t lastFrameUs;
+  uint16_t windowFrames;
+  uint16_t windowErrors;
+  uint32_t windowIntervalMaxUs;
+  // klouzavé průměry ve fixed-point (×16)
+  uint32_t avgIntervalQ4;
+  uint32_t jitterQ4;
+  bool     haveLastFrame;
+};
@@ -0,0 +1,58 @@
+#pragma once
+//
+// Průchozí režim (DMX Thru): univerzum přijaté na portu 1 jde na port 2
+// a IR scény, cue, show a web do něj vkládají nebo přepisují kanály.
+//
+// Vstup je v DmxMerger jen další zdroj (MERGE_SRC_INPUT) – vkládání/přepis
+// tedy řídí priority: vstup pod scénou = scéna kanály přepisuje, stejná
+// priorita = HTP. Výstupní rámec se skládá hned po dokončení vstupního,
+// takže průchod přidá nejvýš jeden rámec zpoždění; latence (konec vstupu →
+// začátek výstupu) se měří a porovnává s intervalem vstupních rámců.
+//
+// Bez vstupu se dál vysílá (IR scény fungují i bez pultu) a posledních
+// DMX_THRU_HOLD_MS drží poslední přijatý stav, pak se vstup uvolní.
+// Čistý C++ bez Arduina – jde spustit i na PC.
+//
+#include <stdint.h>
+#include "dmx_merge.h"
+
+#define DMX_THRU_HOLD_MS 3000
+
+struct DmxThruStats {
+  uint32_t framesIn;        // platné vstupní rámce
+  uint32_t framesOut;       // vyslané rámce
+  uint32_t framesHeld;      // vyslané bez nového vstupu
+  uint32_t badStartCodes;   // vstup se start kódem != 0 se nepropouští
+  uint32_t inputLosses;     // vstup uvolněn po DMX_THRU_HOLD_MS
+  uint32_t lastLatencyUs;   // konec vstupního rámce → začátek výstupu
+  uint32_t maxLatencyUs;
+  uint32_t frameUs;         // poslední interval vstupních rámců
+  uint32_t overTarget;      // latence delší než jeden rámec
+};
+
+class DmxThru {
+ public:
+  explicit DmxThru(DmxMerger &merger) : merger_(merger) { reset(); }
+
+  // Nový začátek (vstup do režimu): uvolní vstup, vynuluje statistiky
+  void reset();
+
+  // Přijatý rámec, slots[0] = start kód; false = rámec se nepropouští
+  bool input(const uint8_t *slots, uint16_t len, uint32_t nowUs);
+  // Nic nepřišlo – hlídá ztrátu vstupu
+  void idle(uint32_t nowUs);
+
+  // Sloučený výstup do out (out[0] = start kód 0); vrací délku vč. start
+  // kódu, 0 = není co vysílat. nowUs = okamžik těsně před odesláním.
+  uint16_t output(uint8_t *out, uint32_t nowUs);
+
+  bool inputPresent() const { return present_; }
+  const DmxThruStats &stats() const { return stats_; }
+
+ private:
+  DmxMerger   &merger_;
+  DmxThruStats stats_;
+  uint32_t     lastInUs_;
+  bool         present_;
+  bool         pending_;    // vstupní rámec ještě nevyslán
+};
@@ -0,0 +1,98 @@
+#pragma once
+//
+// Trojitý buffer DMX rámců mezi signálovou úlohou (producent) a UI úlohou (čtenář).
+//
+// Producent vždy píše do volného bufferu a hotový rámec zveřejní jedinou atomickou
+// výměnou indexu. Čtenář si při acquire() vymění svůj buffer za poslední zveřejněný –
+// nikdy nevidí rozepsaný rámec, nic se nekopíruje a nikdo na nikoho nečeká.
+// Čtecí strana patří jedné úloze (UI); displej, web i další konzumenti v ní sdílí
+// tentýž rámec a podle seq poznají, jestli už ho zpracovali.
+//
+// Každý rámec nese i changedSeq – poslední rámec, který se lišil od předchozího
+// (dmx_change.h). Čtenář, který rámce přeskakuje, tak podle changedSeq pozná,
+// jestli má od minula něco nového.
+//
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+#include "dmx_change.h"
+
+// start kód + 512 kanálů (= DMX_PACKET_SIZE z esp_dmx)
+#define DMX_FRAME_SLOTS 513
+
+struct DmxFrame {
+  uint8_t  align_[3];               // kanál 1 (slots[1]) na hranici 4 B kvůli porovnání po slovech
+  uint8_t  slots[DMX_FRAME_SLOTS];  // slots[0] = start kód, slots[1..512] = kanály
+  uint16_t length;                  // počet platných slotů včetně start kódu
+  uint32_t seq;                     // pořadí zveřejnění, 0 = zatím nic
+  uint32_t timestampUs;             // micros() při zveřejnění
+  uint32_t changedSeq;              // seq posledního rámce se změnou (0 = žádný)
+};
+
+class FrameStore {
+ public:
+  FrameStore() : back(0), middle(1), front(2), nextSeq(1), lastChangedSeq(0), unchanged(0) {
+    for (int i = 0; i < 3; i++) {
+      bufs[i].length = 0;
+      bufs[i].seq = 0;
+      bufs[i].timestampUs = 0;
+      bufs[i].changedSeq = 0;
+    }
+  }
+
+  // --- producent (jedna úloha) ---
+
+  // Buffer, do kterého se smí psát; patří producentovi až do publish()
+  DmxFrame &writeBuffer() { return bufs[back]; }
+
+  // Další rámec se bere jako změněný (přepnutí režimu)
+  void resetChanges() { changes.reset(); }
+
+  void publish(uint16_t length, uint32_t timestampUs) {
+    DmxFrame &f = bufs[back];
+    bool changed = changes.update(f.slots + 1, length ? length - 1 : 0);
+    f.length = length;
+    f.timestampUs = timestampUs;
+    f.seq = nextSeq++;
+    if (changed) lastChangedSeq = f.seq;
+    else unchanged++;
+    f.changedSeq = lastChangedSeq;
+    uint32_t prev = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+    back = prev & INDEX_MASK;
+  }
+
+  // --- čtenář (jedna úloha) ---
+
+  // Poslední zveřejněný rámec; platný až do dalšího acquire() téže úlohy
+  const DmxFrame &acquire() {
+    if (middle.load(std::memory_order_relaxed) & FRESH) {
+      uint32_t prev = middle.exchange(front, std::memory_order_acq_rel);
+      front = prev & INDEX_MASK;
+    }
+    return bufs[front];
+  }
+
+  // Číslo posledního zveřejněného rámce (jen pro informaci, neblokuje)
+  uint32_t publishedCount() const { return nextSeq - 1; }
+  // Kolik zveřejněných rámců bylo stejných jako předchozí
+  uint32_t unchangedCount() const { return unchanged; }
+
+ private:
+  static const uint32_t FRESH = 0x4;
+  static const uint32_t INDEX_MASK = 0x3;
+
+  DmxFrame bufs[3];
+  uint32_t back;                  // jen producent
+  std::atomic<uint32_t> middle;   // sdílený index + příznak FRESH
+  uint32_t front;                 // jen čtenář
+  volatile uint32_t nextSeq;      // píše jen producent
+  // jen producent
+  DmxChangeDetector changes;
+  uint32_t lastChangedSeq;
+  volatile uint32_t unchanged;
+};
+
+static_assert(offsetof(DmxFrame, slots) % 4 == 3, "DmxFrame: kanál 1 musí být zarovnaný na 4 B");
+
+// Sdílené úložiště rámců (definováno v signal_task.cpp)
+extern FrameStore dmxFrames;
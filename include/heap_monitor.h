@@ -0,0 +1,38 @@
+#pragma once
+//
+// Sledování haldy za provozu: volno, největší souvislý blok a z nich
+// fragmentace (1 - největší blok / volno). Převodník běží týdny bez restartu;
+// samotné volno nestačí – alokace velkého bloku (TCP buffer, String stránky)
+// selže, i když je volných kilobajtů dost, jen rozdrobených.
+//
+// Vzorek se bere každých HEAP_SAMPLE_MS do kruhové historie (posledních 24 h),
+// zapíše se do logu a je vidět v /metrics a na /heap. Počítají se i alokace,
+// které selhaly (hook ESP-IDF).
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define HEAP_SAMPLE_MS  600000UL  // 10 min
+#define HEAP_HISTORY    144       // 24 h po HEAP_SAMPLE_MS
+
+struct HeapSample {
+  uint32_t uptimeS;
+  uint32_t freeBytes;
+  uint32_t largestBlock;
+  uint32_t minFree;       // nejmenší volno od startu
+};
+
+// Fragmentace v % (0 = volné místo je jeden blok)
+inline uint8_t heapFragPct(const HeapSample &s) {
+  return s.freeBytes ? (uint8_t)(100 - (uint64_t)s.largestBlock * 100 / s.freeBytes) : 0;
+}
+
+void heapMonitorBegin();
+// Volá UI úloha; vzorek do historie jednou za HEAP_SAMPLE_MS
+void heapMonitorTick(uint32_t nowMs);
+
+HeapSample heapSampleNow(uint32_t nowMs);
+uint32_t heapFailedAllocs();
+// Historie: i = 0 nejstarší vzorek
+size_t heapHistoryCount();
+HeapSample heapHistoryAt(size_t i);
@@ -0,0 +1,40 @@
+#pragma once
+//
+// Enkodér a tlačítko řízené přerušením.
+// Hrany na GPIO jen natáhnou esp_timer; debounce, dlouhý stisk a čtení PCNT
+// proběhnou v jeho callbacku a výsledek jde jako událost do SPSC fronty pro UI.
+// Žádné dotazování v loop(), žádné delay() v cestě signálu.
+//
+#include <stdint.h>
+#include "spsc_queue.h"
+
+// ENKODÉR – KY-040: CLK na GPIO27, DT na GPIO26, SW na GPIO25
+#define ENCODER_PIN_A 27
+#define ENCODER_PIN_B 26
+#define ENCODER_BTN_PIN 25
+
+#define INPUT_DEBOUNCE_US    20000   // tlačítko musí být 20 ms stabilní
+#define INPUT_LONG_PRESS_US  800000  // držení od 800 ms = dlouhý stisk
+#define INPUT_ENCODER_SETTLE_US 1000 // hrany enkodéru se slučují po 1 ms
+
+enum InputEventType : uint8_t {
+  INPUT_PRESS,        // krátký stisk (hlásí se při uvolnění)
+  INPUT_LONG_PRESS,   // tlačítko drženo INPUT_LONG_PRESS_US (uvolnění se už nehlásí)
+  INPUT_ROTATE        // delta = změna počítadla enkodéru (+/-)
+};
+
+struct InputEvent {
+  InputEventType type;
+  int16_t  delta;
+  uint32_t timeMs;
+};
+
+// Producent je jen úloha esp_timer, konzument jen UI úloha
+extern SpscQueue<InputEvent, 16> inputQueue;
+
+// Nastaví piny, enkodér, časovače a přerušení
+void inputBegin();
+
+// Úloha (TaskHandle_t), která dostane task notification ke každé nové události –
+// UI tak může spát a nemusí točit smyčku
+void inputSetNotifyTask(void *task);
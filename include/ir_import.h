@@ -0,0 +1,111 @@
+#pragma once
+//
+// Hromadný import IR kódů ze souborů Pronto hex a LIRC (.conf).
+//
+// Parser je proudový: soubor dostává po kouscích (feed()) tak, jak přichází
+// z TCP, a drží jen rozpracovaný token a stav řádku – paměť nezávisí na
+// velikosti souboru. Nalezené příkazy předává callbacku jako jméno + kód.
+//
+// Převodník vysílá IR jako 32bitový NEC (sendNEC), takže se převádějí jen
+// 32bitové kódy s pulzně-mezerovým kódováním (NEC, Samsung a podobné):
+//   Pronto  naučený formát "0000 FFFF n1 n2 trvání…", jeden kód na řádek,
+//           volitelně se jménem před ním ("Power: 0000 006D …"); časování
+//           se dekóduje jako NEC
+//   LIRC    "begin codes": pre_data + kód + post_data, celkem 32 bitů;
+//           "begin raw_codes": časování v µs, dekóduje se jako NEC
+// Ostatní (RC5/RC6, jiný počet bitů, Pronto 5000/900A…) se jen započítají
+// jako nepodporované. Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define IR_IMPORT_NAME  24      // délka jména příkazu včetně '\0'
+#define IR_IMPORT_TOKEN 40      // nejdelší token (delší = chybný řádek)
+
+enum IrImportFormat : uint8_t {
+  IR_IMPORT_UNKNOWN,
+  IR_IMPORT_PRONTO,
+  IR_IMPORT_LIRC
+};
+
+struct IrImportStats {
+  IrImportFormat format;
+  uint32_t bytes;
+  uint32_t lines;
+  uint16_t commands;      // nalezené příkazy
+  uint16_t converted;     // převedené na 32bitový kód
+  uint16_t unsupported;   // jiný protokol, počet bitů nebo časování
+  uint16_t errors;        // poškozené řádky (neplatné číslo, příliš dlouhý token)
+};
+
+// Dekodér NEC z časování: střídavě puls a mezera v µs
+class NecTimingDecoder {
+ public:
+  NecTimingDecoder() { reset(); }
+  void reset();
+  // false = časování neodpovídá NEC (další hodnoty se ignorují)
+  bool push(uint32_t us);
+  bool done() const { return state_ == DONE; }
+  uint32_t code() const { return code_; }
+
+ private:
+  enum State : uint8_t { HDR_MARK, HDR_SPACE, BIT_MARK, BIT_SPACE, DONE, FAILED };
+  State    state_;
+  uint8_t  bits_;
+  uint32_t code_;
+};
+
+typedef void (*IrImportSink)(const char *name, uint32_t code, void *ctx);
+
+class IrImportParser {
+ public:
+  IrImportParser(IrImportSink sink, void *ctx);
+
+  void feed(const char *data, size_t len);
+  // Konec souboru – dokončí rozpracovaný řádek a příkaz
+  void finish();
+
+  const IrImportStats &stats() const { return stats_; }
+
+ private:
+  enum LircSection : uint8_t { LIRC_NONE, LIRC_REMOTE, LIRC_CODES, LIRC_RAW };
+
+  void endToken();
+  void token(const char *tok);
+  void endLine();
+  void prontoToken(const char *tok);
+  void prontoEndLine();
+  void lircToken(const char *tok);
+  void lircRawFinish();
+  void lircCode(uint64_t value);
+  void setName(const char *prefix, const char *name);
+  void emit(uint32_t code);
+
+  IrImportSink sink_;
+  void        *ctx_;
+  IrImportStats stats_;
+
+  char     tok_[IR_IMPORT_TOKEN];
+  uint8_t  tokLen_;
+  bool     tokOverflow_;
+  bool     comment_;
+  uint16_t tokIndex_;         // pořadí tokenu na řádku
+  bool     lineBad_;          // zbytek řádku se přeskočí
+  char     name_[IR_IMPORT_NAME];
+  char     lineFirst_[IR_IMPORT_TOKEN];  // LIRC: klíčové slovo řádku
+  NecTimingDecoder nec_;
+
+  // Pronto
+  uint16_t words_;            // počet hex slov na řádku
+  uint16_t prontoType_;
+  float    periodUs_;
+  uint16_t onceWords_;        // trvání první sekvence (0 = použije se opakovací)
+
+  // LIRC
+  LircSection section_;
+  char     remote_[IR_IMPORT_NAME];
+  uint8_t  bits_, preBits_, postBits_;
+  uint64_t pre_, post_;
+  bool     encodingOk_;
+  bool     rawPending_;
+};
@@ -0,0 +1,91 @@
+#pragma once
+//
+// Relativní ovládání výstupu IR ovladačem v IR→DMX: skupiny kanálů nahoru/dolů
+// a master (stažení celého výstupu).
+//
+// Stisk posune o jeden krok. Držené tlačítko (NEC repeat asi po 108 ms) jede
+// plynulou rampou, která zrychluje z rampStart na rampMax za accelMs. Repeat
+// jen prodlužuje držení; rampa se počítá v tick() jednou za výstupní rámec,
+// takže teče rychlostí rámců, ne rychlostí repeat kódů.
+//
+// Nic se nekopíruje do scén: engine drží posun každého kanálu a master
+// a apply() je přičte ke sloučenému rámci před výstupními křivkami. Posun je
+// omezený tak, aby výsledek kanálu při stisku zůstal v 0..255 (tlačítko dolů
+// po dojetí nahoru nemusí nejdřív "odjet" přesah). Výběr scény posuny smaže,
+// master zůstává. Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define NUDGE_ACTIONS   8
+#define NUDGE_GROUPS    4
+#define NUDGE_CHANNELS  512
+#define NUDGE_HOLD_MS   160     // bez repeat déle = tlačítko puštěno (repeat + vyzvednutí po rámcích)
+
+enum NudgeKind : uint8_t {
+  NUDGE_NONE,
+  NUDGE_UP,             // skupina kanálů nahoru
+  NUDGE_DOWN,
+  NUDGE_MASTER_UP,
+  NUDGE_MASTER_DOWN,
+  NUDGE_RESET           // posuny na 0, master na plno
+};
+
+struct NudgeAction {
+  uint32_t  code;       // 0 = nepoužitá
+  NudgeKind kind;
+  uint8_t   group;      // 0..NUDGE_GROUPS-1 (jen NUDGE_UP/DOWN)
+};
+
+struct NudgeConfig {
+  NudgeAction actions[NUDGE_ACTIONS];
+  uint8_t  groups[NUDGE_GROUPS][NUDGE_CHANNELS / 8];  // bitmapy kanálů (bit ch = kanál ch + 1)
+  uint8_t  step;        // krok jednoho stisku
+  uint16_t rampStart;   // rychlost na začátku držení [hodnot/s]
+  uint16_t rampMax;     // nejvyšší rychlost [hodnot/s]
+  uint16_t accelMs;     // zrychlení z rampStart na rampMax
+};
+
+void nudgeDefaults(NudgeConfig &cfg);
+
+class NudgeEngine {
+ public:
+  NudgeEngine();
+
+  void setConfig(const NudgeConfig &cfg);
+  // Posuny na 0, master na plno, nic se nedrží (vstup do režimu)
+  void reset();
+  // Jen posuny kanálů (nový výběr scény)
+  void clearOffsets();
+
+  // IR kód z přijímače; false = kód nepatří žádné akci
+  bool input(uint32_t code, bool repeat, uint32_t nowMs);
+  // Rampa drženého tlačítka do času nowMs – jednou za výstupní rámec
+  void tick(uint32_t nowMs);
+
+  // Přičte posuny a stáhne masterem out[0..] (kanál 1 = out[0]); kanály za
+  // count se berou jako 0. Vrací počet kanálů k vyslání (count, nebo víc,
+  // pokud posun leží za ním).
+  uint16_t apply(uint8_t *out, uint16_t count);
+
+  bool active() const { return extent_ != 0 || master_ != 255; }
+  uint8_t master() const { return master_; }
+  uint16_t nudgedChannels() const;
+
+ private:
+  void adjust(const NudgeAction &a, int delta);
+
+  NudgeConfig cfg_;
+  int16_t  offset_[NUDGE_CHANNELS];
+  uint8_t  base_[NUDGE_CHANNELS];   // sloučená hodnota z posledního apply()
+  uint16_t baseCount_;
+  uint16_t extent_;                 // nejvyšší kanál s posunem + 1
+  uint8_t  master_;
+
+  int8_t   held_;                   // index držené akce, -1 = nic
+  bool     ramping_;                // přišel první repeat
+  uint32_t holdStartMs_;
+  uint32_t lastRepeatMs_;
+  uint32_t lastTickMs_;
+  uint32_t accum_;                  // zlomky hodnot × 1000
+};
@@ -0,0 +1,56 @@
+#pragma once
+//
+// Příjem IR ve vlastní úloze (jádro 1, priorita nad signálovou úlohou).
+//
+// IRrecv zachytí jen jednu zprávu a do dalšího decode() je slepý. Dřív se
+// decode() volal jen z IR→DMX / IR Learn mezi vysíláním DMX rámců, takže
+// rychlé stisky splývaly nebo se ztrácely. Teď se dekóduje každou 1 ms
+// a s vlastním "save" bufferem (IRrecv::decode() ho zkopíruje a hned znovu
+// zapne zachytávání) – příjem další zprávy běží už během dekódování.
+// Výsledky jdou jako události do SPSC fronty, konzumentem je signálová úloha.
+//
+// Ladění pro používané ovladače (NEC a podobné 32bitové protokoly):
+//   buffer 256 hran  – NEC potřebuje 68, rezerva na Samsung/Sony/RC5/RC6
+//   timeout 15 ms    – konec zprávy; NEC repeat chodí po ~40 ms, nesplynou
+//   min. 12 hran     – kratší záchyt je šum, ne neznámý protokol
+//
+#include <stdint.h>
+#include "spsc_queue.h"
+
+#define IR_RECV_PIN          16
+#define IR_RECV_BUFFER       256
+#define IR_RECV_TIMEOUT_MS   15
+#define IR_RECV_MIN_UNKNOWN  12
+#define IR_EVENT_QUEUE       32
+
+struct IrEvent {
+  uint32_t timeUs;     // micros() při dekódování
+  uint32_t code;       // u repeat poslední platný kód téhož protokolu
+  int16_t  protocol;   // decode_type_t (UNKNOWN = -1)
+  uint8_t  bits;
+  bool     repeat;     // opakování drženého tlačítka (NEC repeat apod.)
+};
+
+struct IrRxStats {
+  uint32_t decoded;        // platné kódy (bez repeat)
+  uint32_t repeats;
+  uint32_t unknown;        // záchyt, který žádný dekodér nepřijal
+  uint32_t overflows;      // zpráva delší než IR_RECV_BUFFER
+  uint32_t lastLatencyUs;  // dekódování → vyzvednutí konzumentem
+  uint32_t maxLatencyUs;
+};
+
+extern SpscQueue<IrEvent, IR_EVENT_QUEUE> irEvents;
+
+// Zapne přijímač a spustí úlohu "ir" (volat ze setup() na jádře 1)
+void irReceiverBegin();
+// Jedno dekódování (tělo úlohy "ir"): false = nic nezachyceno. Soak harness
+// (tools/soak) ho volá přímo místo úlohy.
+bool irReceiverPoll();
+
+// Konzument: další událost (false = fronta prázdná)
+bool irReceiverPop(IrEvent &ev);
+// Konzument: zahodí čekající události (vstup do režimu, režim bez IR příjmu)
+void irReceiverFlush();
+
+const IrRxStats &irRxStats();
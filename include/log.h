@@ -0,0 +1,78 @@
+#pragma once
+//
+// Asynchronní log s úrovněmi. LOG_E/W/I/D naformátují řádek do bezzámkového
+// kruhového bufferu (více producentů, jeden konzument) a na UART ho pošle
+// až úloha "log" s nejnižší prioritou – volající nikdy nečeká na UART.
+// Plný buffer zprávu zahodí a započítá (logStats().dropped), neblokuje.
+//
+// Úrovně:
+//   - při překladu LOG_LEVEL (build flag -D LOG_LEVEL=...): vyšší úrovně se
+//     vůbec nepřeloží, ani jejich argumenty,
+//   - za běhu logSetLevel(): vypnutá úroveň stojí jen jedno porovnání,
+//     formátuje se až po něm.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_SLOTS         64      // mocnina 2
+#define LOG_LINE          96      // včetně časové značky a '\n'
+#define LOG_DRAIN_MS      10
+#define LOG_TASK_PRIORITY 0       // jako idle – UART jen když není nic jiného
+#define LOG_TASK_CORE     0       // s UI, signálové jádro 1 se nesdílí
+
+struct LogStats {
+  uint32_t written;     // zprávy ve frontě / odeslané
+  uint32_t dropped;     // plný buffer
+  uint32_t truncated;   // delší než LOG_LINE
+};
+
+// Úroveň za běhu (výchozí LOG_LEVEL); vyšší než LOG_LEVEL nemá smysl
+extern volatile uint8_t logRuntimeLevel;
+
+static inline bool logEnabled(uint8_t level) { return level <= logRuntimeLevel; }
+static inline void logSetLevel(uint8_t level) { logRuntimeLevel = level; }
+
+// Spustí úlohu, která buffer vypisuje na Serial (po Serial.begin()). Zprávy
+// zapsané dřív v bufferu počkají.
+void logBegin();
+
+// Zapíše řádek (bez '\n' – doplní se). Volat přes makra LOG_x.
+void logWrite(uint8_t level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Počká, až úloha buffer vypíše (před restartem), nejdéle timeoutMs
+void logFlush(uint32_t timeoutMs);
+
+const LogStats &logStats();
+
+#define LOG_AT(level, ...) do { if (logEnabled(level)) logWrite(level, __VA_ARGS__); } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_E(...) do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_W(...) do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_I(...) do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_D(...) do {} while (0)
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+//
+// Výstupní křivky kanálů: sloučený rámec projde před vysláním tabulkou
+// 256 hodnot (LUT) – gamma, kvadratická nebo vlastní křivka, rozsah min/max
+// a inverze podle stmívače/svítidla na kanálu.
+//
+// Vlastní tabulka pro každý z 512 kanálů by zabrala 128 KB RAM, proto kanál
+// ukazuje na jeden z CURVE_PROFILES profilů (0 = beze změny). Tabulky se
+// počítají jen při změně parametrů profilu (float/pow, UI úloha); za rámec
+// zbývá jeden průchod out[i] = lut[profil[i]][out[i]].
+//
+// Signálová úloha čte aktivní CurveTable, UI plní druhou a pak je prohodí
+// příkazem CMD_CURVES_SWAP (signal_task.h). Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define CURVE_PROFILES  8
+#define CURVE_CHANNELS  512
+#define CURVE_POINTS    5       // vlastní křivka: vstup 0, 64, 128, 192, 255
+
+enum CurveType : uint8_t {
+  CURVE_LINEAR,
+  CURVE_GAMMA,          // out = in ^ gamma
+  CURVE_SQUARE,         // out = in² (typické pro žárovky na stmívači)
+  CURVE_CUSTOM          // lomená čára přes points[]
+};
+
+struct CurveProfile {
+  CurveType type;
+  uint8_t   gammaX10;   // CURVE_GAMMA: exponent × 10 (22 = 2,2)
+  uint8_t   min;        // výstup pro nulový vstup
+  uint8_t   max;        // výstup pro plný vstup
+  bool      invert;     // křivka se otočí před škálováním na min..max
+  uint8_t   points[CURVE_POINTS];
+};
+
+struct CurveConfig {
+  CurveProfile profiles[CURVE_PROFILES];     // [0] se nepoužívá (beze změny)
+  uint8_t      channelProfile[CURVE_CHANNELS];  // 0 = kanál bez křivky
+};
+
+// Všechny profily lineární 0..255, žádný kanál přiřazený
+void curveDefaults(CurveConfig &cfg);
+void curveProfileDefaults(CurveProfile &p);
+
+// Hodnota křivky pro jeden vstup (přímý výpočet – pro tabulky a benchmark)
+uint8_t curveValue(const CurveProfile &p, uint8_t in);
+
+class CurveTable {
+ public:
+  CurveTable();
+
+  // Převezme konfiguraci: přepočítá jen tabulky profilů, které se od
+  // minulého build() změnily, a přiřazení kanálů
+  void build(const CurveConfig &cfg);
+
+  // Přemapuje out[0..count-1] (kanál 1 = out[0]); kanály za posledním
+  // přiřazeným se nedotknou, bez přiřazení se nedělá nic
+  void apply(uint8_t *out, uint16_t count) const;
+
+  bool active() const { return extent_ != 0; }
+  const uint8_t *lut(uint8_t profile) const { return lut_[profile]; }
+
+ private:
+  uint8_t      lut_[CURVE_PROFILES][256];
+  uint8_t      map_[CURVE_CHANNELS];
+  CurveProfile built_[CURVE_PROFILES];
+  bool         valid_[CURVE_PROFILES];
+  uint16_t     extent_;    // nejvyšší přiřazený kanál + 1
+};
+
+struct CurveBench {
+  uint32_t iterations;
+  uint32_t mathUs;      // přímý výpočet curveValue() pro každý kanál
+  uint32_t lutUs;       // CurveTable::apply()
+  bool     match;       // oba postupy daly stejný výsledek
+};
+
+// Benchmark 512 kanálů rozdělených mezi 7 profilů všech typů.
+// nowUs = zdroj času (micros() v zařízení, steady_clock na PC).
+CurveBench curveBench(uint32_t iterations, uint32_t (*nowUs)());
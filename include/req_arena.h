@@ -0,0 +1,101 @@
+#pragma once
+//
+// Aréna pro jeden HTTP požadavek: pevný blok RAM (statický, přidělený jednou),
+// ze kterého se bere řádek požadavku, řádky hlaviček a text odpovědi. Na konci
+// požadavku se celá vrátí jedním reset() – žádné malloc/free.
+//
+// Dřív každý požadavek stavěl stránku do Stringu, který rostl po kouscích
+// (realloc), a /scenes s 384 políčky přes 30 KB. Takové bloky mezi dlouho
+// žijícími alokacemi WiFi/lwIP po dnech provozu rozdrobily haldu.
+//
+// Text odpovědi (ArenaText) dostane zbytek arény jako okno; když se zaplní,
+// pošle hotovou část do sinku (klientovi) a pokračuje od začátku okna.
+// Odpovědi bez Content-Length tak mohou být delší než aréna. Statistiky počítají
+// z okna jen skutečně zapsaný text, ne celou rezervaci. Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define REQ_ARENA_SIZE    16384   // řádek požadavku (/scenes ~7 KB) + okno odpovědi
+#define REQ_ARENA_RESERVE 512     // zůstane volné i při psaní odpovědi (řádky hlaviček)
+
+struct ReqArenaStats {
+  uint32_t requests;    // počet reset()
+  uint32_t lastUsed;    // B skutečně použité v posledním požadavku (okno odpovědi jen do nejdelšího textu)
+  uint32_t highWater;   // nejvíc použitých B za jeden požadavek
+  uint32_t lastReserved;  // B přidělené v posledním požadavku včetně celého okna odpovědi
+  uint32_t failed;      // alokace, které se nevešly
+  uint32_t flushes;     // průběžná odeslání plného okna odpovědi
+};
+
+class ReqArena {
+ public:
+  ReqArena(uint8_t *buf, size_t size);
+
+  // Blok n B zarovnaný na 4 B; NULL = nevejde se (započítá se)
+  void *alloc(size_t n);
+  // Čtení neznámé délky: do scratch() se zapisuje, commit() pak přidělí jen
+  // použitou část
+  char *scratch(size_t &avail);
+  void commit(size_t n);
+
+  size_t used() const { return top_; }
+  size_t available() const { return size_ - top_; }
+
+  // Konec požadavku – vše přidělené je zase volné
+  void reset();
+
+  const ReqArenaStats &stats() const { return stats_; }
+
+ private:
+  friend class ArenaText;
+  uint8_t *buf_;
+  size_t   size_;
+  size_t   top_;
+  size_t   peak_;       // nejvíc použitých B od reset() = top_ bez nevyužité části oken
+  size_t   reservedPeak_;  // nejvyšší top_ od reset() (okna ArenaText celá)
+  size_t   idle_;       // přidělené, ale nepopsané bajty oken ArenaText
+
+  void notePeak();
+  ReqArenaStats stats_;
+};
+
+// Vrátí arénu při opuštění bloku – obsluha požadavku má mnoho návratů
+class ReqArenaScope {
+ public:
+  explicit ReqArenaScope(ReqArena &arena) : arena_(arena) {}
+  ~ReqArenaScope() { arena_.reset(); }
+
+ private:
+  ReqArena &arena_;
+};
+
+typedef void (*ArenaSink)(void *ctx, const char *data, size_t len);
+
+// Text odpovědi ve zbytku arény (bez REQ_ARENA_RESERVE)
+class ArenaText {
+ public:
+  ArenaText(ReqArena &arena, ArenaSink sink, void *ctx);
+
+  ArenaText &append(const char *s, size_t n);
+  ArenaText &operator+=(const char *s);
+
+  // Ještě neodeslaná část
+  const char *c_str() const { return buf_; }
+  size_t length() const { return len_; }
+
+  // Pošle neodeslanou část do sinku – na konci odpovědi
+  void flush();
+  // Bez sinku se nevešlo všechno
+  bool truncated() const { return truncated_; }
+
+ private:
+  ReqArena &arena_;
+  ArenaSink sink_;
+  void     *ctx_;
+  char     *buf_;
+  size_t    cap_;
+  size_t    len_;
+  size_t    maxLen_;    // nejdelší text v okně (statistika arény)
+  bool      truncated_;
+};
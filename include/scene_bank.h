@@ -0,0 +1,55 @@
+#pragma once
+//
+// Banka scén ve vlastním oddílu flash ("scenes", partitions.csv), mapovaná
+// do adresního prostoru přes esp_partition_mmap(). Signálová úloha čte scény
+// přímo z mapované flash – žádná kopie v RAM, paměť nezávisí na počtu scén.
+//
+// Oddíl má dva sloty A/B po 64 KB (jedna MMU stránka):
+//   hlavička (16 B): "SCNB" | u32 generace | u16 počet scén | u16 kanálů na scénu | u32 CRC-32 dat
+//   data:            počet × kanálů bajtů, scéna za scénou
+// Zápis jde vždy do neaktivního slotu: smazání → data → hlavička jako poslední.
+// Platný slot s vyšší generací je aktivní, takže výpadek napájení uprostřed
+// zápisu nechá starý slot beze změny; přepnutí je výměna jednoho ukazatele.
+//
+// Bez oddílu (starší tabulka oddílů) sceneBankBegin() vrátí false a scény
+// zůstávají v RAM jako dřív.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define SCENE_BANK_LABEL      "scenes"
+#define SCENE_BANK_SUBTYPE    0x40
+#define SCENE_BANK_SLOT_SIZE  0x10000
+#define SCENE_BANK_HEADER     16
+#define SCENE_BANK_MAX_SCENES 255
+// Jak dlouho zápis čeká, než signálová úloha opustí slot, který se má přepsat
+#define SCENE_BANK_READER_WAIT_MS 500
+
+struct SceneBankInfo {
+  bool     mapped;        // oddíl nalezen a namapován
+  int8_t   activeSlot;    // 0 / 1, -1 = žádný platný slot
+  uint32_t generation;
+  uint16_t count;
+  uint16_t channels;
+  uint32_t writes;
+  uint32_t writeErrors;
+  uint32_t lastWriteUs;
+};
+
+// Najde a namapuje oddíl, vybere aktivní slot (volat jednou v setup())
+bool sceneBankBegin();
+bool sceneBankMapped();
+
+// Data aktivního slotu (scéna i = data + i * channels), NULL = banka prázdná.
+// Čtení pro UI/web – nepřihlašuje čtenáře.
+const uint8_t *sceneBankData(uint16_t &count, uint16_t &channels);
+
+// Totéž pro signálovou úlohu: zároveň zaznamená, který slot čte, aby ho
+// další zápis nesmazal dřív, než si signálová úloha převezme nový.
+const uint8_t *sceneBankAcquire(uint16_t &count, uint16_t &channels);
+
+// Zapíše scény do neaktivního slotu a přepne na něj (blokuje – smazání
+// sektoru trvá desítky ms; volat z UI úlohy). false = chyba, aktivní slot beze změny.
+bool sceneBankWrite(const uint8_t *data, uint16_t count, uint16_t channels);
+
+const SceneBankInfo &sceneBankInfo();
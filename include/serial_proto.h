@@ -0,0 +1,122 @@
+#pragma once
+//
+// Binární řídicí protokol na UART0 – konfigurace a telemetrie bez WiFi.
+//
+// Rámec na drátě:  0x00 | COBS( typ | seq | délka u16 | payload | CRC-32 ) | 0x00
+//   - COBS odstraní z dat nuly, takže 0x00 je jednoznačný oddělovač a přijímač
+//     se po chybě chytí na dalším rámci,
+//   - CRC-32 (crc32.h, jako zlib) přes typ až payload, little-endian,
+//   - všechna čísla v payloadu little-endian.
+// Stejným UARTem jdou i textové řádky logu (log.h). Ty nulu nikdy neobsahují,
+// a tak je klient od rámců oddělí: úsek mezi nulami, který neprojde dekódováním
+// a CRC, je text. Referenční klient: tools/serial_ctl.py.
+//
+// Odpověď má typ požadavku | SP_REPLY a stejné seq; chyba je SP_NAK.
+// Čistý C++ bez Arduina.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define SERIAL_PROTO_VERSION     1
+#define SERIAL_PROTO_BAUD        921600
+#define SERIAL_PROTO_MAX_PAYLOAD 2048     // celý blob konfigurace (CONFIG_MAX_SIZE)
+#define SERIAL_PROTO_HEADER      4
+#define SERIAL_PROTO_RAW_MAX     (SERIAL_PROTO_HEADER + SERIAL_PROTO_MAX_PAYLOAD + 4)
+// COBS přidá bajt na každých 254 B, k tomu dva oddělovače
+#define SERIAL_PROTO_ENCODED_MAX (SERIAL_PROTO_RAW_MAX + SERIAL_PROTO_RAW_MAX / 254 + 1 + 2)
+
+enum SerialMsg : uint8_t {
+  SP_PING       = 0x01,   // → u8 verze, u16 max. payload, u32 uptime ms
+  SP_GET_CONFIG = 0x02,   // → blob konfigurace (config_blob.h)
+  SP_SET_CONFIG = 0x03,   // blob; po potvrzení převodník restartuje
+  SP_GET_SCENES = 0x04,   // → u8 scén, u8 kanálů, scény × kanály B
+  SP_SET_SCENES = 0x05,   // totéž (6 × 64)
+  SP_GET_IR     = 0x06,   // → 6 × u32 kódy kanálů 1..6, u8 n, n × (24 B jméno, u32 kód)
+  SP_SET_IR     = 0x07,   // totéž; knihovna se celá nahradí
+  SP_INJECT     = 0x08,   // úrovně kanálů 1..n (0 B = uvolnit) – zdroj "web" slučování
+  SP_GET_FRAME  = 0x09,   // → u32 seq, sloty rámce včetně start kódu (jako /dmx)
+  SP_STREAM     = 0x0A,   // u16 perioda ms (0 = stop) – posílání SP_METRICS
+  SP_REPLY      = 0x80,   // příznak odpovědi
+  SP_METRICS    = 0xC0,   // nevyžádaný snímek metrik (SerialMetrics), seq = pořadí
+  SP_NAK        = 0xFF    // u8 SerialNak, u8 typ požadavku
+};
+
+enum SerialNak : uint8_t {
+  SP_NAK_UNKNOWN = 1,     // neznámý typ
+  SP_NAK_LENGTH,          // payload neodpovídá typu
+  SP_NAK_BUSY,            // signálová úloha ještě nepřevzala předchozí rámec
+  SP_NAK_FAILED           // neplatná data nebo chyba zápisu
+};
+
+struct SerialProtoStats {
+  uint32_t frames;        // platné přijaté rámce
+  uint32_t crcErrors;
+  uint32_t malformed;     // chybné COBS, krátký rámec, nesedí délka
+  uint32_t overflows;     // rámec delší než SERIAL_PROTO_ENCODED_MAX
+};
+
+// Příjem po bajtech; rámec se dekóduje na místě ve vlastním bufferu
+class SerialFrameDecoder {
+ public:
+  SerialFrameDecoder() { reset(); }
+  void reset();
+
+  // true = push() právě dokončil platný rámec; payload() platí do dalšího push()
+  bool push(uint8_t byte);
+
+  uint8_t type() const { return type_; }
+  uint8_t seq() const { return seq_; }
+  const uint8_t *payload() const { return buf_ + SERIAL_PROTO_HEADER; }
+  uint16_t length() const { return length_; }
+
+  const SerialProtoStats &stats() const { return stats_; }
+
+ private:
+  bool finishFrame();
+
+  uint8_t  buf_[SERIAL_PROTO_ENCODED_MAX];
+  uint16_t fill_;
+  bool     overflow_;
+  uint8_t  type_;
+  uint8_t  seq_;
+  uint16_t length_;
+  SerialProtoStats stats_;
+};
+
+// Zakóduje rámec do out včetně obou oddělovačů. Vrací počet bajtů, 0 = nevejde se.
+size_t serialFrameEncode(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len,
+                         uint8_t *out, size_t outSize);
+
+// Snímek metrik pro SP_METRICS – pevné pořadí polí, na drátě SERIAL_METRICS_SIZE B
+struct SerialMetrics {
+  uint32_t uptimeMs;
+  uint8_t  mode;            // režim převodníku (AppMode)
+  uint8_t  signalPresent;
+  uint16_t framesPerSec;
+  uint16_t errorsPerSec;
+  uint16_t lastSlots;
+  uint32_t framesTotal;
+  uint32_t framesPublished;
+  uint32_t framesUnchanged;
+  uint32_t uartErrors;
+  uint32_t signalLosses;
+  uint32_t intervalMaxUs;
+  uint32_t jitterUs;
+  uint32_t mergeLastUs;
+  uint32_t mergeMaxUs;
+  uint16_t mergeChannels;
+  uint32_t curveLastUs;
+  uint32_t irDecoded;
+  uint32_t irRepeats;
+  uint32_t logDropped;
+  uint32_t freeHeap;
+};
+
+#define SERIAL_METRICS_SIZE 70
+
+size_t serialMetricsEncode(const SerialMetrics &m, uint8_t out[SERIAL_METRICS_SIZE]);
+
+static inline void spPut16(uint8_t *p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+static inline void spPut32(uint8_t *p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+static inline uint16_t spGet16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static inline uint32_t spGet32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
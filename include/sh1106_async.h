@@ -0,0 +1,73 @@
+#pragma once
+//
+// SH1106 s asynchronním přenosem framebufferu.
+//
+// Knihovní Adafruit_SH1106::display() posílá 8 stránek po 16 bajtech blokujícími
+// Wire transakcemi na 100 kHz (~90 transakcí na snímek). Tady display() jen
+// zkopíruje framebuffer do "pending" a hned se vrátí; přenos běží v samostatné
+// úloze na 400 kHz, kde ovladač I2C plní FIFO z přerušení a CPU je volné.
+// Posílají se jen stránky, které se od posledního přenosu změnily.
+// Nový snímek během přenosu přepíše pending – mezisnímky se slučují, nefrontují.
+//
+// Framebuffer knihovny je statický v jejím .cpp, proto má třída vlastní buffer
+// a přepisuje kreslení pixelů; inicializaci a příkazy dědí beze změny.
+//
+#include <Adafruit_SH1106.h>
+
+#define SH1106_ASYNC_I2C_HZ   400000
+#define SH1106_ASYNC_PAGES    (SH1106_LCDHEIGHT / 8)
+#define SH1106_ASYNC_COL_OFFSET 2     // SH1106 má 132 sloupců, panel začíná na 2
+
+struct SH1106FlushStats {
+  uint32_t requested;     // volání display()
+  uint32_t flushed;       // dokončené přenosy
+  uint32_t coalesced;     // snímky přepsané dřív, než se stihly poslat
+  uint32_t pagesSent;
+  uint32_t pagesSkipped;  // stránky beze změny
+  uint32_t lastFlushUs;
+  uint32_t maxFlushUs;
+};
+
+class SH1106Async : public Adafruit_SH1106 {
+ public:
+  explicit SH1106Async(int8_t rst) : Adafruit_SH1106(rst) {}
+
+  // Inicializace panelu (blokující, jen při startu) + spuštění přenosové úlohy
+  void begin(uint8_t switchvcc = SH1106_SWITCHCAPVCC, uint8_t i2caddr = SH1106_I2C_ADDRESS,
+             bool reset = true);
+
+  void clearDisplay();
+  // Zahájí přenos a hned se vrátí
+  void display();
+
+  // Přenos právě běží nebo čeká
+  bool busy() const;
+  // Počká na dokončení (např. před vypnutím); false = timeout
+  bool waitIdle(uint32_t timeoutMs);
+  // Volá se z přenosové úlohy po každém dokončeném snímku
+  void onFlushDone(void (*cb)()) { doneCb = cb; }
+
+  const SH1106FlushStats &stats() const { return flushStats; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+
+ private:
+  static void flushTask(void *arg);
+  void flushOnce();
+  void sendPage(uint8_t page, const uint8_t *data);
+
+  uint8_t fb[SH1106_ASYNC_PAGES * SH1106_LCDWIDTH];       // kreslí UI
+  uint8_t pending[SH1106_ASYNC_PAGES * SH1106_LCDWIDTH];  // poslední zveřejněný snímek
+  uint8_t tx[SH1106_ASYNC_PAGES * SH1106_LCDWIDTH];       // právě se posílá
+  uint8_t shown[SH1106_ASYNC_PAGES * SH1106_LCDWIDTH];    // co je na panelu
+
+  uint8_t addr = SH1106_I2C_ADDRESS;
+  void *task = nullptr;
+  volatile bool hasPending = false;
+  volatile bool transferring = false;
+  bool shownValid = false;
+  void (*doneCb)() = nullptr;
+  SH1106FlushStats flushStats = {};
+};
@@ -0,0 +1,173 @@
+#pragma once
+//
+// Formát záznamu DMX show (*.dmxs) – časové razítko + jen změněné úseky kanálů.
+// Čistý C++ bez Arduina: stejný kód běží v zařízení i v nástrojích na PC
+// (viz také tools/show_dump.py).
+//
+//   hlavička (16 B):  "DMXS" | u8 verze | u8 flags | u16 LE max. slotů | 8 B rezerva
+//   záznam:           u8 typ | varint dt_ms (od předchozího záznamu) | data
+//     'K' klíčový:    varint n | n bajtů (sloty 0..n-1 včetně start kódu)
+//     'D' rozdílový:  varint počet úseků | {varint mezera, varint délka, bajty}...
+//                     mezera = počet nezměněných slotů od konce předchozího úseku
+//     'E' konec:      bez dat
+//   varint = LEB128 (7 bitů na bajt, nejnižší první)
+//
+// Stejné rámce se nezapisují vůbec – čas se přičte k dalšímu záznamu.
+// Klíčový rámec se vkládá na začátku a pak každých SHOW_KEYFRAME_MS.
+//
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define SHOW_MAGIC          "DMXS"
+#define SHOW_VERSION        1
+#define SHOW_HEADER_SIZE    16
+#define SHOW_MAX_SLOTS      513
+#define SHOW_KEYFRAME_MS    10000
+#define SHOW_MAX_RECORD     (1 + 5 + 3 + SHOW_MAX_SLOTS)   // klíčový rámec je nejdelší záznam
+
+#define SHOW_REC_KEY   'K'
+#define SHOW_REC_DELTA 'D'
+#define SHOW_REC_END   'E'
+
+// Úseky oddělené mezerou kratší než tohle se slučují (hlavička úseku stojí >= 2 B)
+#define SHOW_MERGE_GAP 3
+
+void showWriteHeader(uint8_t *out);
+bool showCheckHeader(const uint8_t *in);
+
+class ShowEncoder {
+ public:
+  ShowEncoder() { reset(); }
+
+  void reset();
+
+  // Zakóduje rámec do out (min. SHOW_MAX_RECORD bajtů). Vrací počet bajtů,
+  // 0 = rámec je stejný jako předchozí a nic se nezapisuje.
+  size_t encode(const uint8_t *slots, uint16_t len, uint32_t nowMs, uint8_t *out);
+
+  // Záznam 'E' na konec souboru
+  size_t encodeEnd(uint32_t nowMs, uint8_t *out);
+
+  // Další rámec zapiš jako klíčový
+  void forceKeyframe() { needKey = true; }
+
+  // Poslední záznam z encode() se nezapsal (plný buffer): jeho dt se přičte
+  // k dalšímu záznamu a ten bude klíčový, aby dekodér nenavazoval na chybějící rámec
+  void discardLast() { lastMs = undoMs; needKey = true; }
+
+ private:
+  size_t encodeKey(const uint8_t *slots, uint16_t len, uint32_t dt, uint8_t *out);
+
+  uint8_t  prev[SHOW_MAX_SLOTS];
+  uint16_t prevLen;
+  uint32_t lastMs;
+  uint32_t undoMs;
+  uint32_t lastKeyMs;
+  bool     needKey;
+  bool     started;
+};
+
+static inline size_t showPutVarint(uint8_t *out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// Výsledek dekódování jednoho záznamu
+struct ShowFrame {
+  uint8_t  slots[SHOW_MAX_SLOTS];
+  uint16_t len;
+  uint32_t timeMs;     // od začátku záznamu
+};
+
+//
+// Proudový dekodér. Src musí mít int read() (-1 = konec dat), takže stačí
+// File, Stream nebo jednoduchý buffer na PC. Stav rámce si drží sám.
+//
+template <typename Src>
+class ShowDecoder {
+ public:
+  explicit ShowDecoder(Src &src) : src(src), err(false) {
+    memset(&frame, 0, sizeof(frame));
+  }
+
+  // Načte hlavičku a vynuluje stav; false = to není .dmxs
+  bool begin() {
+    memset(&frame, 0, sizeof(frame));
+    err = false;
+    uint8_t hdr[SHOW_HEADER_SIZE];
+    for (int i = 0; i < SHOW_HEADER_SIZE; i++) {
+      int c = src.read();
+      if (c < 0) return false;
+      hdr[i] = (uint8_t)c;
+    }
+    return showCheckHeader(hdr);
+  }
+
+  // Další rámec do frame(); false = konec záznamu nebo chyba (viz error())
+  bool next() {
+    int type = src.read();
+    if (type < 0 || type == SHOW_REC_END) return false;
+    uint32_t dt;
+    if (!readVarint(dt)) return fail();
+    frame.timeMs += dt;
+
+    if (type == SHOW_REC_KEY) {
+      uint32_t n;
+      if (!readVarint(n) || n > SHOW_MAX_SLOTS) return fail();
+      if (!readBytes(frame.slots, n)) return fail();
+      frame.len = (uint16_t)n;
+      return true;
+    }
+    if (type == SHOW_REC_DELTA) {
+      uint32_t runs, pos = 0;
+      if (!readVarint(runs)) return fail();
+      while (runs--) {
+        uint32_t gap, len;
+        if (!readVarint(gap) || !readVarint(len)) return fail();
+        pos += gap;
+        if (pos + len > SHOW_MAX_SLOTS) return fail();
+        if (!readBytes(&frame.slots[pos], len)) return fail();
+        pos += len;
+        if (pos > frame.len) frame.len = (uint16_t)pos;
+      }
+      return true;
+    }
+    return fail();
+  }
+
+  const ShowFrame &current() const { return frame; }
+  bool error() const { return err; }
+
+ private:
+  bool fail() { err = true; return false; }
+
+  bool readVarint(uint32_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      int c = src.read();
+      if (c < 0) return false;
+      v |= (uint32_t)(c & 0x7F) << shift;
+      if (!(c & 0x80)) return true;
+    }
+    return false;
+  }
+
+  bool readBytes(uint8_t *dst, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+      int c = src.read();
+      if (c < 0) return false;
+      dst[i] = (uint8_t)c;
+    }
+    return true;
+  }
+
+  Src &src;
+  ShowFrame frame;
+  bool err;
+};
@@ -0,0 +1,72 @@
+#pragma once
+//
+// Záznam a přehrávání DMX show na LittleFS (formát viz show_format.h).
+//
+// Záznam: signálová úloha zakóduje každý přijatý rámec (DMX→IR) do bajtového
+// kruhového bufferu showRecRing; úloha "show" na jádře 0 ho vybírá a zapisuje
+// do souboru sekvenčně po SHOW_WRITE_CHUNK bajtech. Zápis do flash tak nikdy
+// neblokuje příjem – při zahlcení se rámec zahodí, započítá a další se zapíše
+// jako klíčový.
+//
+// Přehrávání: úloha "show" dekóduje soubor do fronty showPlayQueue, signálová
+// úloha v režimu IR→DMX vysílá rámce v původních časech (s rozlišením jednoho
+// vysílaného DMX rámce). Po dobu přehrávání má show přednost před scénou.
+//
+#include <stdint.h>
+#include "spsc_queue.h"
+#include "show_format.h"
+
+#define SHOW_FILE_PATH     "/show.dmxs"
+#define SHOW_RING_SIZE     16384   // ~0,7 s i při samých klíčových rámcích
+#define SHOW_WRITE_CHUNK   4096    // = blok LittleFS
+#define SHOW_PLAY_QUEUE    8
+#define SHOW_STOP_SETTLE_MS 20     // doběhnutí rozpracovaného rámce v signálové úloze
+
+enum ShowState : uint8_t {
+  SHOW_IDLE,
+  SHOW_RECORDING,
+  SHOW_PLAYING
+};
+
+struct ShowPlayFrame {
+  uint32_t timeMs;      // od začátku záznamu
+  uint16_t len;
+  uint32_t session;     // číslo přehrávání – rámce z dřívějšího se zahodí
+  uint8_t  slots[SHOW_MAX_SLOTS];
+};
+
+struct ShowStats {
+  // zapisuje úloha "show"
+  uint32_t bytesWritten;
+  uint32_t flashWrites;
+  uint32_t lastWriteUs;
+  uint32_t maxWriteUs;
+  uint32_t framesQueued;     // přehrávání: rámce předané signálové úloze
+  uint32_t writeErrors;
+  uint32_t formatErrors;     // poškozený soubor při přehrávání
+  // zapisuje signálová úloha
+  uint32_t framesRecorded;
+  uint32_t framesUnchanged;  // stejné jako předchozí – nic se nezapsalo
+  uint32_t framesPlayed;
+};
+
+extern SpscByteRing<SHOW_RING_SIZE>             showRecRing;    // signál → úloha "show"
+extern SpscQueue<ShowPlayFrame, SHOW_PLAY_QUEUE> showPlayQueue; // úloha "show" → signál
+
+// Připojí LittleFS a spustí úlohu "show" (ze setup())
+void showBegin();
+
+// UI strana – jen předají požadavek úloze "show"
+void showRecordStart();
+void showPlayStart();
+void showStop();
+
+ShowState showState();
+const ShowStats &showStats();
+uint32_t showFileSize();
+
+// Signálová strana záznamu: volat pro každý platný přijatý rámec
+void showCaptureFrame(const uint8_t *slots, uint16_t len, uint32_t nowMs);
+
+// Signálová strana přehrávání: aktuální rámec show, nebo NULL (show neběží)
+const uint8_t *showPlaybackFrame(uint32_t nowMs, uint16_t &len);
@@ -0,0 +1,155 @@
+#pragma once
+//
+// Real-time signálová cesta (DMX a IR I/O) – běží ve vlastní úloze na jádře 1.
+// S UI/WiFi úlohou na jádře 0 komunikuje výhradně přes dvě SPSC fronty:
+//   signalCmdQueue  UI → signál (režim, IR kódy, hodnoty scén, cue list a chase)
+//   signalEvtQueue  signál → UI (odeslané IR, statistiky, scéna, cue, naučený kód)
+// Samotné hodnoty kanálů čte UI z trojitého bufferu dmxFrames (frame_store.h).
+//
+#include <stdint.h>
+#include "spsc_queue.h"
+#include "dmx_stats.h"
+#include "cue_engine.h"
+#include "dmx_merge.h"
+#include "dmx_thru.h"
+#include "output_curves.h"
+#include "ir_nudge.h"
+
+// Pin pro ovládání MAX485 (DE/RE)
+#define MAX485_CTRL_PIN 32
+
+// Volitelný druhý DMX port (UART2 s vlastním vysílacím MAX485) pro průchozí
+// režim – zapíná se build flagem -D DMX_THRU_ENABLED=1 (platformio.ini)
+#ifndef DMX_THRU_ENABLED
+#define DMX_THRU_ENABLED 0
+#endif
+// Obsazené piny: DMX1 TX 19 / RX 18 / DE 32 (a dummy 13), IR přijímač 16,
+// IR LED 17, enkodér 27/26/25 (input_events.h), OLED I2C 21/22, terminál
+// RX 34 / TX 1. Druhý port proto na volných GPIO4 (TX) a GPIO23 (DE); GPIO5
+// je strapping pin a ROM na něm při startu pouští PWM – budič by krátce
+// vysílal na linku. Překryv hlídá static_assert v signal_task.cpp.
+#define DMX_THRU_TX_PIN 4
+#define DMX_THRU_EN_PIN 23    // DE druhého MAX485 (RTS, řídí esp_dmx)
+
+// Jádra a priority úloh
+#define SIGNAL_TASK_CORE     1
+#define SIGNAL_TASK_PRIORITY 10
+#define UI_TASK_CORE         0
+#define UI_TASK_PRIORITY     1
+
+#define SIGNAL_SCENES   6
+#define SIGNAL_SCENE_CH 64
+
+enum SignalMode : uint8_t {
+  SIG_IDLE,
+  SIG_DMX_TO_IR,
+  SIG_IR_TO_DMX,
+  SIG_IR_LEARN,
+  SIG_DMX_THRU          // port 1 přijímá, port 2 vysílá vstup + IR scény (jen DMX_THRU_ENABLED)
+};
+
+enum SignalCmdType : uint8_t {
+  CMD_SET_MODE,         // a = SignalMode
+  CMD_SET_IR_CODE,      // a = kanál 1..6, value = kód
+  CMD_SET_SCENE_VALUE,  // a = scéna 0..5, b = kanál 0..63, value = 0..255 (scény v RAM)
+  CMD_SCENE_BANK_SWAP,  // banka scén přepnula slot – převezmi nový (scene_bank.h)
+  CMD_SET_CUE,          // a = cue 0..15, b = scéna 0..5, value = fadeMs << 16 | waitMs
+  CMD_SET_CUE_COUNT,    // a = počet cue v seznamu
+  CMD_SET_CHASE_STEP,   // a = krok 0..15, b = scéna 0..5
+  CMD_SET_CHASE,        // a = počet kroků, b = fadePct, value = BPM
+  CMD_SET_CUE_MODE,     // a = CueMode
+  CMD_SET_CUE_IR_CODE,  // a = CueCommand (GO/BACK/PAUSE), value = kód
+  CMD_SET_WEB_LEVEL,    // value = kanál 0..511 << 8 | hodnota – živé přepsání z webu
+  CMD_RELEASE_WEB,      // web přestane řídit všechny kanály
+  CMD_SET_MERGE_PRIORITY, // a = MergeSource, b = priorita
+  CMD_SET_MERGE_LTP,    // a = 1 LTP / 0 HTP, value = kanál 0..511
+  CMD_CURVES_SWAP,      // UI připravilo druhou sadu výstupních křivek – přepni na ni
+  CMD_INJECT_FRAME,     // UI připravilo vložený rámec (signalInjectFrame) – převezmi ho
+  CMD_NUDGE_CONFIG      // UI připravilo novou konfiguraci relativního ovládání (signalSetNudge)
+};
+
+struct SignalCmd {
+  SignalCmdType type;
+  uint8_t  a;
+  uint8_t  b;
+  uint32_t value;
+};
+
+enum SignalEvtType : uint8_t {
+  EVT_IR_SENT,          // DMX→IR: kanál odeslal IR kód (code = 0 → kanál klesl pod 255)
+  EVT_DMX_STATS,        // snímek DmxStats (1× za s)
+  EVT_SCENE_SELECTED,   // IR→DMX: IR kód vybral scénu 1..6
+  EVT_IR_LEARNED,       // IR Learn: přijat platný kód
+  EVT_CUE_STATE         // IR→DMX: změna cue/kroku chase nebo pauzy
+};
+
+struct SignalEvt {
+  SignalEvtType type;
+  union {
+    struct {
+      uint8_t  ch;
+      uint32_t code;
+    } ir;
+    DmxStatsSnapshot stats;
+    uint8_t scene;
+    struct {
+      int16_t  protocol;   // decode_type_t
+      uint32_t code;
+    } learned;
+    CueStatus cue;
+  };
+};
+
+// Slučování zdrojů v IR→DMX (zapisuje signálová úloha, UI jen čte pro /metrics)
+struct MergeStats {
+  uint32_t merges;
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint16_t channels;    // počet kanálů posledního výstupu
+  uint32_t curveLastUs; // výstupní křivky (output_curves.h) posledního rámce
+  uint32_t curveMaxUs;
+  uint32_t nudgeLastUs; // posuny a master IR ovladačem (ir_nudge.h)
+  uint16_t nudgeChannels;
+  uint8_t  nudgeMaster = 255;  // plný jas, dokud první rámec neprojde posuny
+};
+
+extern SpscQueue<SignalCmd, 64> signalCmdQueue;
+extern SpscQueue<SignalEvt, 32> signalEvtQueue;
+extern MergeStats mergeStats;
+
+// Průchozí režim (zapisuje signálová úloha, UI jen čte pro /metrics)
+const DmxThruStats &dmxThruStats();
+
+// Jednorázová instalace DMX driveru (volat ze setup() na jádře 1 – tam pak běží i jeho ISR)
+void installDmxDriver();
+
+// Výchozí konfigurace ještě před spuštěním úlohy (pak už jen přes frontu)
+void signalInitConfig(const uint32_t irCodes[8], const uint8_t scenes[SIGNAL_SCENES][SIGNAL_SCENE_CH]);
+void signalInitCues(const CueList &list, const Chase &chase, CueMode mode, const uint32_t cueIrCodes[3]);
+void signalInitMerge(const uint8_t priorities[MERGE_SOURCES], const uint8_t ltpBits[MERGE_CHANNELS / 8]);
+void signalInitCurves(const CurveConfig &cfg);
+void signalInitNudge(const NudgeConfig &cfg);
+
+void signalTaskStart();
+// Jeden průchod smyčkou signálové úlohy (příkazy + obsluha režimu). Úloha ho
+// volá pořád dokola; soak harness (tools/soak) přímo, se simulovaným časem.
+void signalTaskStep();
+
+// UI strana: vloží příkaz, při plné frontě krátce počká (blokuje jen UI, ne signál)
+void signalPostCmd(SignalCmdType type, uint8_t a = 0, uint8_t b = 0, uint32_t value = 0);
+
+// UI strana: přepočítá neaktivní sadu výstupních křivek a požádá o přepnutí.
+// Čeká, dokud signálová úloha nepřevezme předchozí přepnutí; false = nestihla
+// to do SIGNAL_CURVES_WAIT_MS (křivky zůstávají beze změny).
+#define SIGNAL_CURVES_WAIT_MS 500
+bool signalSetCurves(const CurveConfig &cfg);
+
+// UI strana: nová konfigurace relativního ovládání IR ovladačem. Čeká, dokud
+// signálová úloha nepřevezme předchozí; false = nestihla to do SIGNAL_NUDGE_WAIT_MS.
+#define SIGNAL_NUDGE_WAIT_MS 500
+bool signalSetNudge(const NudgeConfig &cfg);
+
+// UI strana: celý rámec kanálů 1..count jako zdroj "web" slučování (sériový
+// protokol, serial_proto.h); count = 0 zdroj uvolní. Nečeká – false = signálová
+// úloha ještě nepřevzala předchozí rámec (živý rámec se pak radši zahodí).
+bool signalInjectFrame(const uint8_t *levels, uint16_t count);
@@ -0,0 +1,129 @@
+#pragma once
+//
+// Bezzámková fronta pro jednoho producenta a jednoho konzumenta (SPSC).
+// Producent zapisuje jen head, konzument jen tail – stačí acquire/release,
+// žádný mutex ani kritická sekce. Používá jen <atomic>, jde testovat na PC.
+//
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue: N musí být mocnina 2");
+
+ public:
+  SpscQueue() : head(0), tail(0), dropCount(0) {}
+
+  // Producent. Při plné frontě nic nečeká, jen vrátí false a započítá ztrátu.
+  bool push(const T &item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (h - t >= N) {
+      dropCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buf[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Konzument. Vrací false, pokud je fronta prázdná.
+  bool pop(T &item) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (h == t) return false;
+    item = buf[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Konzument: nahlédne na nejstarší položku bez vyjmutí (NULL = prázdná fronta).
+  // Ukazatel platí do drop().
+  const T *front() const {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    if (h == t) return nullptr;
+    return &buf[t & (N - 1)];
+  }
+
+  // Konzument: zahodí nejstarší položku (po front())
+  void drop() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == t) return;
+    tail.store(t + 1, std::memory_order_release);
+  }
+
+  // Obsazenost – z pohledu libovolné strany jen orientační
+  size_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() >= N; }
+  static constexpr size_t capacity() { return N; }
+
+  uint32_t dropped() const { return dropCount.load(std::memory_order_relaxed); }
+
+ private:
+  T buf[N];
+  // head a tail na vlastních řádcích cache, ať se jádra nepřetahují
+  alignas(32) std::atomic<uint32_t> head;
+  alignas(32) std::atomic<uint32_t> tail;
+  std::atomic<uint32_t> dropCount;
+};
+
+//
+// Bajtový kruhový buffer pro jednoho producenta a jednoho konzumenta –
+// pro proudová data proměnné délky (záznam show, log). Zápis je všechno
+// nebo nic, aby se záznamy nikdy nepřetrhly uprostřed.
+//
+template <size_t N>
+class SpscByteRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscByteRing: N musí být mocnina 2");
+
+ public:
+  SpscByteRing() : head(0), tail(0), dropCount(0) {}
+
+  // Producent
+  bool write(const uint8_t *data, size_t len) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    if (len > N - (h - t)) {
+      dropCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    size_t off = h & (N - 1);
+    size_t first = (len < N - off) ? len : N - off;
+    memcpy(&buf[off], data, first);
+    memcpy(&buf[0], data + first, len - first);
+    head.store(h + (uint32_t)len, std::memory_order_release);
+    return true;
+  }
+
+  // Konzument – přečte až max bajtů, vrací kolik
+  size_t read(uint8_t *out, size_t max) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    size_t avail = h - t;
+    size_t len = (avail < max) ? avail : max;
+    size_t off = t & (N - 1);
+    size_t first = (len < N - off) ? len : N - off;
+    memcpy(out, &buf[off], first);
+    memcpy(out + first, &buf[0], len - first);
+    tail.store(t + (uint32_t)len, std::memory_order_release);
+    return len;
+  }
+
+  size_t available() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+  static constexpr size_t capacity() { return N; }
+  uint32_t dropped() const { return dropCount.load(std::memory_order_relaxed); }
+
+ private:
+  uint8_t buf[N];
+  alignas(32) std::atomic<uint32_t> head;
+  alignas(32) std::atomic<uint32_t> tail;
+  std::atomic<uint32_t> dropCount;
+};
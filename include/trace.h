@@ -0,0 +1,66 @@
+#pragma once
+//
+// Trasování – kruhový buffer událostí begin/end/instant s časem v µs (micros()).
+//
+// Histogramy v /metrics řeknou, jak dlouho co trvá; stopa ukáže, co přesně
+// v tu chvíli běželo na kterém jádře. Zapisuje se z libovolné úlohy bez zámku:
+// slot přidělí atomický fetch_add a pořadové číslo slotu se zapíše až po
+// datech (seqlock), takže čtenář rozepsaný nebo mezitím přepsaný záznam pozná
+// a vynechá. Buffer drží posledních TRACE_EVENTS událostí – v běžném provozu
+// několik sekund.
+//
+// Export: GET /trace.json (Chrome trace event JSON) → chrome://tracing nebo
+// ui.perfetto.dev. Každá stopa (tid) je jedna úloha: signal, ir, ui, oled.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+#define TRACE_EVENTS 1024     // mocnina 2, 12 B na událost
+
+enum TraceId : uint8_t {
+  TRACE_DMX_FRAME,      // signal: zpracování přijatého DMX rámce (vč. IR v DMX→IR), arg = sloty
+  TRACE_DMX_OUT,        // signal: sloučení a vyslání výstupního rámce, arg = sloty
+  TRACE_IR_SEND,        // signal: odeslání IR kódu (NEC ~108 ms), arg = kanál
+  TRACE_IR_POP,         // signal: IR událost vyzvednuta z fronty, arg = čekání ve frontě (µs)
+  TRACE_IR_DECODE,      // ir: dekódovaný kód vložen do fronty, arg = spodních 16 bitů kódu
+  TRACE_DISPLAY_FLUSH,  // oled: přenos snímku na displej, arg (na konci) = poslané stránky
+  TRACE_HTTP,           // ui: obsluha jednoho HTTP požadavku
+  TRACE_NVS_WRITE,      // ui: zápis do NVS (Preferences)
+  TRACE_FLASH_WRITE,    // ui: zápis banky scén do flash (scene_bank.h), arg = počet scén
+  TRACE_IDS
+};
+
+enum TracePhase : uint8_t {
+  TRACE_BEGIN   = 'B',
+  TRACE_END     = 'E',
+  TRACE_INSTANT = 'i'
+};
+
+// arg u TRACE_END se v exportu připojí k úseku (jen nenulový)
+void traceRecord(TraceId id, TracePhase phase, uint16_t arg = 0);
+
+// Begin v konstruktoru, end v destruktoru – úsek = blok kódu
+class TraceScope {
+ public:
+  explicit TraceScope(TraceId id, uint16_t arg = 0) : id_(id), endArg_(0) { traceRecord(id, TRACE_BEGIN, arg); }
+  ~TraceScope() { traceRecord(id_, TRACE_END, endArg_); }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+  // Argument známý až během úseku (např. počet slotů po sloučení) – zapíše se s koncem
+  void setArg(uint16_t arg) { endArg_ = arg; }
+
+ private:
+  TraceId  id_;
+  uint16_t endArg_;
+};
+
+// Celkem zapsaných událostí od startu (i přepsaných)
+uint32_t traceRecorded();
+
+// Zkopíruje buffer a vypíše ho jako {"traceEvents":[...]} po částech (bez
+// velkého Stringu). Časy jsou relativní k nejstaršímu času v bufferu – pořadí
+// slotů nemusí odpovídat časům (zapisující úlohu může jiná přerušit mezi
+// odečtením času a přidělením slotu). Vrací bajty.
+class Print;
+size_t traceWriteJson(Print &out);
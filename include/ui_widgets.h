@@ -0,0 +1,125 @@
+#pragma once
+//
+// Malá retained-mode vrstva nad Adafruit_GFX pro OLED.
+// Widget si pamatuje, co je na displeji; setText()/setValue() porovnají nový obsah
+// se starým a jen při rozdílu ho označí k překreslení. UiScreen pak překreslí
+// pouze označené widgety a řekne, jestli je vůbec potřeba posílat framebuffer.
+//
+#include <Adafruit_GFX.h>
+#include <stdint.h>
+
+#define UI_FONT_W   6     // výchozí font 5×7 + mezera
+#define UI_FONT_H   8
+#define UI_MAX_COLS 21    // 128 / 6
+#define UI_MAX_ROWS 8     // 64 / 8
+#define UI_MAX_WIDGETS 16    // nejvíc dmxScreen: titulek + 6 × (úroveň, kód) + stav = 14
+
+class UiWidget {
+ public:
+  UiWidget(int16_t x, int16_t y, int16_t w, int16_t h) : x(x), y(y), w(w), h(h), dirty(true) {}
+  virtual ~UiWidget() {}
+
+  bool isDirty() const { return dirty; }
+  // Celý widget znovu (po smazání displeje)
+  virtual void invalidate() { dirty = true; }
+
+  // Smaže plochu widgetu a nakreslí ho znovu
+  virtual void render(Adafruit_GFX &gfx);
+
+ protected:
+  virtual void draw(Adafruit_GFX &gfx) = 0;
+
+  int16_t x, y, w, h;
+  bool dirty;
+};
+
+// Jeden řádek textu (volitelně zvětšený)
+class UiLabel : public UiWidget {
+ public:
+  UiLabel(int16_t x, int16_t y, uint8_t cols, uint8_t size = 1);
+
+  void setText(const char *s);
+  void setTextf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+  const char *getText() const { return text; }
+
+ protected:
+  void draw(Adafruit_GFX &gfx) override;
+
+ private:
+  char text[UI_MAX_COLS + 1];
+  uint8_t cols;
+  uint8_t size;
+};
+
+// Popisek + číslo pevné šířky, např. "CH1:255"
+class UiValue : public UiWidget {
+ public:
+  UiValue(int16_t x, int16_t y, const char *prefix, uint8_t digits);
+
+  void setValue(int32_t v);
+  int32_t getValue() const { return value; }
+
+ protected:
+  void draw(Adafruit_GFX &gfx) override;
+
+ private:
+  const char *prefix;
+  int32_t value;
+  uint8_t digits;
+  bool valid;
+};
+
+// Seznam položek s kurzorem "> " – překresluje jen změněné řádky
+class UiList : public UiWidget {
+ public:
+  UiList(int16_t x, int16_t y, uint8_t rows);
+
+  void setCount(uint8_t n);
+  void setItem(uint8_t i, const char *s);
+  void setSelected(int8_t i);
+  int8_t getSelected() const { return selected; }
+
+  void invalidate() override;
+  void render(Adafruit_GFX &gfx) override;
+
+ protected:
+  void draw(Adafruit_GFX &gfx) override;
+
+ private:
+  void drawRow(Adafruit_GFX &gfx, uint8_t row);
+
+  char items[UI_MAX_ROWS][UI_MAX_COLS - 1];
+  uint8_t rows;
+  uint8_t count;
+  int8_t selected;
+  uint8_t dirtyRows;  // bit i = řádek i
+};
+
+// Obrazovka = sada widgetů; jen jedna je aktivní
+class UiScreen {
+ public:
+  UiScreen() : count(0) {}
+
+  // false = obrazovka je plná (UI_MAX_WIDGETS), widget se nezobrazí
+  bool add(UiWidget *w);
+
+  // Přepnutí na obrazovku: vše se překreslí od nuly
+  void invalidateAll();
+
+  // Překreslí jen změněné widgety; vrací počet překreslených (0 = framebuffer beze změny)
+  uint8_t render(Adafruit_GFX &gfx);
+
+ private:
+  UiWidget *widgets[UI_MAX_WIDGETS];
+  uint8_t count;
+};
+
+// Statistika vykreslování (pro /metrics)
+struct UiRenderStats {
+  uint32_t renders;         // render() s alespoň jedním změněným widgetem
+  uint32_t skipped;         // render() bez změny – nic se nekreslilo ani neposílalo
+  uint32_t widgetsDrawn;
+  uint32_t lastRenderUs;
+  uint32_t maxRenderUs;
+};
+extern UiRenderStats uiRenderStats;
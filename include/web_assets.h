@@ -0,0 +1,23 @@
+#pragma once
+//
+// Statické soubory webového rozhraní (web/) – při buildu je
+// tools/build_web_assets.py zkomprimuje gzipem do src/web_assets_data.cpp.
+// Posílají se beze změny s Content-Encoding: gzip a silným ETagem; prohlížeč
+// se pak jen ptá If-None-Match a dostane 304 bez těla.
+//
+#include <stdint.h>
+#include <stddef.h>
+
+struct WebAsset {
+  const char    *path;         // "/app.js"
+  const char    *contentType;
+  const uint8_t *data;         // gzip, ve flash
+  uint32_t       length;
+  const char    *etag;         // včetně uvozovek
+};
+
+extern const WebAsset webAssets[];
+extern const size_t webAssetCount;
+
+// NULL = není statický soubor
+const WebAsset *webAssetFind(const char *path);
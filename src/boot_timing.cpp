@@ -0,0 +1,44 @@
+#include "boot_timing.h"
+#include "log.h"
+
+static volatile uint32_t phaseUs[BOOT_PHASES] = {0};
+
+static const char *const phaseNames[BOOT_PHASES] = {
+  "setup", "signal_io", "config", "signal_ready", "display", "storage", "wifi", "first_ir"
+};
+
+void bootMark(BootPhase phase) {
+  if (phase >= BOOT_PHASES || phaseUs[phase]) return;
+  uint32_t us = micros();
+  phaseUs[phase] = us ? us : 1;
+}
+
+uint32_t bootPhaseUs(BootPhase phase) {
+  return phase < BOOT_PHASES ? phaseUs[phase] : 0;
+}
+
+const char *bootPhaseName(BootPhase phase) {
+  return phase < BOOT_PHASES ? phaseNames[phase] : "?";
+}
+
+void bootReport() {
+  LOG_I("Start (ms od spuštění):");
+  for (int p = 0; p < BOOT_PHASES; p++) {
+    uint32_t us = phaseUs[p];
+    if (us) LOG_I("  %-13s %4lu.%03lu", phaseNames[p], (unsigned long)(us / 1000), (unsigned long)(us % 1000));
+    else    LOG_I("  %-13s    -", phaseNames[p]);
+  }
+  uint32_t ready = phaseUs[BOOT_SIGNAL_READY] / 1000;
+  if (ready <= BOOT_TARGET_IR_READY_MS) LOG_I("IR připraveno za %lu ms (cíl %u ms)", (unsigned long)ready, BOOT_TARGET_IR_READY_MS);
+  else LOG_W("IR připraveno za %lu ms (cíl %u ms) – PŘEKROČENO", (unsigned long)ready, BOOT_TARGET_IR_READY_MS);
+}
+
+void appendBootMetrics(ArenaText &out) {
+  char line[48];
+  for (int p = 0; p < BOOT_PHASES; p++) {
+    snprintf(line, sizeof(line), "boot_%s_us %lu\n", phaseNames[p], (unsigned long)phaseUs[p]);
+    out += line;
+  }
+  snprintf(line, sizeof(line), "boot_ir_ready_target_ms %u\n", BOOT_TARGET_IR_READY_MS);
+  out += line;
+}
@@ -0,0 +1,280 @@
+#include <string.h>
+#include "config_blob.h"
+#include "crc32.h"
+
+// ========================
+// Zápis / čtení little-endian
+// ========================
+class BlobWriter {
+ public:
+  BlobWriter(uint8_t *buf, size_t max) : buf(buf), max(max), pos(0), ok(true) {}
+
+  void u8(uint8_t v) {
+    if (pos + 1 > max) { ok = false; return; }
+    buf[pos++] = v;
+  }
+  void u16(uint16_t v) { u8(v & 0xFF); u8(v >> 8); }
+  void u32(uint32_t v) { u16(v & 0xFFFF); u16(v >> 16); }
+  void bytes(const uint8_t *p, size_t n) {
+    if (pos + n > max) { ok = false; return; }
+    memcpy(buf + pos, p, n);
+    pos += n;
+  }
+
+  // Sekce: délka se doplní v endSection()
+  size_t beginSection(ConfigSection id) {
+    u8(id);
+    size_t at = pos;
+    u16(0);
+    return at;
+  }
+  void endSection(size_t at) {
+    if (!ok) return;
+    size_t len = pos - at - 2;
+    buf[at] = len & 0xFF;
+    buf[at + 1] = len >> 8;
+  }
+
+  uint8_t *buf;
+  size_t max, pos;
+  bool ok;
+};
+
+class BlobReader {
+ public:
+  BlobReader(const uint8_t *buf, size_t len) : buf(buf), len(len), pos(0), ok(true) {}
+
+  uint8_t u8() {
+    if (pos + 1 > len) { ok = false; return 0; }
+    return buf[pos++];
+  }
+  uint16_t u16() { uint16_t lo = u8(); return lo | (uint16_t)u8() << 8; }
+  uint32_t u32() { uint32_t lo = u16(); return lo | (uint32_t)u16() << 16; }
+  void bytes(uint8_t *p, size_t n) {
+    if (pos + n > len) { ok = false; return; }
+    memcpy(p, buf + pos, n);
+    pos += n;
+  }
+
+  const uint8_t *buf;
+  size_t len, pos;
+  bool ok;
+};
+
+void configDefaults(DeviceConfig &cfg) {
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.chase.bpm = 120;
+  cfg.cueMode = CUE_MODE_OFF;
+  const uint8_t prio[MERGE_SOURCES] = MERGE_DEFAULT_PRIORITIES;
+  memcpy(cfg.mergePriorities, prio, sizeof(prio));
+  curveDefaults(cfg.curves);
+  nudgeDefaults(cfg.nudge);
+}
+
+size_t configSerialize(const DeviceConfig &cfg, uint8_t *out, size_t max) {
+  BlobWriter w(out, max);
+  w.bytes((const uint8_t *)CONFIG_MAGIC, 4);
+  w.u8(CONFIG_VERSION);
+  w.u8(0);       // flags
+  w.u16(0);      // rezerva
+  w.u32(0);      // délka a CRC se doplní na konci
+  w.u32(0);
+
+  size_t s = w.beginSection(CFG_SEC_IR_CODES);
+  for (int i = 1; i <= 6; i++) w.u32(cfg.irCodes[i]);
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_SCENES);
+  w.bytes(&cfg.scenes[0][0], sizeof(cfg.scenes));
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_CUES);
+  w.u8(cfg.cueList.count);
+  for (int i = 0; i < CUE_MAX_CUES; i++) {
+    w.u8(cfg.cueList.cues[i].scene);
+    w.u16(cfg.cueList.cues[i].fadeMs);
+    w.u16(cfg.cueList.cues[i].waitMs);
+  }
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_CHASE);
+  w.u8(cfg.chase.count);
+  w.bytes(cfg.chase.steps, CUE_MAX_STEPS);
+  w.u16(cfg.chase.bpm);
+  w.u8(cfg.chase.fadePct);
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_CUE_IR);
+  w.u8(cfg.cueMode);
+  for (int i = 0; i < 3; i++) w.u32(cfg.cueIrCodes[i]);
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_MERGE);
+  w.bytes(cfg.mergePriorities, CONFIG_MERGE_PRIOS);
+  w.bytes(cfg.mergeLtpBits, sizeof(cfg.mergeLtpBits));
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_THRU);
+  w.u8(cfg.mergePriorities[MERGE_SRC_INPUT]);
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_CURVES);
+  w.u8(CURVE_PROFILES);
+  for (int p = 0; p < CURVE_PROFILES; p++) {
+    const CurveProfile &cp = cfg.curves.profiles[p];
+    w.u8(cp.type);
+    w.u8(cp.gammaX10);
+    w.u8(cp.min);
+    w.u8(cp.max);
+    w.u8(cp.invert);
+    w.bytes(cp.points, CURVE_POINTS);
+  }
+  for (int ch = 0; ch < CURVE_CHANNELS; ch += 2) {
+    w.u8((cfg.curves.channelProfile[ch] & 0x0F) | cfg.curves.channelProfile[ch + 1] << 4);
+  }
+  w.endSection(s);
+
+  s = w.beginSection(CFG_SEC_NUDGE);
+  w.u8(NUDGE_ACTIONS);
+  for (int i = 0; i < NUDGE_ACTIONS; i++) {
+    w.u32(cfg.nudge.actions[i].code);
+    w.u8(cfg.nudge.actions[i].kind);
+    w.u8(cfg.nudge.actions[i].group);
+  }
+  w.u8(NUDGE_GROUPS);
+  w.bytes(&cfg.nudge.groups[0][0], sizeof(cfg.nudge.groups));
+  w.u8(cfg.nudge.step);
+  w.u16(cfg.nudge.rampStart);
+  w.u16(cfg.nudge.rampMax);
+  w.u16(cfg.nudge.accelMs);
+  w.endSection(s);
+
+  if (!w.ok) return 0;
+  size_t payload = w.pos - CONFIG_HEADER_SIZE;
+  uint32_t crc = crc32Update(0, out + CONFIG_HEADER_SIZE, payload);
+  BlobWriter h(out + 8, 8);
+  h.u32((uint32_t)payload);
+  h.u32(crc);
+  return w.pos;
+}
+
+// Obsah jedné sekce do cfg; false = sekce je kratší, než má být
+static bool parseSection(uint8_t id, BlobReader &r, DeviceConfig &cfg) {
+  switch (id) {
+    case CFG_SEC_IR_CODES:
+      for (int i = 1; i <= 6; i++) cfg.irCodes[i] = r.u32();
+      break;
+    case CFG_SEC_SCENES:
+      r.bytes(&cfg.scenes[0][0], sizeof(cfg.scenes));
+      break;
+    case CFG_SEC_CUES:
+      cfg.cueList.count = r.u8();
+      if (cfg.cueList.count > CUE_MAX_CUES) return false;
+      for (int i = 0; i < CUE_MAX_CUES; i++) {
+        cfg.cueList.cues[i].scene  = r.u8();
+        cfg.cueList.cues[i].fadeMs = r.u16();
+        cfg.cueList.cues[i].waitMs = r.u16();
+      }
+      break;
+    case CFG_SEC_CHASE:
+      cfg.chase.count = r.u8();
+      if (cfg.chase.count > CUE_MAX_STEPS) return false;
+      r.bytes(cfg.chase.steps, CUE_MAX_STEPS);
+      cfg.chase.bpm = r.u16();
+      cfg.chase.fadePct = r.u8();
+      break;
+    case CFG_SEC_CUE_IR:
+      cfg.cueMode = (CueMode)r.u8();
+      if (cfg.cueMode > CUE_MODE_CHASE) return false;
+      for (int i = 0; i < 3; i++) cfg.cueIrCodes[i] = r.u32();
+      break;
+    case CFG_SEC_MERGE:
+      r.bytes(cfg.mergePriorities, CONFIG_MERGE_PRIOS);
+      r.bytes(cfg.mergeLtpBits, sizeof(cfg.mergeLtpBits));
+      break;
+    case CFG_SEC_THRU:
+      cfg.mergePriorities[MERGE_SRC_INPUT] = r.u8();
+      break;
+    case CFG_SEC_CURVES: {
+      uint8_t count = r.u8();
+      if (count > CURVE_PROFILES) return false;
+      for (int p = 0; p < count; p++) {
+        CurveProfile &cp = cfg.curves.profiles[p];
+        cp.type = (CurveType)r.u8();
+        if (cp.type > CURVE_CUSTOM) return false;
+        cp.gammaX10 = r.u8();
+        cp.min = r.u8();
+        cp.max = r.u8();
+        cp.invert = r.u8() != 0;
+        r.bytes(cp.points, CURVE_POINTS);
+      }
+      for (int ch = 0; ch < CURVE_CHANNELS; ch += 2) {
+        uint8_t v = r.u8();
+        cfg.curves.channelProfile[ch] = v & 0x0F;
+        cfg.curves.channelProfile[ch + 1] = v >> 4;
+        if ((v & 0x0F) >= count || (v >> 4) >= count) return false;
+      }
+      break;
+    }
+    case CFG_SEC_NUDGE: {
+      uint8_t count = r.u8();
+      if (count > NUDGE_ACTIONS) return false;
+      for (int i = 0; i < count; i++) {
+        NudgeAction &a = cfg.nudge.actions[i];
+        a.code = r.u32();
+        a.kind = (NudgeKind)r.u8();
+        a.group = r.u8();
+        if (a.kind > NUDGE_RESET || a.group >= NUDGE_GROUPS) return false;
+      }
+      uint8_t groups = r.u8();
+      if (groups > NUDGE_GROUPS) return false;
+      r.bytes(&cfg.nudge.groups[0][0], groups * sizeof(cfg.nudge.groups[0]));
+      cfg.nudge.step = r.u8();
+      cfg.nudge.rampStart = r.u16();
+      cfg.nudge.rampMax = r.u16();
+      cfg.nudge.accelMs = r.u16();
+      break;
+    }
+    default:
+      break;   // neznámá sekce (novější firmware) – přeskočí se
+  }
+  return r.ok;
+}
+
+ConfigError configParse(const uint8_t *in, size_t len, DeviceConfig &cfg) {
+  if (len < CONFIG_HEADER_SIZE || len > CONFIG_MAX_SIZE) return CONFIG_ERR_SIZE;
+  if (memcmp(in, CONFIG_MAGIC, 4) != 0) return CONFIG_ERR_MAGIC;
+  if (in[4] == 0 || in[4] > CONFIG_VERSION) return CONFIG_ERR_VERSION;
+
+  BlobReader h(in + 8, 8);
+  uint32_t payload = h.u32();
+  uint32_t crc = h.u32();
+  if (payload != len - CONFIG_HEADER_SIZE) return CONFIG_ERR_SIZE;
+  if (crc32Update(0, in + CONFIG_HEADER_SIZE, payload) != crc) return CONFIG_ERR_CRC;
+
+  // vše do pracovní kopie – cfg se přepíše až po kontrole všech sekcí
+  DeviceConfig tmp = cfg;
+  BlobReader r(in + CONFIG_HEADER_SIZE, payload);
+  while (r.pos < r.len) {
+    uint8_t id = r.u8();
+    uint16_t secLen = r.u16();
+    if (!r.ok || r.pos + secLen > r.len) return CONFIG_ERR_SECTION;
+    BlobReader sec(r.buf + r.pos, secLen);
+    if (!parseSection(id, sec, tmp)) return CONFIG_ERR_SECTION;
+    r.pos += secLen;
+  }
+  cfg = tmp;
+  return CONFIG_OK;
+}
+
+const char *configErrorName(ConfigError err) {
+  switch (err) {
+    case CONFIG_OK:          return "ok";
+    case CONFIG_ERR_SIZE:    return "bad size";
+    case CONFIG_ERR_MAGIC:   return "not a config blob";
+    case CONFIG_ERR_VERSION: return "unsupported version";
+    case CONFIG_ERR_CRC:     return "CRC mismatch";
+    case CONFIG_ERR_SECTION: return "corrupt section";
+  }
+  return "?";
+}
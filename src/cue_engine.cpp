@@ -0,0 +1,173 @@
+#include <string.h>
+#include "cue_engine.h"
+
+static const uint8_t blackout[CUE_CHANNELS] = {0};
+
+CueEngine::CueEngine()
+  : scenes(nullptr), sceneCount(0), mode(CUE_MODE_OFF),
+    active(false), paused(false), pausedAt(0), pauseTotal(0),
+    cur(CUE_NONE), cueStart(0), chaseStart(0), stepOffset(0), lastStep(CUE_NONE) {
+  memset(&list, 0, sizeof(list));
+  memset(&chase, 0, sizeof(chase));
+  memset(from, 0, sizeof(from));
+  memset(last, 0, sizeof(last));
+}
+
+void CueEngine::setScenes(const uint8_t (*s)[CUE_CHANNELS], uint8_t count) {
+  scenes = s;
+  sceneCount = count;
+}
+
+void CueEngine::setCueList(const CueList &l) {
+  list = l;
+  if (list.count > CUE_MAX_CUES) list.count = CUE_MAX_CUES;
+  if (cur != CUE_NONE && cur >= list.count) {
+    cur = CUE_NONE;
+    if (mode == CUE_MODE_LIST) active = false;
+  }
+}
+
+void CueEngine::setChase(const Chase &c) {
+  chase = c;
+  if (chase.count > CUE_MAX_STEPS) chase.count = CUE_MAX_STEPS;
+  if (chase.fadePct > 100) chase.fadePct = 100;
+}
+
+void CueEngine::setMode(CueMode m) {
+  if (m == mode) return;
+  mode = m;
+  active = false;
+  paused = false;
+  cur = CUE_NONE;
+  lastStep = CUE_NONE;
+}
+
+void CueEngine::release(const uint8_t *levels) {
+  memcpy(last, levels, sizeof(last));
+  active = false;
+}
+
+uint32_t CueEngine::localTime(uint32_t nowMs) const {
+  return paused ? pausedAt : nowMs - pauseTotal;
+}
+
+const uint8_t *CueEngine::sceneLevels(uint8_t scene) const {
+  return (scenes && scene < sceneCount) ? scenes[scene] : blackout;
+}
+
+void CueEngine::startCue(uint8_t index, uint32_t t) {
+  memcpy(from, last, sizeof(from));
+  cur = index;
+  cueStart = t;
+}
+
+void CueEngine::command(CueCommand cmd, uint32_t nowMs) {
+  if (mode == CUE_MODE_OFF) return;
+
+  if (cmd == CUE_PAUSE) {
+    if (!active) return;
+    if (!paused) {
+      pausedAt = nowMs - pauseTotal;
+      paused = true;
+    } else {
+      pauseTotal = nowMs - pausedAt;
+      paused = false;
+    }
+    return;
+  }
+
+  // GO/BACK ruší pauzu
+  if (paused) {
+    pauseTotal = nowMs - pausedAt;
+    paused = false;
+  }
+  uint32_t t = localTime(nowMs);
+
+  if (mode == CUE_MODE_LIST) {
+    if (!list.count) return;
+    if (cmd == CUE_GO) {
+      // po posledním cue začíná seznam znovu
+      uint8_t next = (cur == CUE_NONE || cur + 1 >= list.count) ? 0 : cur + 1;
+      startCue(next, t);
+    } else {
+      if (cur == CUE_NONE || cur == 0) return;
+      startCue(cur - 1, t);
+    }
+    active = true;
+    return;
+  }
+
+  // chase: první GO ho spustí, další posouvají o krok
+  if (!chase.count) return;
+  if (!active) {
+    if (cmd != CUE_GO) return;
+    chaseStart = t;
+    stepOffset = 0;
+    active = true;
+    return;
+  }
+  stepOffset += (cmd == CUE_GO) ? 1 : -1;
+}
+
+void CueEngine::renderList(uint32_t t, uint8_t *out) {
+  if (cur == CUE_NONE) {
+    memcpy(out, last, CUE_CHANNELS);
+    return;
+  }
+  // automatické pokračování – nový cue začíná přesně v plánovaném čase, ne v čase ticku
+  for (uint8_t guard = 0; guard < CUE_MAX_CUES; guard++) {
+    const Cue &c = list.cues[cur];
+    uint32_t follow = (uint32_t)c.fadeMs + c.waitMs;
+    if (!c.waitMs || t - cueStart < follow) break;
+    memcpy(from, sceneLevels(c.scene), sizeof(from));
+    cur = (cur + 1 >= list.count) ? 0 : cur + 1;
+    cueStart += follow;
+  }
+
+  const Cue &c = list.cues[cur];
+  const uint8_t *to = sceneLevels(c.scene);
+  uint32_t pos = t - cueStart;
+  for (int ch = 0; ch < CUE_CHANNELS; ch++) out[ch] = cueMix(from[ch], to[ch], pos, c.fadeMs);
+}
+
+void CueEngine::renderChase(uint32_t t, uint8_t *out) {
+  if (!chase.count || !chase.bpm) {
+    memcpy(out, last, CUE_CHANNELS);
+    return;
+  }
+  // krok k trvá od ceil(k*60000/bpm) do ceil((k+1)*60000/bpm) – celá čísla, žádné sčítání chyb
+  uint32_t et = t - chaseStart;
+  uint64_t k = (uint64_t)et * chase.bpm / 60000;
+  uint32_t stepStart = (uint32_t)((k * 60000 + chase.bpm - 1) / chase.bpm);
+  uint32_t stepEnd   = (uint32_t)(((k + 1) * 60000 + chase.bpm - 1) / chase.bpm);
+  uint32_t fadeLen = (stepEnd - stepStart) * chase.fadePct / 100;
+
+  int32_t n = chase.count;
+  int32_t idx = (int32_t)((k + (uint64_t)(stepOffset % n + n)) % n);
+  int32_t prev = (idx + n - 1) % n;
+  lastStep = (uint8_t)idx;
+
+  const uint8_t *a = sceneLevels(chase.steps[prev]);
+  const uint8_t *b = sceneLevels(chase.steps[idx]);
+  uint32_t pos = et - stepStart;
+  for (int ch = 0; ch < CUE_CHANNELS; ch++) out[ch] = cueMix(a[ch], b[ch], pos, fadeLen);
+}
+
+bool CueEngine::tick(uint32_t nowMs, uint8_t *out) {
+  if (mode == CUE_MODE_OFF || !active) return false;
+  uint32_t t = localTime(nowMs);
+  if (mode == CUE_MODE_LIST) renderList(t, out);
+  else                       renderChase(t, out);
+  memcpy(last, out, sizeof(last));
+  return true;
+}
+
+CueStatus CueEngine::status() const {
+  CueStatus st;
+  st.mode = mode;
+  st.active = active;
+  st.paused = paused;
+  st.index = (mode == CUE_MODE_CHASE) ? lastStep : cur;
+  st.count = (mode == CUE_MODE_CHASE) ? chase.count : list.count;
+  return st;
+}
@@ -0,0 +1,42 @@
+#include <string.h>
+#include "dmx_change.h"
+
+// Slovo 4 kanálů; zarovnání slibuje volající (jeden l32i místo 4 bajtových čtení)
+static inline uint32_t loadWord(const uint8_t *p) {
+  uint32_t w;
+  memcpy(&w, __builtin_assume_aligned(p, 4), 4);
+  return w;
+}
+
+void DmxChangeDetector::reset() {
+  memset(prev_, 0, sizeof(prev_));
+  prevCount_ = 0;
+  all_ = true;
+}
+
+bool DmxChangeDetector::update(const uint8_t *channels, uint16_t count) {
+  if (count > DMX_CHANGE_CHANNELS) count = DMX_CHANGE_CHANNELS;
+  uint16_t span = count > prevCount_ ? count : prevCount_;
+  uint16_t words = (span + 3) / 4;
+  uint16_t full = count / 4;
+  bool changed = all_;
+
+  // celá slova v těsné smyčce, rozpracované a vypadlé slovo na konci zvlášť;
+  // zapisuje se jen změněné slovo, nezměněný rámec je jen čtení
+  for (uint16_t i = 0; i < words; i++) {
+    uint32_t cur;
+    if (i < full) {
+      cur = loadWord(channels + i * 4);
+    } else {
+      int valid = count - i * 4;
+      cur = valid > 0 ? loadWord(channels + i * 4) & ((1u << (valid * 8)) - 1) : 0;
+    }
+    if (cur != prev_[i]) {
+      prev_[i] = cur;
+      changed = true;
+    }
+  }
+  prevCount_ = count;
+  all_ = false;
+  return changed;
+}
@@ -0,0 +1,181 @@
+#include <string.h>
+#include "dmx_merge.h"
+
+#define MERGE_NO_OWNER 0xFF
+
+DmxMerger::DmxMerger() : anyLtp_(false) {
+  memset(levels_, 0, sizeof(levels_));
+  memset(cover_, 0, sizeof(cover_));
+  memset(&ltp_, 0, sizeof(ltp_));
+  memset(owner_, MERGE_NO_OWNER, sizeof(owner_));
+  memset(extent_, 0, sizeof(extent_));
+  const uint8_t prio[MERGE_SOURCES] = MERGE_DEFAULT_PRIORITIES;
+  memcpy(prio_, prio, sizeof(prio_));
+}
+
+void DmxMerger::setLtp(uint16_t ch, bool ltp) {
+  if (ch >= MERGE_CHANNELS) return;
+  ltp_.b[ch] = ltp ? 0xFF : 0;
+  anyLtp_ = false;
+  for (int w = 0; w < MERGE_WORDS; w++) {
+    if (ltp_.w[w]) { anyLtp_ = true; break; }
+  }
+}
+
+bool DmxMerger::isLtp(uint16_t ch) const {
+  return ch < MERGE_CHANNELS && ltp_.b[ch];
+}
+
+void DmxMerger::updateOwner(MergeSource src, uint16_t ch, uint8_t level, bool covered) {
+  // LTP: kanál patří zdroji, který ho naposledy změnil (nebo právě začal řídit)
+  if (!covered || levels_[src].b[ch] != level) owner_[ch] = src;
+}
+
+void DmxMerger::setLevels(MergeSource src, const uint8_t *levels, uint16_t count) {
+  if (count > MERGE_CHANNELS) count = MERGE_CHANNELS;
+  Plane &lv = levels_[src];
+  Plane &cv = cover_[src];
+  for (uint16_t ch = 0; ch < count; ch++) {
+    updateOwner(src, ch, levels[ch], cv.b[ch] != 0);
+    lv.b[ch] = levels[ch];
+    cv.b[ch] = 0xFF;
+  }
+  for (uint16_t ch = count; ch < extent_[src]; ch++) {
+    lv.b[ch] = 0;
+    cv.b[ch] = 0;
+  }
+  extent_[src] = count;
+}
+
+void DmxMerger::setChannel(MergeSource src, uint16_t ch, uint8_t level) {
+  if (ch >= MERGE_CHANNELS) return;
+  updateOwner(src, ch, level, cover_[src].b[ch] != 0);
+  levels_[src].b[ch] = level;
+  cover_[src].b[ch] = 0xFF;
+  if (ch + 1 > extent_[src]) extent_[src] = ch + 1;
+}
+
+void DmxMerger::release(MergeSource src) {
+  memset(levels_[src].b, 0, extent_[src]);
+  memset(cover_[src].b, 0, extent_[src]);
+  extent_[src] = 0;
+}
+
+uint16_t DmxMerger::merge(uint8_t *out) {
+  // aktivní zdroje podle priority sestupně (jsou 4 – stačí vkládání)
+  uint8_t order[MERGE_SOURCES];
+  int n = 0;
+  uint16_t extent = 0;
+  for (uint8_t s = 0; s < MERGE_SOURCES; s++) {
+    if (!extent_[s]) continue;
+    int i = n++;
+    while (i > 0 && prio_[order[i - 1]] < prio_[s]) { order[i] = order[i - 1]; i--; }
+    order[i] = s;
+    if (extent_[s] > extent) extent = extent_[s];
+  }
+  if (!n) return 0;
+
+  // skupiny se stejnou prioritou předem – vnitřní smyčka jen čte slova
+  const uint32_t *lv[MERGE_SOURCES], *cv[MERGE_SOURCES];
+  int groupEnd[MERGE_SOURCES], groups = 0;
+  for (int i = 0; i < n; i++) {
+    lv[i] = levels_[order[i]].w;
+    cv[i] = cover_[order[i]].w;
+    if (i + 1 == n || prio_[order[i + 1]] != prio_[order[i]]) groupEnd[groups++] = i + 1;
+  }
+
+  Plane res;
+  int words = (extent + 3) / 4;
+  for (int w = 0; w < words; w++) {
+    uint32_t outW = 0, claimed = 0;
+    int i = 0;
+    for (int g = 0; g < groups && claimed != 0xFFFFFFFF; g++) {
+      // HTP přes pokryté kanály skupiny
+      uint32_t gOut = 0, gCov = 0;
+      for (; i < groupEnd[g]; i++) {
+        uint32_t c = cv[i][w];
+        gOut = mergeMaxU8x4(gOut, lv[i][w] & c);
+        gCov |= c;
+      }
+      // kanály už vyřízené vyšší prioritou se nepřepisují
+      outW |= gOut & ~claimed;
+      claimed |= gCov;
+    }
+    res.w[w] = outW;
+  }
+
+  // LTP kanály: hodnota vlastníka, pokud patří do vítězné priority kanálu
+  if (anyLtp_ && n > 1) {
+    for (int w = 0; w < words; w++) {
+      if (!ltp_.w[w]) continue;
+      for (int ch = w * 4; ch < w * 4 + 4; ch++) {
+        uint8_t own = owner_[ch];
+        if (!ltp_.b[ch] || own == MERGE_NO_OWNER || !cover_[own].b[ch]) continue;
+        for (int i = 0; i < n; i++) {
+          if (!cover_[order[i]].b[ch]) continue;
+          if (prio_[own] == prio_[order[i]]) res.b[ch] = levels_[own].b[ch];
+          break;
+        }
+      }
+    }
+  }
+
+  memcpy(out, res.b, extent);
+  return extent;
+}
+
+uint16_t DmxMerger::mergeScalar(uint8_t *out) const {
+  uint16_t extent = 0;
+  for (int s = 0; s < MERGE_SOURCES; s++) {
+    if (extent_[s] > extent) extent = extent_[s];
+  }
+  for (uint16_t ch = 0; ch < extent; ch++) {
+    int best = -1;
+    uint8_t v = 0;
+    for (int s = 0; s < MERGE_SOURCES; s++) {
+      if (!cover_[s].b[ch]) continue;
+      if (prio_[s] > best) {
+        best = prio_[s];
+        v = levels_[s].b[ch];
+      } else if (prio_[s] == best && levels_[s].b[ch] > v) {
+        v = levels_[s].b[ch];
+      }
+    }
+    uint8_t own = owner_[ch];
+    if (ltp_.b[ch] && own != MERGE_NO_OWNER && cover_[own].b[ch] && prio_[own] == best) {
+      v = levels_[own].b[ch];
+    }
+    out[ch] = v;
+  }
+  return extent;
+}
+
+DmxMergeBench dmxMergeBench(uint32_t iterations, uint32_t (*nowUs)()) {
+  static DmxMerger m;
+  static uint8_t src[MERGE_CHANNELS], outW[MERGE_CHANNELS], outS[MERGE_CHANNELS];
+
+  // 2 plné zdroje na stejné prioritě, show přes polovinu, web pár kanálů; LTP každý 8. kanál
+  uint32_t seed = 12345;
+  const MergeSource srcs[4] = { MERGE_SRC_SCENE, MERGE_SRC_CUE, MERGE_SRC_SHOW, MERGE_SRC_WEB };
+  const uint16_t counts[4] = { MERGE_CHANNELS, MERGE_CHANNELS, MERGE_CHANNELS / 2, 32 };
+  for (int s = 0; s < 4; s++) {
+    for (int ch = 0; ch < MERGE_CHANNELS; ch++) {
+      seed = seed * 1103515245 + 12345;
+      src[ch] = (uint8_t)(seed >> 16);
+    }
+    m.setLevels(srcs[s], src, counts[s]);
+  }
+  for (uint16_t ch = 0; ch < MERGE_CHANNELS; ch += 8) m.setLtp(ch, true);
+
+  DmxMergeBench r;
+  r.iterations = iterations;
+  uint32_t t0 = nowUs();
+  for (uint32_t i = 0; i < iterations; i++) m.mergeScalar(outS);
+  uint32_t t1 = nowUs();
+  for (uint32_t i = 0; i < iterations; i++) m.merge(outW);
+  uint32_t t2 = nowUs();
+  r.scalarUs = t1 - t0;
+  r.wordUs = t2 - t1;
+  r.match = memcmp(outS, outW, MERGE_CHANNELS) == 0;
+  return r;
+}
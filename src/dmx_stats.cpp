@@ -0,0 +1,87 @@
+#include "dmx_stats.h"
+#include <string.h>
+
+void DmxStats::reset() {
+  memset(&snap, 0, sizeof(snap));
+  snap.minSlots = 0xFFFF;
+  windowStartUs = 0;
+  lastFrameUs = 0;
+  windowFrames = 0;
+  windowErrors = 0;
+  windowIntervalMaxUs = 0;
+  avgIntervalQ4 = 0;
+  jitterQ4 = 0;
+  haveLastFrame = false;
+}
+
+bool DmxStats::record(DmxFrameResult result, uint32_t nowUs, size_t slots, uint8_t startCode) {
+  if (result == DMX_FRAME_NONE) return false;
+
+  // Start kód a délku kontrolujeme sami – driver vrací OK i pro ne-DMX pakety
+  if (result == DMX_FRAME_OK) {
+    if (startCode != 0x00) result = DMX_FRAME_BAD_START_CODE;
+    else if (slots < DMX_STATS_MIN_SLOTS) result = DMX_FRAME_SHORT;
+  }
+
+  switch (result) {
+    case DMX_FRAME_UART_ERROR:     snap.uartErrors++;    break;
+    case DMX_FRAME_BREAK_ERROR:    snap.breakErrors++;   break;
+    case DMX_FRAME_SHORT:          snap.shortFrames++;   break;
+    case DMX_FRAME_BAD_START_CODE:
+      snap.badStartCodes++;
+      snap.lastBadStartCode = startCode;
+      break;
+    default: break;
+  }
+  if (result != DMX_FRAME_OK) {
+    windowErrors++;
+    return false;
+  }
+
+  // platný rámec
+  snap.framesTotal++;
+  windowFrames++;
+  snap.lastSlots = (uint16_t)slots;
+  if (snap.lastSlots < snap.minSlots) snap.minSlots = snap.lastSlots;
+  if (snap.lastSlots > snap.maxSlots) snap.maxSlots = snap.lastSlots;
+
+  if (haveLastFrame) {
+    uint32_t interval = nowUs - lastFrameUs;
+    if (interval > windowIntervalMaxUs) windowIntervalMaxUs = interval;
+    // jitter po vzoru RFC 3550: J += (|D| - J) / 16
+    uint32_t intervalQ4 = interval << 4;
+    if (avgIntervalQ4 == 0) avgIntervalQ4 = intervalQ4;
+    uint32_t dev = (intervalQ4 > avgIntervalQ4) ? intervalQ4 - avgIntervalQ4 : avgIntervalQ4 - intervalQ4;
+    jitterQ4 += ((int32_t)dev - (int32_t)jitterQ4) / 16;
+    avgIntervalQ4 += ((int32_t)intervalQ4 - (int32_t)avgIntervalQ4) / 16;
+    snap.intervalAvgUs = avgIntervalQ4 >> 4;
+    snap.jitterUs = jitterQ4 >> 4;
+  }
+  lastFrameUs = nowUs;
+  haveLastFrame = true;
+  snap.signalPresent = true;
+  return true;
+}
+
+void DmxStats::tick(uint32_t nowUs) {
+  if (windowStartUs == 0) windowStartUs = nowUs;
+
+  // ztráta signálu – jednou za výpadek, jitter začne po návratu znovu
+  if (snap.signalPresent && haveLastFrame && nowUs - lastFrameUs >= DMX_STATS_LOSS_US) {
+    snap.signalPresent = false;
+    snap.signalLosses++;
+    haveLastFrame = false;
+    avgIntervalQ4 = 0;
+    jitterQ4 = 0;
+  }
+
+  if (nowUs - windowStartUs >= 1000000UL) {
+    snap.framesPerSec = windowFrames;
+    snap.errorsPerSec = windowErrors;
+    snap.intervalMaxUs = windowIntervalMaxUs;
+    windowFrames = 0;
+    windowErrors = 0;
+    windowIntervalMaxUs = 0;
+    windowStartUs = nowUs;
+  }
+}
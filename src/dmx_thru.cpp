@@ -0,0 +1,52 @@
+#include <string.h>
+#include "dmx_thru.h"
+
+void DmxThru::reset() {
+  merger_.release(MERGE_SRC_INPUT);
+  memset(&stats_, 0, sizeof(stats_));
+  lastInUs_ = 0;
+  present_ = false;
+  pending_ = false;
+}
+
+bool DmxThru::input(const uint8_t *slots, uint16_t len, uint32_t nowUs) {
+  if (len < 2) return false;
+  if (slots[0] != 0x00) {
+    stats_.badStartCodes++;
+    return false;
+  }
+  if (present_) stats_.frameUs = nowUs - lastInUs_;
+  merger_.setLevels(MERGE_SRC_INPUT, slots + 1, len - 1);
+  stats_.framesIn++;
+  lastInUs_ = nowUs;
+  present_ = true;
+  pending_ = true;
+  return true;
+}
+
+void DmxThru::idle(uint32_t nowUs) {
+  if (!present_ || nowUs - lastInUs_ < (uint32_t)DMX_THRU_HOLD_MS * 1000) return;
+  merger_.release(MERGE_SRC_INPUT);
+  stats_.inputLosses++;
+  stats_.frameUs = 0;
+  present_ = false;
+  pending_ = false;
+}
+
+uint16_t DmxThru::output(uint8_t *out, uint32_t nowUs) {
+  uint16_t channels = merger_.merge(out + 1);
+  if (!channels) return 0;
+  out[0] = 0x00;
+
+  if (pending_) {
+    uint32_t us = nowUs - lastInUs_;
+    stats_.lastLatencyUs = us;
+    if (us > stats_.maxLatencyUs) stats_.maxLatencyUs = us;
+    if (stats_.frameUs && us > stats_.frameUs) stats_.overTarget++;
+    pending_ = false;
+  } else {
+    stats_.framesHeld++;
+  }
+  stats_.framesOut++;
+  return channels + 1;
+}
@@ -0,0 +1,54 @@
+#include <esp_heap_caps.h>
+#include "heap_monitor.h"
+#include "log.h"
+
+static HeapSample history[HEAP_HISTORY];
+static size_t historyHead = 0;        // kam přijde další vzorek
+static size_t historyCount = 0;
+static uint32_t lastSampleMs = 0;
+static bool sampled = false;
+static volatile uint32_t failedAllocs = 0;
+
+// Volá alokátor z libovolné úlohy (i z WiFi) – jen počítá
+static void heapAllocFailed(size_t, uint32_t, const char *) {
+  failedAllocs++;
+}
+
+void heapMonitorBegin() {
+  heap_caps_register_failed_alloc_callback(heapAllocFailed);
+}
+
+HeapSample heapSampleNow(uint32_t nowMs) {
+  HeapSample s;
+  s.uptimeS = nowMs / 1000;
+  s.freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  s.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  s.minFree = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  return s;
+}
+
+void heapMonitorTick(uint32_t nowMs) {
+  // první vzorek hned po startu (výchozí stav pro porovnání)
+  if (sampled && nowMs - lastSampleMs < HEAP_SAMPLE_MS) return;
+  sampled = true;
+  lastSampleMs = nowMs;
+  HeapSample s = heapSampleNow(nowMs);
+  history[historyHead] = s;
+  historyHead = (historyHead + 1) % HEAP_HISTORY;
+  if (historyCount < HEAP_HISTORY) historyCount++;
+  LOG_I("Halda: volno %lu B, největší blok %lu B, fragmentace %u %%, minimum %lu B, selhané alokace %lu",
+        (unsigned long)s.freeBytes, (unsigned long)s.largestBlock, heapFragPct(s),
+        (unsigned long)s.minFree, (unsigned long)failedAllocs);
+}
+
+uint32_t heapFailedAllocs() {
+  return failedAllocs;
+}
+
+size_t heapHistoryCount() {
+  return historyCount;
+}
+
+HeapSample heapHistoryAt(size_t i) {
+  return history[(historyHead + HEAP_HISTORY - historyCount + i) % HEAP_HISTORY];
+}
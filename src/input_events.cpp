@@ -0,0 +1,99 @@
+#include <Arduino.h>
+#include <ESP32Encoder.h>
+#include <esp_timer.h>
+#include "input_events.h"
+
+SpscQueue<InputEvent, 16> inputQueue;
+
+static ESP32Encoder encoder;
+static esp_timer_handle_t buttonTimer;
+static esp_timer_handle_t longPressTimer;
+static esp_timer_handle_t encoderTimer;
+static TaskHandle_t notifyTask = NULL;
+
+// stav drží jen callbacky esp_timer (jedna úloha) – není potřeba zamykat
+static bool buttonDown = false;
+static bool longPressFired = false;
+static int64_t lastCount = 0;
+
+static void postInput(InputEventType type, int16_t delta) {
+  InputEvent evt = { type, delta, (uint32_t)millis() };
+  if (inputQueue.push(evt) && notifyTask) {
+    xTaskNotifyGive(notifyTask);
+  }
+}
+
+//
+// Přerušení – jen (pře)natáhnou časovač, veškerá logika běží mimo ISR
+//
+static void IRAM_ATTR onButtonEdge() {
+  esp_timer_stop(buttonTimer);
+  esp_timer_start_once(buttonTimer, INPUT_DEBOUNCE_US);
+}
+
+static void IRAM_ATTR onEncoderEdge() {
+  esp_timer_stop(encoderTimer);
+  esp_timer_start_once(encoderTimer, INPUT_ENCODER_SETTLE_US);
+}
+
+//
+// Callbacky esp_timer
+//
+static void onButtonSettled(void *) {
+  bool down = (digitalRead(ENCODER_BTN_PIN) == LOW);
+  if (down == buttonDown) return;   // zákmit, stav se nakonec nezměnil
+  buttonDown = down;
+  if (down) {
+    longPressFired = false;
+    esp_timer_start_once(longPressTimer, INPUT_LONG_PRESS_US);
+  } else {
+    esp_timer_stop(longPressTimer);
+    if (!longPressFired) postInput(INPUT_PRESS, 0);
+  }
+}
+
+static void onLongPress(void *) {
+  if (!buttonDown) return;
+  longPressFired = true;
+  postInput(INPUT_LONG_PRESS, 0);
+}
+
+static void onEncoderSettled(void *) {
+  int64_t count = encoder.getCount();
+  int64_t delta = count - lastCount;
+  if (delta == 0) return;
+  lastCount = count;
+  postInput(INPUT_ROTATE, (int16_t)constrain(delta, (int64_t)-32768, (int64_t)32767));
+}
+
+void inputBegin() {
+  encoder.attachHalfQuad(ENCODER_PIN_A, ENCODER_PIN_B);
+  encoder.setCount(0);
+  lastCount = 0;
+  pinMode(ENCODER_BTN_PIN, INPUT_PULLUP);
+  buttonDown = (digitalRead(ENCODER_BTN_PIN) == LOW);
+
+  esp_timer_create_args_t args = {};
+  args.dispatch_method = ESP_TIMER_TASK;
+
+  args.callback = onButtonSettled;
+  args.name = "btn";
+  esp_timer_create(&args, &buttonTimer);
+
+  args.callback = onLongPress;
+  args.name = "btn_long";
+  esp_timer_create(&args, &longPressTimer);
+
+  args.callback = onEncoderSettled;
+  args.name = "enc";
+  esp_timer_create(&args, &encoderTimer);
+
+  // PCNT počítá dál hardwarově, GPIO přerušení jen hlásí, že se něco pohnulo
+  attachInterrupt(digitalPinToInterrupt(ENCODER_BTN_PIN), onButtonEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_A), onEncoderEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_B), onEncoderEdge, CHANGE);
+}
+
+void inputSetNotifyTask(void *task) {
+  notifyTask = (TaskHandle_t)task;
+}
@@ -0,0 +1,293 @@
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ir_import.h"
+
+// Pronto: jednotka nosné = slovo frekvence × 0,241246 µs
+#define PRONTO_CLOCK_US 0.241246f
+
+// ========================
+// NEC z časování (tolerance ~25 %, hlavička 9 ms i 4,5 ms jako Samsung)
+// ========================
+void NecTimingDecoder::reset() {
+  state_ = HDR_MARK;
+  bits_ = 0;
+  code_ = 0;
+}
+
+bool NecTimingDecoder::push(uint32_t us) {
+  switch (state_) {
+    case HDR_MARK:
+      state_ = (us >= 3000 && us <= 10500) ? HDR_SPACE : FAILED;
+      break;
+    case HDR_SPACE:
+      // 2,25 ms = NEC repeat, žádná data
+      state_ = (us >= 3500 && us <= 5500) ? BIT_MARK : FAILED;
+      break;
+    case BIT_MARK:
+      state_ = (us >= 300 && us <= 850) ? BIT_SPACE : FAILED;
+      break;
+    case BIT_SPACE:
+      if (us >= 300 && us <= 850) code_ <<= 1;
+      else if (us >= 1200 && us <= 2100) code_ = (code_ << 1) | 1;
+      else { state_ = FAILED; break; }
+      state_ = (++bits_ == 32) ? DONE : BIT_MARK;
+      break;
+    case DONE:
+      break;
+    case FAILED:
+      return false;
+  }
+  return state_ != FAILED;
+}
+
+// ========================
+// Tokeny a řádky
+// ========================
+static bool isHexWord(const char *tok) {
+  if (strlen(tok) != 4) return false;
+  for (int i = 0; i < 4; i++) {
+    char c = tok[i];
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) return false;
+  }
+  return true;
+}
+
+static bool parseNumber(const char *tok, int base, uint64_t &out) {
+  char *end;
+  out = strtoull(tok, &end, base);
+  return end != tok && *end == '\0';
+}
+
+IrImportParser::IrImportParser(IrImportSink sink, void *ctx)
+    : sink_(sink), ctx_(ctx), tokLen_(0), tokOverflow_(false), comment_(false), tokIndex_(0),
+      lineBad_(false), words_(0), prontoType_(0), periodUs_(0), onceWords_(0),
+      section_(LIRC_NONE), bits_(0), preBits_(0), postBits_(0), pre_(0), post_(0),
+      encodingOk_(true), rawPending_(false) {
+  memset(&stats_, 0, sizeof(stats_));
+  name_[0] = '\0';
+  lineFirst_[0] = '\0';
+  remote_[0] = '\0';
+}
+
+void IrImportParser::feed(const char *data, size_t len) {
+  stats_.bytes += len;
+  for (size_t i = 0; i < len; i++) {
+    char c = data[i];
+    if (c == '\n') {
+      endToken();
+      endLine();
+      continue;
+    }
+    if (comment_) continue;
+    if (c == ' ' || c == '\t' || c == '\r') {
+      endToken();
+    } else if (c == '#' && tokLen_ == 0) {
+      comment_ = true;      // LIRC komentář do konce řádku
+    } else if (tokLen_ < IR_IMPORT_TOKEN - 1) {
+      tok_[tokLen_++] = c;
+    } else {
+      tokOverflow_ = true;
+    }
+  }
+}
+
+void IrImportParser::finish() {
+  endToken();
+  if (tokIndex_ || lineBad_ || words_) endLine();
+  if (stats_.format == IR_IMPORT_LIRC) lircRawFinish();
+}
+
+void IrImportParser::endToken() {
+  if (tokOverflow_) {
+    if (!lineBad_) stats_.errors++;
+    lineBad_ = true;
+  } else if (tokLen_) {
+    tok_[tokLen_] = '\0';
+    token(tok_);
+  }
+  tokLen_ = 0;
+  tokOverflow_ = false;
+}
+
+void IrImportParser::token(const char *tok) {
+  if (stats_.format == IR_IMPORT_UNKNOWN) {
+    stats_.format = strcmp(tok, "begin") == 0 ? IR_IMPORT_LIRC : IR_IMPORT_PRONTO;
+  }
+  if (lineBad_) return;
+  if (stats_.format == IR_IMPORT_PRONTO) prontoToken(tok);
+  else lircToken(tok);
+  tokIndex_++;
+}
+
+void IrImportParser::endLine() {
+  stats_.lines++;
+  if (stats_.format == IR_IMPORT_PRONTO) prontoEndLine();
+  comment_ = false;
+  tokIndex_ = 0;
+  lineBad_ = false;
+  lineFirst_[0] = '\0';
+}
+
+void IrImportParser::setName(const char *prefix, const char *name) {
+  if (prefix[0]) snprintf(name_, sizeof(name_), "%s %s", prefix, name);
+  else snprintf(name_, sizeof(name_), "%s", name);
+}
+
+void IrImportParser::emit(uint32_t code) {
+  stats_.converted++;
+  if (sink_) sink_(name_, code, ctx_);
+}
+
+// ========================
+// Pronto: [jméno[:]] 0000 FFFF n1 n2 trvání...
+// ========================
+void IrImportParser::prontoToken(const char *tok) {
+  if (!words_ && !isHexWord(tok)) {
+    // slova před prvním hex slovem jsou jméno příkazu
+    size_t len = strlen(name_);
+    if (len && len < sizeof(name_) - 1) name_[len++] = ' ';
+    snprintf(name_ + len, sizeof(name_) - len, "%s", tok);
+    len = strlen(name_);
+    while (len && (name_[len - 1] == ':' || name_[len - 1] == '=')) name_[--len] = '\0';
+    return;
+  }
+  if (!isHexWord(tok)) {
+    stats_.errors++;
+    lineBad_ = true;
+    return;
+  }
+  uint16_t w = (uint16_t)strtoul(tok, NULL, 16);
+  switch (words_) {
+    case 0:
+      prontoType_ = w;
+      nec_.reset();
+      break;
+    case 1:
+      periodUs_ = w * PRONTO_CLOCK_US;
+      break;
+    case 2:
+      onceWords_ = w * 2;
+      break;
+    case 3:
+      if (!onceWords_) onceWords_ = w * 2;   // jen opakovací sekvence
+      break;
+    default:
+      // modulovaný (0000) i nemodulovaný (0100) naučený kód; jen první sekvence
+      if ((prontoType_ == 0x0000 || prontoType_ == 0x0100) && periodUs_ > 0 && words_ - 4 < onceWords_) {
+        nec_.push((uint32_t)(w * periodUs_ + 0.5f));
+      }
+      break;
+  }
+  words_++;
+}
+
+void IrImportParser::prontoEndLine() {
+  if (words_ && !lineBad_) {
+    stats_.commands++;
+    if (!name_[0]) snprintf(name_, sizeof(name_), "Pronto %u", stats_.commands);
+    if ((prontoType_ == 0x0000 || prontoType_ == 0x0100) && nec_.done()) emit(nec_.code());
+    else stats_.unsupported++;
+  }
+  words_ = 0;
+  name_[0] = '\0';
+}
+
+// ========================
+// LIRC: begin remote / parametry / begin codes | begin raw_codes / end ...
+// ========================
+void IrImportParser::lircToken(const char *tok) {
+  if (tokIndex_ == 0) {
+    snprintf(lineFirst_, sizeof(lineFirst_), "%s", tok);
+    if (section_ == LIRC_CODES && strcmp(tok, "end") != 0) {
+      setName(remote_, tok);
+    } else if (section_ == LIRC_RAW && strcmp(tok, "end") != 0 && strcmp(tok, "name") != 0) {
+      uint64_t us;
+      if (!parseNumber(tok, 10, us)) { stats_.errors++; lineBad_ = true; return; }
+      if (rawPending_) nec_.push((uint32_t)us);
+    }
+    return;
+  }
+
+  if (strcmp(lineFirst_, "begin") == 0 && tokIndex_ == 1) {
+    if (strcmp(tok, "remote") == 0) {
+      section_ = LIRC_REMOTE;
+      remote_[0] = '\0';
+      bits_ = preBits_ = postBits_ = 0;
+      pre_ = post_ = 0;
+      encodingOk_ = true;
+    } else if (strcmp(tok, "codes") == 0) {
+      section_ = LIRC_CODES;
+    } else if (strcmp(tok, "raw_codes") == 0) {
+      section_ = LIRC_RAW;
+      rawPending_ = false;
+    }
+    return;
+  }
+  if (strcmp(lineFirst_, "end") == 0 && tokIndex_ == 1) {
+    if (strcmp(tok, "raw_codes") == 0) lircRawFinish();
+    section_ = (strcmp(tok, "remote") == 0) ? LIRC_NONE : LIRC_REMOTE;
+    return;
+  }
+
+  uint64_t v;
+  switch (section_) {
+    case LIRC_REMOTE:
+      if (tokIndex_ != 1) break;
+      if (strcmp(lineFirst_, "name") == 0) {
+        snprintf(remote_, sizeof(remote_), "%s", tok);
+      } else if (strcmp(lineFirst_, "flags") == 0) {
+        encodingOk_ = !strstr(tok, "RC5") && !strstr(tok, "RC6") && !strstr(tok, "SHIFT_ENC") &&
+                      !strstr(tok, "RCMM") && !strstr(tok, "XMP") && !strstr(tok, "BO");
+      } else if (!strcmp(lineFirst_, "bits") || !strcmp(lineFirst_, "pre_data_bits") ||
+                 !strcmp(lineFirst_, "post_data_bits") || !strcmp(lineFirst_, "pre_data") ||
+                 !strcmp(lineFirst_, "post_data")) {
+        if (!parseNumber(tok, 0, v)) { stats_.errors++; lineBad_ = true; break; }
+        if (!strcmp(lineFirst_, "bits")) bits_ = (uint8_t)v;
+        else if (!strcmp(lineFirst_, "pre_data_bits")) preBits_ = (uint8_t)v;
+        else if (!strcmp(lineFirst_, "post_data_bits")) postBits_ = (uint8_t)v;
+        else if (!strcmp(lineFirst_, "pre_data")) pre_ = v;
+        else post_ = v;
+      }
+      break;
+    case LIRC_CODES:
+      // další kódy na řádku (toggle) se ignorují
+      if (tokIndex_ != 1) break;
+      if (!parseNumber(tok, 0, v)) { stats_.errors++; lineBad_ = true; break; }
+      lircCode(v);
+      break;
+    case LIRC_RAW:
+      if (strcmp(lineFirst_, "name") == 0) {
+        if (tokIndex_ != 1) break;
+        lircRawFinish();
+        setName(remote_, tok);
+        nec_.reset();
+        rawPending_ = true;
+      } else {
+        if (!parseNumber(tok, 10, v)) { stats_.errors++; lineBad_ = true; break; }
+        if (rawPending_) nec_.push((uint32_t)v);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void IrImportParser::lircCode(uint64_t value) {
+  stats_.commands++;
+  if (!encodingOk_ || !bits_ || preBits_ + bits_ + postBits_ != 32) {
+    stats_.unsupported++;
+    return;
+  }
+  uint64_t code = ((pre_ << bits_) | (value & ((1ULL << bits_) - 1))) << postBits_;
+  code |= post_ & ((1ULL << postBits_) - 1);
+  emit((uint32_t)code);
+}
+
+void IrImportParser::lircRawFinish() {
+  if (!rawPending_) return;
+  rawPending_ = false;
+  stats_.commands++;
+  if (nec_.done()) emit(nec_.code());
+  else stats_.unsupported++;
+}
@@ -0,0 +1,162 @@
+#include <string.h>
+#include "ir_nudge.h"
+
+// NEC repeat chodí po ~108 ms: rampa se dopočítá nejdál periodu za poslední
+// repeat, takže po puštění tlačítka nepřejede o celé NUDGE_HOLD_MS
+#define NUDGE_REPEAT_MS 110
+
+void nudgeDefaults(NudgeConfig &cfg) {
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.step = 8;
+  cfg.rampStart = 40;
+  cfg.rampMax = 255;
+  cfg.accelMs = 1500;
+}
+
+NudgeEngine::NudgeEngine() {
+  nudgeDefaults(cfg_);
+  memset(base_, 0, sizeof(base_));
+  baseCount_ = 0;
+  reset();
+}
+
+void NudgeEngine::setConfig(const NudgeConfig &cfg) {
+  cfg_ = cfg;
+  held_ = -1;
+}
+
+void NudgeEngine::reset() {
+  clearOffsets();
+  master_ = 255;
+  held_ = -1;
+  ramping_ = false;
+}
+
+void NudgeEngine::clearOffsets() {
+  memset(offset_, 0, sizeof(offset_));
+  extent_ = 0;
+}
+
+static int nudgeSign(NudgeKind kind) {
+  return (kind == NUDGE_DOWN || kind == NUDGE_MASTER_DOWN) ? -1 : 1;
+}
+
+bool NudgeEngine::input(uint32_t code, bool repeat, uint32_t nowMs) {
+  if (!code) return false;
+  int idx = -1;
+  for (int i = 0; i < NUDGE_ACTIONS; i++) {
+    if (cfg_.actions[i].code == code && cfg_.actions[i].kind != NUDGE_NONE) {
+      idx = i;
+      break;
+    }
+  }
+  if (idx < 0) return false;
+  const NudgeAction &a = cfg_.actions[idx];
+
+  if (!repeat) {
+    // stisk: jeden krok hned, rampa až s prvním repeat (krátký stisk = jen krok)
+    adjust(a, nudgeSign(a.kind) * cfg_.step);
+    held_ = a.kind == NUDGE_RESET ? -1 : idx;
+    ramping_ = false;
+    lastRepeatMs_ = nowMs;
+    return true;
+  }
+  // repeat bez zachyceného stisku (držené už při vstupu do režimu) rampu taky spustí
+  if (a.kind == NUDGE_RESET) return true;
+  if (held_ != idx) {
+    held_ = idx;
+    ramping_ = false;
+  }
+  lastRepeatMs_ = nowMs;
+  if (!ramping_) {
+    ramping_ = true;
+    holdStartMs_ = nowMs;
+    lastTickMs_ = nowMs;
+    accum_ = 0;
+  }
+  return true;
+}
+
+void NudgeEngine::tick(uint32_t nowMs) {
+  if (held_ < 0) return;
+  if (nowMs - lastRepeatMs_ > NUDGE_HOLD_MS) {
+    held_ = -1;
+    ramping_ = false;
+    return;
+  }
+  if (!ramping_) return;
+
+  uint32_t until = nowMs - lastRepeatMs_ > NUDGE_REPEAT_MS ? lastRepeatMs_ + NUDGE_REPEAT_MS : nowMs;
+  if ((int32_t)(until - lastTickMs_) <= 0) return;
+  uint32_t dt = until - lastTickMs_;
+  lastTickMs_ = until;
+
+  uint32_t heldMs = until - holdStartMs_;
+  int32_t rate = cfg_.rampMax;
+  if (cfg_.accelMs && heldMs < cfg_.accelMs) {
+    rate = cfg_.rampStart + ((int32_t)cfg_.rampMax - cfg_.rampStart) * (int32_t)heldMs / cfg_.accelMs;
+  }
+  if (rate <= 0) return;
+  accum_ += (uint32_t)rate * dt;
+  uint32_t whole = accum_ / 1000;
+  if (!whole) return;
+  accum_ -= whole * 1000;
+  const NudgeAction &a = cfg_.actions[held_];
+  adjust(a, nudgeSign(a.kind) * (int)(whole > 255 ? 255 : whole));
+}
+
+void NudgeEngine::adjust(const NudgeAction &a, int delta) {
+  switch (a.kind) {
+    case NUDGE_MASTER_UP:
+    case NUDGE_MASTER_DOWN: {
+      int m = master_ + delta;
+      master_ = m < 0 ? 0 : (m > 255 ? 255 : m);
+      return;
+    }
+    case NUDGE_RESET:
+      clearOffsets();
+      master_ = 255;
+      return;
+    case NUDGE_UP:
+    case NUDGE_DOWN:
+      break;
+    default:
+      return;
+  }
+  if (a.group >= NUDGE_GROUPS) return;
+  const uint8_t *bits = cfg_.groups[a.group];
+  for (int i = 0; i < NUDGE_CHANNELS / 8; i++) {
+    for (uint8_t b = bits[i]; b; b &= b - 1) {
+      int ch = i * 8 + __builtin_ctz(b);
+      // výsledek kanálu drží v 0..255 vůči poslední sloučené hodnotě
+      int base = ch < baseCount_ ? base_[ch] : 0;
+      int off = offset_[ch] + delta;
+      if (off < -base) off = -base;
+      if (off > 255 - base) off = 255 - base;
+      offset_[ch] = off;
+      if (off && ch + 1 > extent_) extent_ = ch + 1;
+    }
+  }
+}
+
+uint16_t NudgeEngine::apply(uint8_t *out, uint16_t count) {
+  if (count > NUDGE_CHANNELS) count = NUDGE_CHANNELS;
+  memcpy(base_, out, count);
+  baseCount_ = count;
+  if (!active()) return count;
+
+  uint16_t n = count > extent_ ? count : extent_;
+  uint16_t scale = master_ + 1;    // 256 = beze změny
+  for (uint16_t ch = 0; ch < n; ch++) {
+    int v = (ch < count ? out[ch] : 0) + offset_[ch];
+    v = v < 0 ? 0 : (v > 255 ? 255 : v);
+    out[ch] = (uint8_t)((v * scale) >> 8);
+  }
+  return n;
+}
+
+uint16_t NudgeEngine::nudgedChannels() const {
+  uint16_t n = 0;
+  for (uint16_t ch = 0; ch < extent_; ch++) n += offset_[ch] != 0;
+  return n;
+}
@@ -0,0 +1,81 @@
+#include <Arduino.h>
+#include <IRrecv.h>
+#include <IRremoteESP8266.h>
+#include "ir_receiver.h"
+#include "signal_task.h"
+#include "trace.h"
+
+// repeat bez předchozího kódu (nebo po delší pauze) se nikomu nepřiřadí
+#define IR_REPEAT_WINDOW_US 250000
+
+SpscQueue<IrEvent, IR_EVENT_QUEUE> irEvents;
+
+// save_buffer = true: decode() si zachycená data zkopíruje a přijímač hned pokračuje
+static IRrecv irrecv(IR_RECV_PIN, IR_RECV_BUFFER, IR_RECV_TIMEOUT_MS, true);
+static decode_results results;
+static IrRxStats rxStats = {};
+
+static int16_t  lastProtocol = UNKNOWN;
+static uint32_t lastCode = 0;
+static uint32_t lastUs = 0;
+
+bool irReceiverPoll() {
+  if (!irrecv.decode(&results)) return false;
+  uint32_t now = micros();
+  if (results.overflow) rxStats.overflows++;
+  if (results.decode_type == UNKNOWN) {
+    rxStats.unknown++;
+    return true;
+  }
+
+  IrEvent ev;
+  ev.timeUs = now;
+  ev.protocol = (int16_t)results.decode_type;
+  ev.bits = (uint8_t)results.bits;
+  ev.repeat = results.repeat;
+  if (ev.repeat) {
+    rxStats.repeats++;
+    bool sameKey = ev.protocol == lastProtocol && now - lastUs < IR_REPEAT_WINDOW_US;
+    ev.code = sameKey ? lastCode : 0;
+  } else {
+    rxStats.decoded++;
+    ev.code = (uint32_t)results.value;
+    lastProtocol = ev.protocol;
+    lastCode = ev.code;
+  }
+  lastUs = now;
+  irEvents.push(ev);   // plná fronta = irEvents.dropped()
+  traceRecord(TRACE_IR_DECODE, TRACE_INSTANT, (uint16_t)ev.code);
+  return true;
+}
+
+static void irTask(void *) {
+  for (;;) {
+    if (!irReceiverPoll()) vTaskDelay(1);
+  }
+}
+
+void irReceiverBegin() {
+  irrecv.setUnknownThreshold(IR_RECV_MIN_UNKNOWN);
+  irrecv.enableIRIn();
+  // nad signálovou úlohou – decode() je krátký a při prázdném záchytu hned spí
+  xTaskCreatePinnedToCore(irTask, "ir", 4096, NULL, SIGNAL_TASK_PRIORITY + 1, NULL, SIGNAL_TASK_CORE);
+}
+
+bool irReceiverPop(IrEvent &ev) {
+  if (!irEvents.pop(ev)) return false;
+  uint32_t us = micros() - ev.timeUs;
+  rxStats.lastLatencyUs = us;
+  if (us > rxStats.maxLatencyUs) rxStats.maxLatencyUs = us;
+  traceRecord(TRACE_IR_POP, TRACE_INSTANT, us > 0xFFFF ? 0xFFFF : (uint16_t)us);
+  return true;
+}
+
+void irReceiverFlush() {
+  IrEvent ev;
+  while (irEvents.pop(ev)) {}
+}
+
+const IrRxStats &irRxStats() {
+  return rxStats;
+}
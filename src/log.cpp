@@ -0,0 +1,97 @@
+#include <Arduino.h>
+#include <atomic>
+#include <stdarg.h>
+#include "log.h"
+
+static_assert((LOG_SLOTS & (LOG_SLOTS - 1)) == 0, "LOG_SLOTS musí být mocnina 2");
+
+// Omezená fronta pro více producentů (Vyukov): slot nese číslo kola, podle
+// kterého producent pozná volný slot a konzument hotový řádek. Ukládá se
+// jako pozice bez indexu slotu (pos & ~maska), takže stačí nulová inicializace:
+//   base      = volný pro zápis na pozici pos
+//   base + 1  = zapsaný, čeká na výpis
+//   base + N  = vypsaný, volný pro další kolo
+struct LogSlot {
+  std::atomic<uint32_t> seq;
+  uint8_t len;
+  char    text[LOG_LINE];
+};
+
+static LogSlot slots[LOG_SLOTS];
+static std::atomic<uint32_t> enqueuePos(0);
+static uint32_t dequeuePos = 0;            // jen úloha "log"
+static LogStats stats = {};
+
+volatile uint8_t logRuntimeLevel = LOG_LEVEL < LOG_LEVEL_INFO ? LOG_LEVEL : LOG_LEVEL_INFO;
+
+static const char levelChar[] = { '-', 'E', 'W', 'I', 'D' };
+
+void logWrite(uint8_t level, const char *fmt, ...) {
+  uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+  LogSlot *slot;
+  for (;;) {
+    slot = &slots[pos & (LOG_SLOTS - 1)];
+    uint32_t base = pos & ~(uint32_t)(LOG_SLOTS - 1);
+    int32_t dif = (int32_t)(slot->seq.load(std::memory_order_acquire) - base);
+    if (dif == 0) {
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (dif < 0) {
+      // slot z minulého kola ještě nebyl vypsán – plno
+      __atomic_fetch_add(&stats.dropped, 1, __ATOMIC_RELAXED);
+      return;
+    } else {
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t ms = millis();
+  int n = snprintf(slot->text, LOG_LINE, "%5lu.%03lu %c ", (unsigned long)(ms / 1000),
+                   (unsigned long)(ms % 1000), levelChar[level <= LOG_LEVEL_DEBUG ? level : 0]);
+  va_list args;
+  va_start(args, fmt);
+  int body = vsnprintf(slot->text + n, LOG_LINE - n - 1, fmt, args);
+  va_end(args);
+  int len = n + (body < 0 ? 0 : body);
+  if (len > LOG_LINE - 2) {
+    len = LOG_LINE - 2;
+    __atomic_fetch_add(&stats.truncated, 1, __ATOMIC_RELAXED);
+  }
+  slot->text[len++] = '\n';
+  slot->len = len;
+  __atomic_fetch_add(&stats.written, 1, __ATOMIC_RELAXED);
+  slot->seq.store((pos & ~(uint32_t)(LOG_SLOTS - 1)) + 1, std::memory_order_release);
+}
+
+// Jeden řádek z fronty na Serial; false = fronta prázdná
+static bool drainOne() {
+  LogSlot &slot = slots[dequeuePos & (LOG_SLOTS - 1)];
+  uint32_t base = dequeuePos & ~(uint32_t)(LOG_SLOTS - 1);
+  if (slot.seq.load(std::memory_order_acquire) != base + 1) return false;
+  Serial.write((const uint8_t *)slot.text, slot.len);
+  slot.seq.store(base + LOG_SLOTS, std::memory_order_release);
+  dequeuePos++;
+  return true;
+}
+
+static void logTask(void *) {
+  for (;;) {
+    while (drainOne()) {}
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
+  }
+}
+
+void logBegin() {
+  xTaskCreatePinnedToCore(logTask, "log", 2048, NULL, LOG_TASK_PRIORITY, NULL, LOG_TASK_CORE);
+}
+
+void logFlush(uint32_t timeoutMs) {
+  uint32_t start = millis();
+  while (millis() - start < timeoutMs && dequeuePos != enqueuePos.load(std::memory_order_acquire)) {
+    delay(1);
+  }
+  Serial.flush();
+}
+
+const LogStats &logStats() {
+  return stats;
+}
@@ -1,24 +1,28 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Adafruit_GFX.h>
-#include <Adafruit_SH1106.h>
-#include <esp_dmx.h>
-#include <IRrecv.h>
+#include "sh1106_async.h"
 #include <IRremoteESP8266.h>
 #include <WiFi.h>
-#include <ESP32Encoder.h>
-#include <IRsend.h>
 #include <Preferences.h>
-#include <driver/uart.h>  // kvůli uart_driver_delete()
-
-#ifndef dmx_driver_uninstall
-static inline void dmx_driver_uninstall(dmx_port_t port) {
-  uart_driver_delete(port);
-}
-#endif
-
-// Pin pro ovládání MAX485 (DE/RE)
-#define MAX485_CTRL_PIN 32
+#include "dmx_stats.h"
+#include "signal_task.h"
+#include "frame_store.h"
+#include "input_events.h"
+#include "ui_widgets.h"
+#include "show_recorder.h"
+#include "config_blob.h"
+#include "boot_timing.h"
+#include "ir_receiver.h"
+#include "scene_bank.h"
+#include "web_assets.h"
+#include "trace.h"
+#include "ir_import.h"
+#include "log.h"
+#include "serial_proto.h"
+#include "req_arena.h"
+#include "heap_monitor.h"
+#include <LittleFS.h>
 
 // ========================
 // WiFi nastavení
@@ -29,36 +33,45 @@ const char* password = "999999999";
 WiFiServer server(80);
 
 // ========================
-// Displej – Adafruit_SH1106
+// Displej – SH1106, framebuffer se posílá asynchronně (sh1106_async.h)
 // ========================
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 #define OLED_RESET   -1
 #define SCREEN_ADDRESS 0x3C
-Adafruit_SH1106 display(OLED_RESET);
+SH1106Async display(OLED_RESET);
 
-// ========================
-// DMX nastavení – využíváme UART1 (DMX_NUM_1 z esp_dmx)
-// DMX kanály 1 až 6 jsou uloženy v data[1] až data[6]
-#define ENABLE_PIN 13 //nezapojený pin, pouze jako dummy
-dmx_port_t dmxPort = DMX_NUM_1;
-uint8_t data[DMX_PACKET_SIZE];
+// Obrazovky – retained widgety, překreslí se jen to, co se změnilo
+UiScreen *activeScreen = NULL;
 
-// ========================
-// IR přijímač – používá pin 16 (RMT)
-IRrecv irrecv(16);
-decode_results results;
+UiScreen menuScreen;
+UiLabel  menuTitle(0, 0, UI_MAX_COLS);
+UiList   menuList(0, 8, 7);
 
-// ========================
-// IR vysílač – využívá pin 17 (IR LED)
-IRsend irsend(17);
+UiScreen dmxScreen;
+UiLabel  dmxTitle(0, 0, UI_MAX_COLS);
+UiValue  dmxLevel[6] = {
+  UiValue(0,  8, "CH1:", 3), UiValue(0, 16, "CH2:", 3), UiValue(0, 24, "CH3:", 3),
+  UiValue(0, 32, "CH4:", 3), UiValue(0, 40, "CH5:", 3), UiValue(0, 48, "CH6:", 3)
+};
+UiLabel  dmxCode[6] = {
+  UiLabel(54,  8, 8), UiLabel(54, 16, 8), UiLabel(54, 24, 8),
+  UiLabel(54, 32, 8), UiLabel(54, 40, 8), UiLabel(54, 48, 8)
+};
+UiLabel  dmxStatus(0, 56, UI_MAX_COLS);
 
-// ========================
-// ENKODÉR – KY-040: CLK na GPIO27, DT na GPIO26, SW na GPIO25
-#define ENCODER_PIN_A 27
-#define ENCODER_PIN_B 26
-#define ENCODER_BTN_PIN 25
-ESP32Encoder encoder;
+UiScreen irDmxScreen;
+UiLabel  irDmxTitle(0, 0, 10, 2);
+UiLabel  irDmxWaiting(0, 24, UI_MAX_COLS);
+UiLabel  irDmxScene(0, 40, UI_MAX_COLS);
+
+UiScreen learnScreen;
+UiLabel  learnTitle(0, 0, UI_MAX_COLS);
+UiLabel  learnLine(0, 10, UI_MAX_COLS);
+UiLabel  learnProtoLabel(0, 16, 10);
+UiLabel  learnProto(70, 16, 9);
+UiLabel  learnCodeLabel(0, 24, 10);
+UiLabel  learnCode(70, 24, 9);
 
 // ========================
 // Aplikační režimy a stav menu
@@ -67,301 +80,467 @@ enum AppMode {
   MODE_MENU,
   MODE_DMX_TO_IR,
   MODE_IR_TO_DMX,
-  MODE_IR_LEARN
+  MODE_IR_LEARN,
+  MODE_DMX_THRU      // jen s druhým DMX portem (DMX_THRU_ENABLED)
 };
+
+// Hlavní menu: DMX Thru je poslední položka, ostatní indexy zůstávají
+#if DMX_THRU_ENABLED
+#define MAIN_MENU_ITEMS 5
+#else
+#define MAIN_MENU_ITEMS 4
+#endif
+
+// Režimy, které řídí signálová úloha a obnovují se po startu
+bool isSignalMode(int m) {
+  return m == MODE_DMX_TO_IR || m == MODE_IR_TO_DMX || (DMX_THRU_ENABLED && m == MODE_DMX_THRU);
+}
+
+SignalMode signalModeFor(int m) {
+  if (m == MODE_DMX_TO_IR) return SIG_DMX_TO_IR;
+  if (m == MODE_IR_TO_DMX) return SIG_IR_TO_DMX;
+  return SIG_DMX_THRU;
+}
 volatile AppMode activeMode = MODE_MENU;
 
 bool menuMode = true;       // Menu aktivní, dokud není volba potvrzena
 int menuLevel = 0;          // 0 = hlavní menu, 1 = Settings, 2 = IR Learn submenu, 3 = IR Learn mode
-int menuIndexMain = 0;      // Hlavní menu: položky 0: DMX to IR, 1: IR to DMX, 2: IR Learn, 3: Settings
+int menuIndexMain = 0;      // Hlavní menu: položky 0: DMX to IR, 1: IR to DMX, 2: IR Learn, 3: Settings, 4: DMX Thru
 int menuIndexSettings = 0;  // Settings: 0: WiFi AP, 1: Exit
 int menuIndexIRLearn = 0;   // IR Learn submenu: položky 0 až 5 (odpovídají pozicím 1 až 6), 6 = Exit
 bool wifiAPEnabled = true;
+volatile bool wifiReady = false;   // AP a server běží (startují asynchronně po setup())
+
+// Režim obnovený po startu (NVS klíč "mode") – po výpadku napájení se převodník
+// vrátí do DMX→IR / IR→DMX bez obsluhy; MODE_MENU = start v menu
+AppMode bootMode = MODE_MENU;
 
 // Pole pro uložené IR kódy pro DMX kanály (index 1 až 6)
 // Používá se pro manuální zadání a metodu "learned" – u metody "library" se kód dopočítá
 uint32_t learnedIRCodes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 
-// Uložené DMX scény: 6 scén × 64 kanálů (0–255)
+// Uložené DMX scény: 6 scén × 64 kanálů (0–255) – kopie pro web a zálohu;
+// výstup s bankou scén tuhle kopii nepoužívá, čte přímo z flash (scene_bank.h)
 uint8_t scenes[6][64] = { {0} };
 
 // Globální proměnná pro pozici, do které se má uložit kód při IR Learn (nastavena z submenu)
 int irLearnPos = 0;
 
 unsigned long irLearnStartTime = 0;
-unsigned long lastButtonTime = 0;
-const unsigned long debounceDelay = 200; // 200 ms debounce
-
-// pro nový DMX→IR režim
-static bool  dmxToIrFirstEntry = true;
-static uint8_t dmxPrev[7] = {0};         // 1..6, drží předchozí hodnotu (<255 nebo ==255)
-static unsigned long lastDmxPoll = 0;    // čas posledního snímku
-
-static uint32_t lastIrSent[7] = {0};     //pamatujee si poslední odeslaný IR kód pro každý kanál
 
-static bool dmxInstalled = false;
+// pro DMX→IR režim – poslední snímek statistik a odeslané IR kódy ze signálové úlohy
+DmxStatsSnapshot uiDmxStats = {};
+uint32_t uiIrSent[7] = {0};
+unsigned long lastDmxViewDraw = 0;
 
 // pro IR→DMX režim
-bool  irToDmxFirstEntry = true;
 int   irToDmxLastScene  = -1;
 
-// Pro relativní indexaci – uložíme baseline hodnotu enkodéru při vstupu do menu
-long menuBaseline = 0;
+// Cue list, chase a IR kódy GO/BACK/PAUSE (kopie pro web a NVS, signálová úloha má vlastní)
+CueList  cueList = {};
+Chase    chase   = { 0, {0}, 120, 0 };
+CueMode  cueMode = CUE_MODE_OFF;
+uint32_t cueIrCodes[3] = {0, 0, 0};
+uint32_t lastLearnedCode = 0;   // nápověda na stránce /cues
+
+// Knihovna importovaných IR kódů (Pronto / LIRC, ir_import.h) – vlastní klíč
+// "irlib" v NVS, kanály si z ní kód vybírají na stránce IR kódů
+#define IR_LIB_MAX 64
+struct IrLibEntry {
+  char     name[IR_IMPORT_NAME];
+  uint32_t code;
+};
+IrLibEntry irLibrary[IR_LIB_MAX];
+uint8_t irLibraryCount = 0;
+
+// Výsledek posledního importu (stránka /irimport)
+struct IrImportResult {
+  IrImportStats stats;
+  uint16_t added;
+  uint16_t updated;       // stejné jméno – kód přepsán
+  uint16_t dropped;       // knihovna plná
+  uint32_t totalMs;       // celé nahrání včetně sítě
+  uint32_t parseUs;       // jen parser
+};
+IrImportResult lastIrImport = {};
+
+// Slučování zdrojů v IR→DMX – priority, LTP kanály a živé přepsání z webu
+uint8_t mergePriorities[MERGE_SOURCES] = MERGE_DEFAULT_PRIORITIES;
+uint8_t mergeLtpBits[MERGE_CHANNELS / 8] = {0};
+uint8_t webLevels[MERGE_CHANNELS] = {0};
+uint8_t webCovered[MERGE_CHANNELS / 8] = {0};
+DmxMergeBench lastMergeBench = {};
+
+// Výstupní křivky kanálů (profily a přiřazení, output_curves.h)
+CurveConfig curveConfig;
+CurveBench lastCurveBench = {};
+
+// Relativní ovládání IR ovladačem v IR→DMX (akce, skupiny kanálů, rampa – ir_nudge.h)
+NudgeConfig nudgeConfig;
+
+// Binární protokol na UART0 (serial_proto.h)
+#define SERIAL_RX_BUFFER 4096       // celý rámec s rezervou – UI úloha čte jednou za ≤ 10 ms
+SerialFrameDecoder serialRx;
+uint32_t serialTxFrames = 0;
+uint16_t serialStreamMs = 0;        // perioda SP_METRICS, 0 = vypnuto
+uint32_t serialStreamLast = 0;
+uint8_t  serialStreamSeq = 0;
+
+// Pro relativní indexaci – součet otočení enkodéru od vstupu do menu (z INPUT_ROTATE)
+long menuPos = 0;
 
 // Objekt Preferences pro perzistentní úložiště
 Preferences preferences;
 
-// Globální proměnná pro správné vyhodnocení stisku tlačítka – akce se provedou pouze při uvolnění a opětovném stisku
-bool buttonReady = false;
+//
+// Konfigurace jako jeden blob v NVS (klíč "config", formát viz config_blob.h).
+// Jeden putBytes() je v NVS atomický – výpadek napájení nechá starou, nebo novou verzi.
+//
+void configCollect(DeviceConfig &cfg) {
+  memcpy(cfg.irCodes, learnedIRCodes, sizeof(cfg.irCodes));
+  memcpy(cfg.scenes, scenes, sizeof(cfg.scenes));
+  cfg.cueList = cueList;
+  cfg.chase = chase;
+  cfg.cueMode = cueMode;
+  memcpy(cfg.cueIrCodes, cueIrCodes, sizeof(cfg.cueIrCodes));
+  memcpy(cfg.mergePriorities, mergePriorities, sizeof(cfg.mergePriorities));
+  memcpy(cfg.mergeLtpBits, mergeLtpBits, sizeof(cfg.mergeLtpBits));
+  cfg.curves = curveConfig;
+  cfg.nudge = nudgeConfig;
+}
+
+void configApply(const DeviceConfig &cfg) {
+  memcpy(learnedIRCodes, cfg.irCodes, sizeof(learnedIRCodes));
+  memcpy(scenes, cfg.scenes, sizeof(scenes));
+  cueList = cfg.cueList;
+  chase = cfg.chase;
+  cueMode = cfg.cueMode;
+  memcpy(cueIrCodes, cfg.cueIrCodes, sizeof(cueIrCodes));
+  memcpy(mergePriorities, cfg.mergePriorities, sizeof(mergePriorities));
+  memcpy(mergeLtpBits, cfg.mergeLtpBits, sizeof(mergeLtpBits));
+  curveConfig = cfg.curves;
+  nudgeConfig = cfg.nudge;
+}
+
+bool configSave() {
+  TraceScope trace(TRACE_NVS_WRITE);
+  static DeviceConfig cfg;
+  static uint8_t blob[CONFIG_MAX_SIZE];
+  configCollect(cfg);
+  size_t len = configSerialize(cfg, blob, sizeof(blob));
+  if (!len || preferences.putBytes("config", blob, len) != len) {
+    LOG_E("Uložení konfigurace selhalo");
+    return false;
+  }
+  return true;
+}
+
+// Načtení při startu; bez blobu (starší firmware) se převezmou jednotlivé klíče
+void configLoad() {
+  static DeviceConfig cfg;
+  static uint8_t blob[CONFIG_MAX_SIZE];
+  configDefaults(cfg);
+
+  size_t len = preferences.getBytesLength("config");
+  if (len && len <= sizeof(blob) && preferences.getBytes("config", blob, len) == len) {
+    ConfigError err = configParse(blob, len, cfg);
+    if (err == CONFIG_OK) {
+      configApply(cfg);
+      LOG_I("Konfigurace načtena (%u B)", (unsigned)len);
+      return;
+    }
+    LOG_W("Uložená konfigurace je vadná (%s), zkouším jednotlivé klíče", configErrorName(err));
+  }
+
+  for (int i = 1; i <= 6; i++) {
+    char key[10];
+    sprintf(key, "ircode%d", i);
+    cfg.irCodes[i] = preferences.getUInt(key, 0);
+  }
+  for (int i = 0; i < 6; i++) {
+    char key[12];
+    sprintf(key, "scene%d", i + 1);
+    preferences.getBytes(key, cfg.scenes[i], sizeof(cfg.scenes[i]));
+  }
+  configApply(cfg);
+  if (configSave()) LOG_I("Konfigurace převedena do jednoho bloku");
+}
+
+void irLibraryLoad() {
+  size_t len = preferences.getBytesLength("irlib");
+  if (!len || len > sizeof(irLibrary) || len % sizeof(IrLibEntry)) return;
+  irLibraryCount = preferences.getBytes("irlib", irLibrary, len) / sizeof(IrLibEntry);
+}
+
+// Jméno jde do HTML i JSON – bez uvozovek a značek
+void irLibrarySetName(IrLibEntry &e, const char *name) {
+  snprintf(e.name, sizeof(e.name), "%s", name);
+  for (char *c = e.name; *c; c++) {
+    if (*c == '"' || *c == '\'' || *c == '\\' || *c == '<' || *c == '>' || *c == '&') *c = '_';
+  }
+}
+
+bool irLibrarySave() {
+  TraceScope trace(TRACE_NVS_WRITE);
+  if (!irLibraryCount) {
+    preferences.remove("irlib");
+    return true;
+  }
+  size_t len = irLibraryCount * sizeof(IrLibEntry);
+  return preferences.putBytes("irlib", irLibrary, len) == len;
+}
+
+// Scény v konfiguraci (NVS) jsou hlavní zdroj – ukládají se při každé změně
+// dřív než banka. Banka, která se od nich liší (prázdná, nebo zápis po uložení
+// konfigurace selhal), se při startu přepíše; signálová úloha ještě neběží.
+void scenesFromBank() {
+  if (!sceneBankMapped()) return;
+  uint16_t count, channels;
+  const uint8_t *bank = sceneBankData(count, channels);
+  if (bank && count == SIGNAL_SCENES && channels == SIGNAL_SCENE_CH && memcmp(bank, scenes, sizeof(scenes)) == 0) return;
+  if (sceneBankWrite(&scenes[0][0], SIGNAL_SCENES, SIGNAL_SCENE_CH)) {
+    LOG_I("Scény z konfigurace zapsány do banky ve flash");
+  }
+}
+
+// Aréna HTTP požadavku (req_arena.h) – obsluhuje ji jen UI úloha
+static uint8_t reqArenaBuf[REQ_ARENA_SIZE] __attribute__((aligned(4)));
+ReqArena reqArena(reqArenaBuf, sizeof(reqArenaBuf));
 
 //
-// Pomocná funkce pro URL dekódování
+// Pomocná funkce pro URL dekódování – do dst (aspoň len + 1 B), výsledek je
+// nejvýš tak dlouhý jako vstup
 //
-String urldecode(String input) {
-  String result = "";
-  char tempChar;
-  int len = input.length();
-  for (int i = 0; i < len; i++) {
-    char c = input.charAt(i);
+char *urldecode(const char *s, size_t len, char *dst) {
+  char *out = dst;
+  for (size_t i = 0; i < len; i++) {
+    char c = s[i];
     if (c == '+') {
-      result += ' ';
-    } else if (c == '%' && i + 2 < len) {
-      String hex = input.substring(i+1, i+3);
-      tempChar = (char) strtol(hex.c_str(), NULL, 16);
-      result += tempChar;
+      c = ' ';
+    } else if (c == '%' && i + 2 < len && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+      char hex[3] = { s[i + 1], s[i + 2], 0 };
+      c = (char)strtol(hex, NULL, 16);
       i += 2;
-    } else {
-      result += c;
     }
+    *out++ = c;
+  }
+  *out = 0;
+  return dst;
+}
+
+// Hodnota parametru z query stringu dekódovaná do arény požadavku – platí do
+// konce požadavku ("" = chybí nebo se do arény nevešla)
+const char *queryValue(const char *query, const char *name) {
+  size_t nameLen = strlen(name);
+  for (const char *p = query; *p; ) {
+    const char *amp = strchr(p, '&');
+    if (!amp) amp = p + strlen(p);
+    if ((size_t)(amp - p) > nameLen && p[nameLen] == '=' && strncmp(p, name, nameLen) == 0) {
+      size_t len = amp - p - nameLen - 1;
+      char *dst = (char *)reqArena.alloc(len + 1);
+      return dst ? urldecode(p + nameLen + 1, len, dst) : "";
+    }
+    p = *amp ? amp + 1 : amp;
+  }
+  return "";
+}
+
+// Parametr je přítomný a rovná se value (zaškrtávátka, tlačítka "=1")
+bool queryIs(const char *query, const char *name, const char *value) {
+  return strcmp(queryValue(query, name), value) == 0;
+}
+
+// "1-6,10" → bitová maska kanálů (kanál 1 = bit 0)
+void parseChannelRanges(const char *text, uint8_t *bits, int channels) {
+  memset(bits, 0, channels / 8);
+  while (*text) {
+    char *end;
+    int lo = strtol(text, &end, 10);
+    int hi = (*end == '-') ? strtol(end + 1, &end, 10) : lo;
+    for (int ch = max(lo, 1); ch <= min(hi, channels); ch++) bits[(ch - 1) / 8] |= 1 << ((ch - 1) % 8);
+    const char *comma = strchr(end, ',');
+    if (!comma) break;
+    text = comma + 1;
+  }
+}
+
+// Bitová maska kanálů → "1-6,10" rovnou do odpovědi (empty = text pro prázdnou masku)
+void appendChannelRanges(ArenaText &out, const uint8_t *bits, int channels, const char *empty = "") {
+  bool any = false;
+  int ch = 0;
+  while (ch < channels) {
+    if (!(bits[ch / 8] & (1 << (ch % 8)))) { ch++; continue; }
+    int start = ch;
+    while (ch < channels && (bits[ch / 8] & (1 << (ch % 8)))) ch++;
+    char part[16];
+    if (ch - 1 > start) snprintf(part, sizeof(part), "%s%d-%d", any ? "," : "", start + 1, ch);
+    else snprintf(part, sizeof(part), "%s%d", any ? "," : "", start + 1);
+    out += part;
+    any = true;
   }
-  return result;
+  if (!any) out += empty;
 }
 
 //
 // Pomocné funkce pro enkodér a menu
 //
 void updateMenuBaseline() {
-  menuBaseline = encoder.getCount();
+  menuPos = 0;
 }
 
 int getRelativeIndex(int numItems) {
-  long rel = encoder.getCount() - menuBaseline;
+  long rel = menuPos;
   int idx = (rel) % numItems;  // každý "detent" změní hodnotu
   if (idx < 0) idx += numItems;
   return idx;
 }
 
-void resetEncoder() {
-  encoder.setCount(0);
-}
-
 //
-// Inicializace DMX přijímače a vysílače
+// Sestavení obrazovek (jednou v setup())
 //
-void initDMXTransciever() {
-  encoder.detach();
-  if (!dmxInstalled) {
-    // jednorázová instalace
-    dmx_driver_uninstall(dmxPort);
-    dmx_config_t config = DMX_CONFIG_DEFAULT;
-    dmx_driver_install(dmxPort, &config, DMX_INTR_FLAGS_DEFAULT);
-    dmx_set_pin(dmxPort, 19, 18, ENABLE_PIN);
-    Serial.println("DMX driver inicializován");
-    dmxInstalled = true;
-  }
-  encoder.attachHalfQuad(ENCODER_PIN_A, ENCODER_PIN_B);
+void initScreens() {
+  menuScreen.add(&menuTitle);
+  menuScreen.add(&menuList);
+
+  dmxScreen.add(&dmxTitle);
+  for (int i = 0; i < 6; i++) {
+    dmxScreen.add(&dmxLevel[i]);
+    dmxScreen.add(&dmxCode[i]);
+  }
+  dmxScreen.add(&dmxStatus);
+  dmxTitle.setText("Mode: DMX->IR");
+
+  irDmxScreen.add(&irDmxTitle);
+  irDmxScreen.add(&irDmxWaiting);
+  irDmxScreen.add(&irDmxScene);
+
+  learnScreen.add(&learnTitle);
+  learnScreen.add(&learnLine);
+  learnScreen.add(&learnProtoLabel);
+  learnScreen.add(&learnProto);
+  learnScreen.add(&learnCodeLabel);
+  learnScreen.add(&learnCode);
+}
+
+// Přepnutí obrazovky – jen tehdy se maže celý displej
+void showScreen(UiScreen &screen) {
+  if (activeScreen == &screen) return;
+  display.clearDisplay();
+  screen.invalidateAll();
+  activeScreen = &screen;
+}
+
+// Vykreslí změněné widgety; framebuffer se posílá jen když se něco změnilo
+void uiRender() {
+  if (activeScreen && activeScreen->render(display)) {
+    display.display();
+  }
 }
 
 //
 // Funkce pro kreslení menu na OLED displej
 //
 void drawMenu() {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(WHITE);
-  int lineHeight = 8;
-  
+  if (menuLevel == 3) { // IR Learn mode (Waiting for code...)
+    showScreen(learnScreen);
+    learnTitle.setText("IR Learn:");
+    learnLine.setText("Waiting for code...");
+    learnProtoLabel.setText("");
+    learnProto.setText("");
+    learnCodeLabel.setText("");
+    learnCode.setText("");
+    return;
+  }
+
+  showScreen(menuScreen);
   if (menuLevel == 0) { // Hlavní menu
-    display.setCursor(0, 0);
-    display.println("Main Menu:");
-    const char* items[4] = {"DMX to IR", "IR to DMX", "IR Learn", "Settings"};
-    int idx = getRelativeIndex(4);
-    for (int i = 0; i < 4; i++) {
-      display.setCursor(0, (i + 1) * lineHeight);
-      display.print((i == idx) ? "> " : "  ");
-      display.println(items[i]);
-    }
-    Serial.print("Main menu index: ");
-    Serial.println(idx);
+    const char* items[5] = {"DMX to IR", "IR to DMX", "IR Learn", "Settings", "DMX Thru"};
+    menuTitle.setText("Main Menu:");
+    menuList.setCount(MAIN_MENU_ITEMS);
+    for (int i = 0; i < MAIN_MENU_ITEMS; i++) menuList.setItem(i, items[i]);
+    menuList.setSelected(getRelativeIndex(MAIN_MENU_ITEMS));
   }
   else if (menuLevel == 1) { // Settings menu
-    display.setCursor(0, 0);
-    display.println("Settings:");
-    int idx = getRelativeIndex(2);
-    display.setCursor(0, lineHeight);
-    display.print((idx == 0) ? "> " : "  ");
-    display.print("WiFi AP: ");
-    display.println(wifiAPEnabled ? "ON" : "OFF");
-    display.setCursor(0, 2 * lineHeight);
-    display.print((idx == 1) ? "> " : "  ");
-    display.println("Exit");
-    Serial.print("Settings menu index: ");
-    Serial.println(idx);
+    menuTitle.setText("Settings:");
+    menuList.setCount(2);
+    menuList.setItem(0, wifiAPEnabled ? "WiFi AP: ON" : "WiFi AP: OFF");
+    menuList.setItem(1, "Exit");
+    menuList.setSelected(getRelativeIndex(2));
   }
   else if (menuLevel == 2) { // IR Learn submenu
-    display.setCursor(0, 0);
-    display.println("IR Learn:");
-    int idx = getRelativeIndex(7);
-    for (int i = 0; i < 7; i++) {
-      display.setCursor(0, (i + 1) * lineHeight);
-      display.print((i == idx) ? "> " : "  ");
-      if (i < 6) {
-        display.print(i + 1);
-        display.print(": ");
-        if (learnedIRCodes[i + 1] != 0) {
-          char buf[9];
-          sprintf(buf, "%08X", learnedIRCodes[i + 1]);
-          display.print(buf);
-        } else {
-          display.print("----");
-        }
+    menuTitle.setText("IR Learn:");
+    menuList.setCount(7);
+    for (int i = 0; i < 6; i++) {
+      char buf[16];
+      if (learnedIRCodes[i + 1] != 0) {
+        snprintf(buf, sizeof(buf), "%d: %08X", i + 1, learnedIRCodes[i + 1]);
       } else {
-        display.println("Exit");
+        snprintf(buf, sizeof(buf), "%d: ----", i + 1);
       }
+      menuList.setItem(i, buf);
     }
-    display.setCursor(0, 8 * lineHeight);
-    display.println("Press BTN to select");
-    Serial.print("IR Learn submenu index: ");
-    Serial.println(idx);
-  }
-  else if (menuLevel == 3) { // IR Learn mode (Waiting for code...)
-    display.clearDisplay();
-    display.setCursor(0, 0);
-    display.println("IR Learn:");
-    display.setCursor(0, 10);
-    display.println("Waiting for code...");
+    menuList.setItem(6, "Exit");
+    menuList.setSelected(getRelativeIndex(7));
   }
-  display.display();
 }
 
 
-// Režimy DMX to IR a IR to DMX 
-
-void runDmxToIr() {
-  if (dmxToIrFirstEntry) {
-    initDMXTransciever();
-    lastDmxPoll       = 0;
-    memset(dmxPrev,   0, sizeof(dmxPrev));
-    memset(lastIrSent,0, sizeof(lastIrSent));
-    dmxToIrFirstEntry = false;
-  }
-
-  unsigned long now = millis();
-  if (now - lastDmxPoll < 100) return;   // 10× za sekundu
-  lastDmxPoll = now;
-
-  // 1) Přečti DMX kanály
-  dmx_read(dmxPort, data, DMX_PACKET_SIZE);
+// Režimy DMX to IR a IR to DMX – samotné I/O běží v signálové úloze,
+// tady se jen kreslí podle událostí z fronty
 
-  // 2) Vykresli název módu + stavy + kódy
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(WHITE);
-  display.setCursor(0, 0);
-  display.println("Mode: DMX->IR");
+void drawDmxToIr(const DmxFrame &frame) {
+  const DmxStatsSnapshot &st = uiDmxStats;
+  showScreen(dmxScreen);
   for (int ch = 1; ch <= 6; ch++) {
-    int y = ch * 8;
-    display.setCursor(0, y);
-    char buf[32];
-    sprintf(buf, "CH%d:%3u", ch, data[ch]);
-    if (lastIrSent[ch]) {
-      strcat(buf, "  ");
-      sprintf(buf + strlen(buf), "%08X", lastIrSent[ch]);
+    dmxLevel[ch - 1].setValue(ch < frame.length ? frame.slots[ch] : 0);
+    if (uiIrSent[ch]) {
+      dmxCode[ch - 1].setTextf("%08X", uiIrSent[ch]);
+    } else {
+      dmxCode[ch - 1].setText("");
     }
-    display.println(buf);
   }
-  display.display();
-
-  // 3) EDGE-detekce, odeslání IR a mazání kódu, když klesne pod 255
-  for (int ch = 1; ch <= 6; ch++) {
-    bool highNow = (data[ch] == 255);
-    if (highNow && !dmxPrev[ch]) {
-      // právě přechod z <255 na 255 → pošli IR
-      uint32_t code = learnedIRCodes[ch];
-      if (code) {
-        irsend.sendNEC(code, 32);
-        lastIrSent[ch] = code;
-      }
-    }
-    else if (!highNow) {
-      // jakmile poklesne pod 255, smažeme zobrazený kód
-      lastIrSent[ch] = 0;
-    }
-    dmxPrev[ch] = highNow;
+  uint32_t errs = st.uartErrors + st.breakErrors + st.shortFrames;
+  if (!st.signalPresent) {
+    dmxStatus.setTextf("NO SIGNAL E%lu", (unsigned long)errs);
+  } else if (st.badStartCodes) {
+    dmxStatus.setTextf("%uHz E%lu SC%02X:%lu", st.framesPerSec,
+                       (unsigned long)errs, st.lastBadStartCode, (unsigned long)st.badStartCodes);
+  } else {
+    dmxStatus.setTextf("%uHz j%luus E%lu", st.framesPerSec,
+                       (unsigned long)st.jitterUs, (unsigned long)errs);
   }
 }
 
-
-
-void runIrToDmx() {
-  // 1) Při každém vstupu (firstEntry=true) vykreslí hlavičku + waiting
-   if (irToDmxFirstEntry) {
-    // PROBUĎ IRrecv, aby poslouchal hned od začátku:
-    irrecv.resume();
-
-    display.clearDisplay();
-    display.setTextSize(2);
-    display.setCursor(0, 0);
-    display.println("IR to DMX");
-    display.setTextSize(1);
-    display.setCursor(0, 24);
-    display.print("Waiting for IR");
-    display.display();
-
-    irToDmxFirstEntry = false;
-  }
-
-  // 2) Detekce nového IR kódu
-  if (irrecv.decode(&results)) {
-    irrecv.resume();
-    for (int i = 1; i <= 6; i++) {
-      if (results.value == learnedIRCodes[i]) {
-        // jen když se změnila scéna, překreslí scénu
-        if (i != irToDmxLastScene) {
-          display.fillRect(0, 40, SCREEN_WIDTH, 8, BLACK);
-          display.setCursor(0, 40);
-          display.print("Scene: ");
-          display.println(i);
-          display.display();
-          irToDmxLastScene = i;
-        }
-        break;
-      }
-    }
-  }
-
-  // 3) Pokud máme zvolenu scénu, vysíláme DMX paket pořád dokola
-  if (irToDmxLastScene != -1) {
-    initDMXTransciever();
-    digitalWrite(MAX485_CTRL_PIN, HIGH);
-    for (int ch = 1; ch <= 64; ch++) {
-      data[ch] = scenes[irToDmxLastScene - 1][ch - 1];
-    }
-    dmx_write(dmxPort, data, 65);
-    dmx_send(dmxPort, 65);
-    dmx_wait_sent(dmxPort, DMX_TIMEOUT_TICK);
-  }
+// DMX→IR: obsah se aktualizuje 10× za sekundu, kreslí se jen změněné widgety
+void updateDmxToIrView() {
+  unsigned long now = millis();
+  if (now - lastDmxViewDraw < 100) return;
+  lastDmxViewDraw = now;
+  drawDmxToIr(dmxFrames.acquire());
 }
 
+void drawIrToDmxHeader() {
+  showScreen(irDmxScreen);
+  irDmxTitle.setText("IR to DMX");
+  irDmxWaiting.setText("Waiting for IR");
+  irDmxScene.setText("");
+}
 
+void drawIrToDmxScene(int scene) {
+  irDmxScene.setTextf("Scene: %d", scene);
+}
 
-
-
+void drawIrToDmxCue(const CueStatus &st) {
+  if (!st.active) return;   // výstup má statická scéna – nechá se její text
+  const char *name = (st.mode == CUE_MODE_CHASE) ? "Chase" : "Cue";
+  if (st.index == CUE_NONE) irDmxScene.setTextf("%s -/%u", name, st.count);
+  else irDmxScene.setTextf("%s %u/%u%s", name, st.index + 1, st.count, st.paused ? " PAUSE" : "");
+}
 
 //
 // Upravený IR Learn režim – při uložení kódu ověříme, zda knihovna IRremoteESP8266 rozpoznala protokol.
 // Pokud ano, do terminálu se vypíše název protokolu a kód se uloží.
-// Pokud ne, kód se odmítne.
+// Pokud ne, kód se odmítne (to už řeší signálová úloha).
 // Po úspěšném naučení (nebo timeoutu) se vracíme do hlavního menu.
 //
 void runIrLearn() {
@@ -370,26 +549,23 @@ void runIrLearn() {
   }
   if (millis() - irLearnStartTime >= 10000) {
     // timeout – návrat do menu
+    signalPostCmd(CMD_SET_MODE, SIG_IDLE);
     irLearnStartTime = 0;
     activeMode = MODE_MENU;
     menuMode = true; menuLevel = 0; menuIndexIRLearn = 0;
     updateMenuBaseline();
     drawMenu();
-    return;
   }
+}
 
-  drawMenu();
-
-  if (!irrecv.decode(&results)) return;
-  irrecv.resume();
+void returnToMenu();
 
-  // ignor NEC-repeat
-  if (results.decode_type == NEC && results.value == 0xFFFFFFFFFFFFFFFFULL) return;
-  if (results.decode_type == UNKNOWN) return;
+void onIrLearned(const SignalEvt &evt) {
+  if (activeMode != MODE_IR_LEARN) return;
 
   // zjistíme protokol
   String proto;
-  switch (results.decode_type) {
+  switch (evt.learned.protocol) {
     case NEC:  proto = "NEC";  break;
     case SONY: proto = "SONY"; break;
     case RC5:  proto = "RC5";  break;
@@ -399,67 +575,109 @@ void runIrLearn() {
 
   // uložíme kód
   int pos = irLearnPos + 1;
-  uint32_t code = (uint32_t)results.value;
+  uint32_t code = evt.learned.code;
+  lastLearnedCode = code;
   learnedIRCodes[pos] = code;
-  char key[12];
-  sprintf(key, "ircode%d", pos);
-  preferences.putUInt(key, code);
+  signalPostCmd(CMD_SET_IR_CODE, pos, 0, code);
+  configSave();
 
   // vykreslíme protokol a kód na OLED
-   display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(WHITE);
+  showScreen(learnScreen);
+  learnTitle.setText("IR code learned");
+  learnLine.setText("");
+  learnProtoLabel.setText("Protocol:");
+  learnProto.setText(proto.c_str());
+  learnCodeLabel.setText("Code:");
+  learnCode.setTextf("%08X", code);
+  uiRender();
+  delay(2500);   // blokuje jen UI úlohu, signálová cesta běží dál
 
-  display.setCursor(0, 0);
-  display.println("IR code learned");
-  display.println("");                    // prázdný řádek
-
-  display.print("Protocol:");
-  display.setCursor(70, 16);
-  display.println(proto);
+  // návrat do menu
+  returnToMenu();
+}
 
-  char buf[9];
-  sprintf(buf, "%08X", code);
-  display.print("Code:");
-  display.setCursor(70, 24);
-  display.println(buf);
+//
+// Zpracování událostí ze signálové úlohy
+//
+void handleSignalEvents() {
+  SignalEvt evt;
+  while (signalEvtQueue.pop(evt)) {
+    switch (evt.type) {
+      case EVT_DMX_STATS:
+        uiDmxStats = evt.stats;
+        if (activeMode == MODE_DMX_THRU) {
+          if (uiDmxStats.signalPresent) irDmxWaiting.setTextf("IN %uHz", uiDmxStats.framesPerSec);
+          else irDmxWaiting.setText("NO INPUT (hold)");
+        }
+        break;
+      case EVT_IR_SENT:
+        if (evt.ir.ch >= 1 && evt.ir.ch <= 6) uiIrSent[evt.ir.ch] = evt.ir.code;
+        break;
+      case EVT_SCENE_SELECTED:
+        irToDmxLastScene = evt.scene;
+        if (activeMode == MODE_IR_TO_DMX || activeMode == MODE_DMX_THRU) drawIrToDmxScene(evt.scene);
+        break;
+      case EVT_IR_LEARNED:
+        onIrLearned(evt);
+        break;
+      case EVT_CUE_STATE:
+        if (activeMode == MODE_IR_TO_DMX || activeMode == MODE_DMX_THRU) drawIrToDmxCue(evt.cue);
+        break;
+    }
+  }
+}
 
-  display.display();
-  delay(2500);
+// Poslední režim do NVS (obnoví se po startu)
+void saveLastMode(uint8_t m) {
+  TraceScope trace(TRACE_NVS_WRITE);
+  preferences.putUChar("mode", m);
+}
 
-  // návrat do menu
-  irLearnStartTime = 0;
-  activeMode = MODE_MENU;
-  menuMode = true; menuLevel = 0; menuIndexIRLearn = 0;
-  resetEncoder();
-  encoder.attachHalfQuad(ENCODER_PIN_A, ENCODER_PIN_B);
+//
+// Vstup do DMX→IR / IR→DMX / DMX Thru (z menu i obnovení po startu). Režim se pamatuje
+// v NVS; post = false, když ho signálové úloze poslal už setup()
+//
+void enterSignalMode(AppMode m, bool post) {
+  activeMode = m;
+  menuMode = false;
   updateMenuBaseline();
-  drawMenu();
+  if (m == MODE_DMX_TO_IR) {
+    memset(uiIrSent, 0, sizeof(uiIrSent));
+    lastDmxViewDraw = 0;
+  } else {
+    // reset stavů
+    irToDmxLastScene = -1;
+    drawIrToDmxHeader();
+    if (m == MODE_DMX_THRU) {
+      irDmxTitle.setText("DMX Thru");
+      irDmxWaiting.setText("NO INPUT");
+    }
+  }
+  if (post) {
+    signalPostCmd(CMD_SET_MODE, signalModeFor(m));
+    saveLastMode(m);
+  }
 }
 
-
-
 //
 // Funkce pro návrat do menu – reset enkodéru a IR Learn index
+// (stisk mimo menu, nebo dlouhý stisk kdekoli)
 //
-void checkReturnToMenu() {
-  if (activeMode == MODE_IR_TO_DMX && (millis() < 1000)) {
-    return;
+void returnToMenu() {
+  LOG_I("Návrat do menu");
+  updateMenuBaseline();
+  if (activeMode != MODE_MENU) {
+    signalPostCmd(CMD_SET_MODE, SIG_IDLE);
   }
-  if (digitalRead(ENCODER_BTN_PIN) == LOW && (millis() - lastButtonTime > debounceDelay)) {
-    Serial.println("Návrat do menu");
-    resetEncoder();
-    encoder.attachHalfQuad(ENCODER_PIN_A, ENCODER_PIN_B);
-    updateMenuBaseline();
-    activeMode = MODE_MENU;
-    menuMode = true;
-    menuLevel = 0;
-    menuIndexIRLearn = 0;
-    drawMenu();
-    initDMXTransciever();
-    lastButtonTime = millis();
-    
+  if (isSignalMode(activeMode)) {
+    saveLastMode(MODE_MENU);
   }
+  irLearnStartTime = 0;
+  activeMode = MODE_MENU;
+  menuMode = true;
+  menuLevel = 0;
+  menuIndexIRLearn = 0;
+  drawMenu();
 }
 
 //
@@ -541,12 +759,322 @@ uint32_t getIRCodeFromLibrary(String manufacturer, String devType, String comman
 }
 
 
+// Statické soubory webu (serveWebAsset)
+struct WebStaticStats {
+  uint32_t sent;
+  uint32_t notModified;
+  uint32_t bytes;
+};
+WebStaticStats webStaticStats = {};
+
+#define REQ_HEADER_LINE 256
+
+// Sink ArenaText: plné okno odpovědi rovnou klientovi
+static void clientSink(void *ctx, const char *data, size_t len) {
+  ((WiFiClient *)ctx)->write((const uint8_t *)data, len);
+}
+
+//
+// Metriky DMX vstupu pro "/metrics"
+//
+void appendDmxMetrics(ArenaText &out) {
+  const DmxStatsSnapshot &st = uiDmxStats;
+  char line[64];
+  snprintf(line, sizeof(line), "dmx_signal_present %d\n", st.signalPresent ? 1 : 0);          out += line;
+  snprintf(line, sizeof(line), "dmx_frames_per_sec %u\n", st.framesPerSec);                   out += line;
+  snprintf(line, sizeof(line), "dmx_errors_per_sec %u\n", st.errorsPerSec);                   out += line;
+  snprintf(line, sizeof(line), "dmx_frames_total %lu\n", (unsigned long)st.framesTotal);      out += line;
+  snprintf(line, sizeof(line), "dmx_uart_errors %lu\n", (unsigned long)st.uartErrors);        out += line;
+  snprintf(line, sizeof(line), "dmx_break_errors %lu\n", (unsigned long)st.breakErrors);      out += line;
+  snprintf(line, sizeof(line), "dmx_short_frames %lu\n", (unsigned long)st.shortFrames);      out += line;
+  snprintf(line, sizeof(line), "dmx_bad_start_codes %lu\n", (unsigned long)st.badStartCodes); out += line;
+  snprintf(line, sizeof(line), "dmx_last_bad_start_code %u\n", st.lastBadStartCode);          out += line;
+  snprintf(line, sizeof(line), "dmx_signal_losses %lu\n", (unsigned long)st.signalLosses);    out += line;
+  snprintf(line, sizeof(line), "dmx_slots_last %u\n", st.lastSlots);                          out += line;
+  snprintf(line, sizeof(line), "dmx_slots_min %u\n", st.framesTotal ? st.minSlots : 0);       out += line;
+  snprintf(line, sizeof(line), "dmx_slots_max %u\n", st.maxSlots);                            out += line;
+  snprintf(line, sizeof(line), "dmx_interval_avg_us %lu\n", (unsigned long)st.intervalAvgUs); out += line;
+  snprintf(line, sizeof(line), "dmx_interval_max_us %lu\n", (unsigned long)st.intervalMaxUs); out += line;
+  snprintf(line, sizeof(line), "dmx_jitter_us %lu\n", (unsigned long)st.jitterUs);            out += line;
+  snprintf(line, sizeof(line), "dmx_frames_published %lu\n", (unsigned long)dmxFrames.publishedCount()); out += line;
+  snprintf(line, sizeof(line), "dmx_frames_unchanged %lu\n", (unsigned long)dmxFrames.unchangedCount()); out += line;
+  snprintf(line, sizeof(line), "ui_renders %lu\n", (unsigned long)uiRenderStats.renders);          out += line;
+  snprintf(line, sizeof(line), "ui_render_skipped %lu\n", (unsigned long)uiRenderStats.skipped);   out += line;
+  snprintf(line, sizeof(line), "ui_widgets_drawn %lu\n", (unsigned long)uiRenderStats.widgetsDrawn); out += line;
+  snprintf(line, sizeof(line), "ui_render_last_us %lu\n", (unsigned long)uiRenderStats.lastRenderUs); out += line;
+  snprintf(line, sizeof(line), "ui_render_max_us %lu\n", (unsigned long)uiRenderStats.maxRenderUs); out += line;
+  const SH1106FlushStats &fs = display.stats();
+  snprintf(line, sizeof(line), "oled_flush_requested %lu\n", (unsigned long)fs.requested);   out += line;
+  snprintf(line, sizeof(line), "oled_flush_done %lu\n", (unsigned long)fs.flushed);          out += line;
+  snprintf(line, sizeof(line), "oled_flush_coalesced %lu\n", (unsigned long)fs.coalesced);   out += line;
+  snprintf(line, sizeof(line), "oled_pages_sent %lu\n", (unsigned long)fs.pagesSent);        out += line;
+  snprintf(line, sizeof(line), "oled_pages_skipped %lu\n", (unsigned long)fs.pagesSkipped);  out += line;
+  snprintf(line, sizeof(line), "oled_flush_last_us %lu\n", (unsigned long)fs.lastFlushUs);   out += line;
+  snprintf(line, sizeof(line), "oled_flush_max_us %lu\n", (unsigned long)fs.maxFlushUs);     out += line;
+  snprintf(line, sizeof(line), "trace_events_total %lu\n", (unsigned long)traceRecorded());        out += line;
+  const LogStats &ls = logStats();
+  snprintf(line, sizeof(line), "log_level %u\n", logRuntimeLevel);                                  out += line;
+  snprintf(line, sizeof(line), "log_written %lu\n", (unsigned long)ls.written);                     out += line;
+  snprintf(line, sizeof(line), "log_dropped %lu\n", (unsigned long)ls.dropped);                     out += line;
+  snprintf(line, sizeof(line), "log_truncated %lu\n", (unsigned long)ls.truncated);                 out += line;
+  const SerialProtoStats &sp = serialRx.stats();
+  snprintf(line, sizeof(line), "serial_rx_frames %lu\n", (unsigned long)sp.frames);              out += line;
+  snprintf(line, sizeof(line), "serial_rx_crc_errors %lu\n", (unsigned long)sp.crcErrors);       out += line;
+  snprintf(line, sizeof(line), "serial_rx_malformed %lu\n", (unsigned long)sp.malformed);        out += line;
+  snprintf(line, sizeof(line), "serial_rx_overflows %lu\n", (unsigned long)sp.overflows);        out += line;
+  snprintf(line, sizeof(line), "serial_tx_frames %lu\n", (unsigned long)serialTxFrames);         out += line;
+  snprintf(line, sizeof(line), "web_static_sent %lu\n", (unsigned long)webStaticStats.sent);       out += line;
+  snprintf(line, sizeof(line), "web_static_not_modified %lu\n", (unsigned long)webStaticStats.notModified); out += line;
+  snprintf(line, sizeof(line), "web_static_bytes %lu\n", (unsigned long)webStaticStats.bytes);      out += line;
+  const ReqArenaStats &ra = reqArena.stats();
+  snprintf(line, sizeof(line), "http_requests %lu\n", (unsigned long)ra.requests);                out += line;
+  snprintf(line, sizeof(line), "http_arena_last_bytes %lu\n", (unsigned long)ra.lastUsed);        out += line;
+  snprintf(line, sizeof(line), "http_arena_high_water %lu\n", (unsigned long)ra.highWater);       out += line;
+  snprintf(line, sizeof(line), "http_arena_last_reserved %lu\n", (unsigned long)ra.lastReserved); out += line;
+  snprintf(line, sizeof(line), "http_arena_failed %lu\n", (unsigned long)ra.failed);              out += line;
+  snprintf(line, sizeof(line), "http_arena_flushes %lu\n", (unsigned long)ra.flushes);            out += line;
+  HeapSample heap = heapSampleNow(millis());
+  snprintf(line, sizeof(line), "heap_free %lu\n", (unsigned long)heap.freeBytes);                 out += line;
+  snprintf(line, sizeof(line), "heap_min_free %lu\n", (unsigned long)heap.minFree);               out += line;
+  snprintf(line, sizeof(line), "heap_largest_block %lu\n", (unsigned long)heap.largestBlock);     out += line;
+  snprintf(line, sizeof(line), "heap_frag_pct %u\n", heapFragPct(heap));                          out += line;
+  snprintf(line, sizeof(line), "heap_alloc_failed %lu\n", (unsigned long)heapFailedAllocs());     out += line;
+  snprintf(line, sizeof(line), "signal_evt_dropped %lu\n", (unsigned long)signalEvtQueue.dropped()); out += line;
+  const IrRxStats &ir = irRxStats();
+  snprintf(line, sizeof(line), "ir_rx_decoded %lu\n", (unsigned long)ir.decoded);             out += line;
+  snprintf(line, sizeof(line), "ir_rx_repeats %lu\n", (unsigned long)ir.repeats);             out += line;
+  snprintf(line, sizeof(line), "ir_rx_unknown %lu\n", (unsigned long)ir.unknown);             out += line;
+  snprintf(line, sizeof(line), "ir_rx_overflows %lu\n", (unsigned long)ir.overflows);         out += line;
+  snprintf(line, sizeof(line), "ir_rx_queue_overruns %lu\n", (unsigned long)irEvents.dropped()); out += line;
+  snprintf(line, sizeof(line), "ir_rx_latency_last_us %lu\n", (unsigned long)ir.lastLatencyUs); out += line;
+  snprintf(line, sizeof(line), "ir_rx_latency_max_us %lu\n", (unsigned long)ir.maxLatencyUs);  out += line;
+  snprintf(line, sizeof(line), "merge_frames %lu\n", (unsigned long)mergeStats.merges);      out += line;
+  snprintf(line, sizeof(line), "merge_last_us %lu\n", (unsigned long)mergeStats.lastUs);     out += line;
+  snprintf(line, sizeof(line), "merge_max_us %lu\n", (unsigned long)mergeStats.maxUs);       out += line;
+  snprintf(line, sizeof(line), "merge_channels %u\n", mergeStats.channels);                  out += line;
+  snprintf(line, sizeof(line), "curve_last_us %lu\n", (unsigned long)mergeStats.curveLastUs); out += line;
+  snprintf(line, sizeof(line), "curve_max_us %lu\n", (unsigned long)mergeStats.curveMaxUs);   out += line;
+  snprintf(line, sizeof(line), "nudge_master %u\n", mergeStats.nudgeMaster);                 out += line;
+  snprintf(line, sizeof(line), "nudge_channels %u\n", mergeStats.nudgeChannels);             out += line;
+  snprintf(line, sizeof(line), "nudge_last_us %lu\n", (unsigned long)mergeStats.nudgeLastUs); out += line;
+  const SceneBankInfo &sb = sceneBankInfo();
+  snprintf(line, sizeof(line), "scene_bank_mapped %d\n", sb.mapped ? 1 : 0);                 out += line;
+  snprintf(line, sizeof(line), "scene_bank_slot %d\n", sb.activeSlot);                       out += line;
+  snprintf(line, sizeof(line), "scene_bank_generation %lu\n", (unsigned long)sb.generation); out += line;
+  snprintf(line, sizeof(line), "scene_bank_writes %lu\n", (unsigned long)sb.writes);         out += line;
+  snprintf(line, sizeof(line), "scene_bank_write_errors %lu\n", (unsigned long)sb.writeErrors); out += line;
+  snprintf(line, sizeof(line), "scene_bank_write_last_us %lu\n", (unsigned long)sb.lastWriteUs); out += line;
+#if DMX_THRU_ENABLED
+  const DmxThruStats &th = dmxThruStats();
+  snprintf(line, sizeof(line), "thru_frames_in %lu\n", (unsigned long)th.framesIn);           out += line;
+  snprintf(line, sizeof(line), "thru_frames_out %lu\n", (unsigned long)th.framesOut);         out += line;
+  snprintf(line, sizeof(line), "thru_frames_held %lu\n", (unsigned long)th.framesHeld);       out += line;
+  snprintf(line, sizeof(line), "thru_bad_start_codes %lu\n", (unsigned long)th.badStartCodes); out += line;
+  snprintf(line, sizeof(line), "thru_input_losses %lu\n", (unsigned long)th.inputLosses);     out += line;
+  snprintf(line, sizeof(line), "thru_latency_last_us %lu\n", (unsigned long)th.lastLatencyUs); out += line;
+  snprintf(line, sizeof(line), "thru_latency_max_us %lu\n", (unsigned long)th.maxLatencyUs);  out += line;
+  snprintf(line, sizeof(line), "thru_frame_us %lu\n", (unsigned long)th.frameUs);             out += line;
+  snprintf(line, sizeof(line), "thru_over_target %lu\n", (unsigned long)th.overTarget);       out += line;
+#endif
+  const ShowStats &ss = showStats();
+  snprintf(line, sizeof(line), "show_state %u\n", (unsigned)showState());                       out += line;
+  snprintf(line, sizeof(line), "show_file_bytes %lu\n", (unsigned long)showFileSize());          out += line;
+  snprintf(line, sizeof(line), "show_frames_recorded %lu\n", (unsigned long)ss.framesRecorded);  out += line;
+  snprintf(line, sizeof(line), "show_frames_unchanged %lu\n", (unsigned long)ss.framesUnchanged); out += line;
+  snprintf(line, sizeof(line), "show_ring_overruns %lu\n", (unsigned long)showRecRing.dropped()); out += line;
+  snprintf(line, sizeof(line), "show_flash_writes %lu\n", (unsigned long)ss.flashWrites);        out += line;
+  snprintf(line, sizeof(line), "show_write_last_us %lu\n", (unsigned long)ss.lastWriteUs);       out += line;
+  snprintf(line, sizeof(line), "show_write_max_us %lu\n", (unsigned long)ss.maxWriteUs);         out += line;
+  snprintf(line, sizeof(line), "show_write_errors %lu\n", (unsigned long)ss.writeErrors);        out += line;
+  snprintf(line, sizeof(line), "show_frames_played %lu\n", (unsigned long)ss.framesPlayed);      out += line;
+  snprintf(line, sizeof(line), "show_format_errors %lu\n", (unsigned long)ss.formatErrors);      out += line;
+}
+
+//
+// Přečte hlavičky požadavku (po řádku s metodou) a vrátí hodnotu jedné z nich
+// ("" = chybí); name malými písmeny
+//
+String readRequestHeader(WiFiClient &client, const char *name) {
+  String value;
+  size_t nameLen = strlen(name);
+  if (client.peek() == '\n') client.read();   // zbytek "\r\n" za řádkem s metodou
+  // řádek hlavičky do arény (rezerva REQ_ARENA_RESERVE), ne do Stringu
+  static char fallback[64];   // jen kdyby rezerva chyběla
+  char *line = (char *)reqArena.alloc(REQ_HEADER_LINE);
+  size_t cap = line ? REQ_HEADER_LINE : sizeof(fallback);
+  if (!line) line = fallback;
+  for (;;) {
+    size_t n = client.readBytesUntil('\n', line, cap - 1);
+    // delší řádek (cookie apod.) – zbytek se zahodí, jméno hlavičky je na začátku
+    if (n == cap - 1) client.find((char *)"\n");
+    while (n && isspace((unsigned char)line[n - 1])) n--;
+    line[n] = 0;
+    if (!n) break;
+    if (n > nameLen && line[nameLen] == ':' && strncasecmp(line, name, nameLen) == 0) {
+      const char *v = line + nameLen + 1;
+      while (*v == ' ' || *v == '\t') v++;
+      value = v;
+    }
+  }
+  return value;
+}
+
+//
+// Statický soubor z flash (web_assets.h): 304 při shodném ETagu, jinak gzip tělo
+//
+void serveWebAsset(WiFiClient &client, const WebAsset &asset, const String &ifNoneMatch) {
+  if (ifNoneMatch.length() && ifNoneMatch.indexOf(asset.etag) >= 0) {
+    client.printf("HTTP/1.1 304 Not Modified\r\nETag: %s\r\nCache-Control: no-cache\r\n\r\n", asset.etag);
+    webStaticStats.notModified++;
+  } else {
+    // no-cache = prohlížeč si soubor nechá, ale před použitím se zeptá (nový firmware = nový ETag)
+    client.printf("HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Encoding: gzip\r\n"
+                  "Content-Length: %lu\r\nETag: %s\r\nCache-Control: no-cache\r\n\r\n",
+                  asset.contentType, (unsigned long)asset.length, asset.etag);
+    client.write(asset.data, asset.length);
+    webStaticStats.sent++;
+    webStaticStats.bytes += asset.length;
+  }
+  delay(1);
+  client.stop();
+}
+
+//
+// Import konfigurace (POST /config, tělo = blob). Nejdřív se ověří celý blob,
+// pak se jedním zápisem uloží do NVS a převodník se restartuje – signálová
+// úloha tak nikdy nevidí napůl novou konfiguraci.
+//
+// Ověří blob a uloží ho (HTTP i sériový protokol); NULL = uloženo, jinak důvod odmítnutí
+const char *configStoreBlob(const uint8_t *blob, size_t len) {
+  static DeviceConfig cfg;
+  configDefaults(cfg);
+  ConfigError err = configParse(blob, len, cfg);
+  if (err != CONFIG_OK) return configErrorName(err);
+  {
+    TraceScope trace(TRACE_NVS_WRITE);
+    if (preferences.putBytes("config", blob, len) != len) return "NVS write failed";
+  }
+  // banka až po NVS: když zápis selže, srovná ji scenesFromBank() po restartu
+  if (sceneBankMapped()) {
+    if (sceneBankWrite(&cfg.scenes[0][0], CONFIG_SCENES, CONFIG_SCENE_CH)) signalPostCmd(CMD_SCENE_BANK_SWAP);
+    else LOG_W("Zápis banky scén selhal – srovná se po restartu");
+  }
+  return NULL;
+}
+
+void handleConfigImport(WiFiClient &client) {
+  // hlavičky – potřebujeme jen Content-Length
+  int contentLength = readRequestHeader(client, "content-length").toInt();
+
+  static uint8_t blob[CONFIG_MAX_SIZE];
+  const char *result = NULL;
+  if (contentLength <= 0 || contentLength > (int)sizeof(blob)) {
+    result = "bad size";
+  } else if (client.readBytes(blob, contentLength) != (size_t)contentLength) {
+    result = "incomplete upload";
+  } else {
+    result = configStoreBlob(blob, contentLength);
+  }
+
+  if (result) {
+    client.printf("HTTP/1.1 400 Bad Request\r\nContent-Type: text/plain\r\n\r\nconfig rejected: %s\n", result);
+    delay(1);
+    client.stop();
+    return;
+  }
+  client.print("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n\r\nconfig imported, restarting\n");
+  delay(100);
+  client.stop();
+  LOG_I("Konfigurace importována – restart");
+  logFlush(200);
+  ESP.restart();
+}
+
+//
+// POST /irimport – soubor Pronto hex nebo LIRC .conf jako tělo požadavku.
+// Čte se po kouscích rovnou do parseru, paměť nezávisí na velikosti souboru.
+// Kódy jdou do pracovní kopie knihovny; ta se převezme a uloží jen po
+// přečtení celého těla – přerušený upload knihovnu nezmění.
+//
+static IrLibEntry irImportStaged[IR_LIB_MAX];
+static uint8_t irImportStagedCount = 0;
+
+static void irImportSink(const char *name, uint32_t code, void *) {
+  IrLibEntry e;
+  irLibrarySetName(e, name);
+  e.code = code;
+  for (int i = 0; i < irImportStagedCount; i++) {
+    if (strcmp(irImportStaged[i].name, e.name) == 0) {
+      irImportStaged[i].code = code;
+      lastIrImport.updated++;
+      return;
+    }
+  }
+  if (irImportStagedCount >= IR_LIB_MAX) {
+    lastIrImport.dropped++;
+    return;
+  }
+  irImportStaged[irImportStagedCount++] = e;
+  lastIrImport.added++;
+}
+
+void handleIrImport(WiFiClient &client, bool replace) {
+  int contentLength = readRequestHeader(client, "content-length").toInt();
+  uint32_t startMs = millis();
+  memset(&lastIrImport, 0, sizeof(lastIrImport));
+  irImportStagedCount = replace ? 0 : irLibraryCount;
+  memcpy(irImportStaged, irLibrary, irImportStagedCount * sizeof(IrLibEntry));
+
+  IrImportParser parser(irImportSink, NULL);
+  static char buf[256];
+  int remaining = contentLength;
+  while (remaining > 0) {
+    size_t n = client.readBytes(buf, min(remaining, (int)sizeof(buf)));
+    if (!n) break;
+    uint32_t t = micros();
+    parser.feed(buf, n);
+    lastIrImport.parseUs += micros() - t;
+    remaining -= n;
+  }
+  parser.finish();
+  lastIrImport.stats = parser.stats();
+  lastIrImport.totalMs = millis() - startMs;
+
+  bool accepted = contentLength > 0 && !remaining;
+  bool saved = true;
+  if (accepted) {
+    memcpy(irLibrary, irImportStaged, irImportStagedCount * sizeof(IrLibEntry));
+    irLibraryCount = irImportStagedCount;
+    saved = irLibrarySave();
+  }
+
+  const IrImportStats &st = lastIrImport.stats;
+  const char *formats[3] = { "unknown", "Pronto", "LIRC" };
+  client.printf("HTTP/1.1 %s\r\nContent-Type: text/plain\r\n\r\n",
+                accepted ? "200 OK" : "400 Bad Request");
+  if (contentLength <= 0) client.print("import rejected: missing Content-Length\n");
+  else if (remaining) client.printf("import incomplete: %d B missing, library unchanged\n", remaining);
+  client.printf("format %s, %lu B, %lu lines in %lu ms (parser %lu us)\n"
+                "commands %u: converted %u, unsupported %u, bad lines %u\n"
+                "library: added %u, updated %u, full %u, total %u/%u%s\n",
+                formats[st.format], (unsigned long)st.bytes, (unsigned long)st.lines,
+                (unsigned long)lastIrImport.totalMs, (unsigned long)lastIrImport.parseUs,
+                st.commands, st.converted, st.unsupported, st.errors,
+                lastIrImport.added, lastIrImport.updated, lastIrImport.dropped,
+                irLibraryCount, IR_LIB_MAX, saved ? "" : " (NVS write failed)");
+  delay(1);
+  client.stop();
+  LOG_I("IR import: %u kódů z %lu B za %lu ms", st.converted, (unsigned long)st.bytes,
+        (unsigned long)lastIrImport.totalMs);
+}
+
 //
 // Funkce pro obsluhu WiFi serveru s rozšířeným formulářem
 //
 void handleWiFiServer() {
   WiFiClient client = server.available();
   if (!client) return;
+  TraceScope trace(TRACE_HTTP);
 
   unsigned long reqStartTime = millis();
   while (!client.available() && millis() - reqStartTime < 2000) {
@@ -557,67 +1085,85 @@ void handleWiFiServer() {
     return;
   }
 
-  // Cteni radku request
-  String request = client.readStringUntil('\r');
-  Serial.print("HTTP Request: ");
-  Serial.println(request);
+  // Vše, co požadavek přidělí z arény, se na konci vrátí (každý return níže)
+  ReqArenaScope arenaScope(reqArena);
+
+  // Cteni radku request – rovnou do arény, /scenes má v query přes 6 KB
+  size_t avail;
+  char *request = reqArena.scratch(avail);
+  size_t reqLen = avail > REQ_ARENA_RESERVE ? avail - REQ_ARENA_RESERVE : 0;
+  reqLen = client.readBytesUntil('\r', request, reqLen);
+  request[reqLen] = 0;
+  reqArena.commit(reqLen + 1);
+  LOG_D("HTTP %s", request);
+  if (reqLen + 1 + REQ_ARENA_RESERVE >= avail) {
+    client.print("HTTP/1.1 414 URI Too Long\r\nContent-Type: text/plain\r\n\r\nrequest line too long\n");
+    delay(1);
+    client.stop();
+    return;
+  }
 
-  // Parsovani cesty a dotazu (query)
-  int firstSpace = request.indexOf(' ');
-  int secondSpace = request.indexOf(' ', firstSpace + 1);
-  String fullPath = request.substring(firstSpace + 1, secondSpace);
-  String path = fullPath;
-  String query = "";
-  int qm = fullPath.indexOf('?');
-  if (qm >= 0) {
-    path  = fullPath.substring(0, qm);
-    query = fullPath.substring(qm + 1);
+  // Parsovani cesty a dotazu (query) – na místě, '\0' místo mezer a '?'
+  bool isPost = strncmp(request, "POST ", 5) == 0;
+  char *target = strchr(request, ' ');
+  target = target ? target + 1 : request + reqLen;
+  char *end = strchr(target, ' ');
+  if (end) *end = 0;
+  const char *query = "";
+  char *qm = strchr(target, '?');
+  if (qm) {
+    *qm = 0;
+    query = qm + 1;
   }
+  String path = target;
 
   // Pokud je "/scenes", zobraz nebo uloz DMX sceny
   if (path == "/scenes") {
     // Pokud je pritomen dotaz (query), rozparsuj ho a uloz do pole scenes []
-    if (query.length()) {
-      int idx = 0;
-      while (idx < query.length()) {
-        int amp = query.indexOf('&', idx);
-        if (amp < 0) amp = query.length();
-        String pair = query.substring(idx, amp);
-        int eq = pair.indexOf('=');
-        if (eq > 0) {
-          String name   = pair.substring(0, eq);
-          String value  = urldecode(pair.substring(eq + 1));
-          if (name.startsWith("scene")) {
-            int us    = name.indexOf('_');
-            int sNum  = name.substring(5, us).toInt();    // 1..6
-            int cNum  = name.substring(us + 3).toInt();   // 1..64
-            if (sNum >= 1 && sNum <= 6 && cNum >= 1 && cNum <= 64) {
-              scenes[sNum - 1][cNum - 1] = constrain(value.toInt(), 0, 255);
-            }
+    bool bankFailed = false;
+    if (*query) {
+      bool changed = false;
+      for (const char *p = query; *p; ) {
+        // "sceneS_chC=V" – čísla bez kódování, stačí sscanf/atoi přímo v query
+        int sNum, cNum, used = 0;
+        if (sscanf(p, "scene%d_ch%d=%n", &sNum, &cNum, &used) == 2 && used &&
+            sNum >= 1 && sNum <= 6 && cNum >= 1 && cNum <= 64) {
+          uint8_t v = constrain(atoi(p + used), 0, 255);
+          if (scenes[sNum - 1][cNum - 1] != v) {
+            scenes[sNum - 1][cNum - 1] = v;
+            changed = true;
+            if (!sceneBankMapped()) signalPostCmd(CMD_SET_SCENE_VALUE, sNum - 1, cNum - 1, v);
           }
         }
-        idx = amp + 1;
+        const char *amp = strchr(p, '&');
+        p = amp ? amp + 1 : p + strlen(p);
       }
-      // Ukladani kazde sceny do NVS
-      for (int s = 0; s < 6; s++) {
-        char key[12];
-        sprintf(key, "scene%d", s + 1);
-        preferences.putBytes(key, scenes[s], sizeof(scenes[s]));
+      // konfigurace první; s bankou ve flash pak celý zápis do druhého slotu a přepnutí
+      configSave();
+      if (changed && sceneBankMapped()) {
+        if (sceneBankWrite(&scenes[0][0], SIGNAL_SCENES, SIGNAL_SCENE_CH)) signalPostCmd(CMD_SCENE_BANK_SWAP);
+        else bankFailed = true;
       }
     }
 
     // Vytvorit HTML pro konfiguraci scen
-    String html = "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
     html += "<html><head><meta charset='UTF-8'><title>DMX Scenes</title></head><body>";
     html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
     html += "<h1>Configure DMX Scenes</h1>";
+    if (bankFailed) html += "<p><b>Zápis do banky scén selhal – výstup používá předchozí scény.</b></p>";
     html += "<form method='GET' action='/scenes'>";
     for (int s = 0; s < 6; s++) {
-      html += "<fieldset><legend>Scene " + String(s + 1) + "</legend>";
+      char legend[48];
+      snprintf(legend, sizeof(legend), "<fieldset><legend>Scene %d</legend>", s + 1);
+      html += legend;
       for (int c = 0; c < 64; c++) {
-        html += "Ch" + String(c + 1) + ": ";
-        html += "<input type='number' name='scene" + String(s + 1) + "_ch" + String(c + 1) + 
-                "' min='0' max='255' value='" + String(scenes[s][c]) + "' style='width:50px;'> ";
+        // 384 políček – snprintf místo skládání Stringů
+        char field[128];
+        snprintf(field, sizeof(field), "Ch%d: <input type='number' name='scene%d_ch%d' min='0' max='255' value='%u' style='width:50px;'> ",
+                 c + 1, s + 1, c + 1, scenes[s][c]);
+        html += field;
         if ((c + 1) % 8 == 0) html += "<br>";
       }
       html += "</fieldset><br>";
@@ -625,329 +1171,1101 @@ void handleWiFiServer() {
     html += "<input type='submit' value='Save Scenes'></form>";
     html += "</body></html>";
 
-    client.print(html);
+    html.flush();
     delay(1);
     client.stop();
     return;
   }
 
-  // Stranka pro konfiguraci IR kodu
-  // 1) Zpracovani nastaveni IR kodu z prichoziho pozadavku
-  for (int i = 1; i <= 6; i++) {
-    String paramMethod = "channel" + String(i) + "_method=";
-    int mIndex = request.indexOf(paramMethod);
-    if (mIndex != -1) {
-      int start = mIndex + paramMethod.length();
-      int end   = request.indexOf('&', start);
-      if (end == -1) end = request.indexOf(' ', start);
-      String method = request.substring(start, end);
-      uint32_t newCode = 0;
-
-      if (method == "manual") {
-        String p = "code" + String(i) + "_manual=";
-        int ci = request.indexOf(p);
-        if (ci != -1) {
-          int s2 = ci + p.length();
-          int e2 = request.indexOf('&', s2);
-          if (e2 == -1) e2 = request.indexOf(' ', s2);
-          String codeStr = request.substring(s2, e2);
-          if (codeStr.length() > 8) codeStr = codeStr.substring(0, 8);
-          newCode = strtoul(codeStr.c_str(), NULL, 16);
-        }
-      } else if (method == "library") {
-        String pm = "code" + String(i) + "_library_manufacturer=";
-        String pd = "code" + String(i) + "_library_devicetype=";
-        String pc = "code" + String(i) + "_library_command=";
-        int im = request.indexOf(pm), id = request.indexOf(pd), ic = request.indexOf(pc);
-        if (im != -1 && id != -1 && ic != -1) {
-          int sm = im + pm.length();
-          int em = request.indexOf('&', sm);
-          if (em == -1) em = request.indexOf(' ', sm);
-          String manu = urldecode(request.substring(sm, em));
-
-          int sd = id + pd.length();
-          int ed = request.indexOf('&', sd);
-          if (ed == -1) ed = request.indexOf(' ', sd);
-          String devt = urldecode(request.substring(sd, ed));
-
-          int sc = ic + pc.length();
-          int ec = request.indexOf('&', sc);
-          if (ec == -1) ec = request.indexOf(' ', sc);
-          String cmd = urldecode(request.substring(sc, ec));
+  // "/cues" – cue list, chase a IR kódy GO/BACK/PAUSE
+  if (path == "/cues") {
+    if (*query) {
+      cueMode = (CueMode)constrain(atol(queryValue(query, "mode")), 0, 2);
+      const char *codeNames[3] = { "go", "back", "pause" };
+      for (int c = 0; c < 3; c++) {
+        cueIrCodes[c] = strtoul(queryValue(query, codeNames[c]), NULL, 16);
+        signalPostCmd(CMD_SET_CUE_IR_CODE, c, 0, cueIrCodes[c]);
+      }
 
-          newCode = getIRCodeFromLibrary(manu, devt, cmd);
-          if (newCode == 0) {
-            Serial.print("Neplatný výběr z knihovny pro kanál ");
-            Serial.println(i);
-          }
-        }
-      } else if (method == "learned") {
-        String p = "code" + String(i) + "_learned=";
-        int ci = request.indexOf(p);
-        if (ci != -1) {
-          int s2 = ci + p.length();
-          int e2 = request.indexOf('&', s2);
-          if (e2 == -1) e2 = request.indexOf(' ', s2);
-          String codeStr = request.substring(s2, e2);
-          newCode = strtoul(codeStr.c_str(), NULL, 16);
+      // seznam končí prvním cue bez scény
+      cueList.count = 0;
+      for (int i = 0; i < CUE_MAX_CUES; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "c%d_s", i + 1);
+        int scene = atol(queryValue(query, key));
+        if (scene < 1 || scene > 6) break;
+        Cue &c = cueList.cues[i];
+        c.scene  = scene - 1;
+        snprintf(key, sizeof(key), "c%d_f", i + 1);
+        c.fadeMs = constrain((long)(atof(queryValue(query, key)) * 1000), 0L, 65535L);
+        snprintf(key, sizeof(key), "c%d_w", i + 1);
+        c.waitMs = constrain((long)(atof(queryValue(query, key)) * 1000), 0L, 65535L);
+        cueList.count = i + 1;
+        signalPostCmd(CMD_SET_CUE, i, c.scene, ((uint32_t)c.fadeMs << 16) | c.waitMs);
+      }
+      signalPostCmd(CMD_SET_CUE_COUNT, cueList.count);
+
+      // kroky chase: "1,2,3,4"
+      const char *steps = queryValue(query, "steps");
+      chase.count = 0;
+      while (*steps && chase.count < CUE_MAX_STEPS) {
+        int scene = atoi(steps);
+        if (scene >= 1 && scene <= 6) {
+          chase.steps[chase.count] = scene - 1;
+          signalPostCmd(CMD_SET_CHASE_STEP, chase.count, scene - 1);
+          chase.count++;
         }
+        const char *comma = strchr(steps, ',');
+        if (!comma) break;
+        steps = comma + 1;
       }
+      chase.bpm     = constrain(atol(queryValue(query, "bpm")), 1, 600);
+      chase.fadePct = constrain(atol(queryValue(query, "cfade")), 0, 100);
+      signalPostCmd(CMD_SET_CHASE, chase.count, chase.fadePct, chase.bpm);
+      signalPostCmd(CMD_SET_CUE_MODE, cueMode);
 
-      if (newCode != 0) {
-        learnedIRCodes[i] = newCode;
-        char key[10];
-        sprintf(key, "ircode%d", i);
-        preferences.putUInt(key, newCode);
-        Serial.print("Kanál ");
-        Serial.print(i);
-        Serial.print(" aktualizován metodou ");
-        Serial.print(method);
-        Serial.print(" s kódem 0x");
-        Serial.println(newCode, HEX);
-      }
+      configSave();
     }
-  }
-
-  // 2) Vygenerovani HTML pro konfiguraci IR kodu (s tlacitkem na /scenes)
-  String html = "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
-  html += "<html><head><meta charset='UTF-8'><title>IR Code Config</title></head><body>";
-  html += "<button onclick=\"window.location='/scenes'\">DMX Scenes</button>";
-  html += "<h1>IR Code Configuration</h1>";
-  html += "<p>Zadejte IR kód (hex) nebo vyberte z nabídky pro daný DMX kanál, který bude vyslán při hodnotě 255.</p>";
-  html += "<form action='/' method='GET'>";
 
-  for (int i = 1; i <= 6; i++) {
-    html += "<div style='border:1px solid #ccc;padding:10px;margin-bottom:10px;'>";
-    html += "<h3>Kanál " + String(i) + "</h3>";
-    html += "<input type='radio' name='channel" + String(i) + "_method' value='manual' checked onclick='showOptions(" + String(i) + ")'> Manual ";
-    html += "<input type='radio' name='channel" + String(i) + "_method' value='library' onclick='showOptions(" + String(i) + ")'> Library ";
-    html += "<input type='radio' name='channel" + String(i) + "_method' value='learned' onclick='showOptions(" + String(i) + ")'> Learned <br>";
-
-    // Manualni vstup
-    html += "<div id='code_manual_" + String(i) + "'>";
-    html += "Manual: <input type='text' name='code" + String(i) + "_manual' value='";
-    char buf[9];
-    sprintf(buf, "%08X", learnedIRCodes[i]);
-    html += buf;
-    html += "'></div>";
-
-    // Vstupy z library
-    html += "<div id='code_library_" + String(i) + "' style='display:none;'>";
-    html += "Manufacturer: <select name='code" + String(i) + "_library_manufacturer' id='code_library_" + String(i) + "_manufacturer' onchange='updateDeviceType(" + String(i) + ")'>";
-    html += "<option value='Samsung'>Samsung</option>";
-    html += "<option value='LG'>LG</option>";
-    html += "<option value='Sony'>Sony</option>";
-    html += "<option value='Panasonic'>Panasonic</option>";
-    html += "<option value='Philips'>Philips</option>";
-    html += "<option value='Yamaha'>Yamaha</option>";
-    html += "<option value='Generic'>Air Conditioner</option>";
-    html += "</select><br>";
-    html += "Device Type: <select name='code" + String(i) + "_library_devicetype' id='code_library_" + String(i) + "_devicetype' onchange='updateCommand(" + String(i) + ")'>";
-    html += "<option value='TV'>TV</option>";
-    html += "</select><br>";
-    html += "Command: <select name='code" + String(i) + "_library_command' id='code_library_" + String(i) + "_command'></select>";
-    html += "</div>";
-
-    // Zvolení learned
-    html += "<div id='code_learned_" + String(i) + "' style='display:none;'>";
-    html += "Learned: <select name='code" + String(i) + "_learned'><option value='0'>None</option>";
-    for (int j = 1; j <= 6; j++) {
-      if (learnedIRCodes[j] != 0) {
-        char codeBuf[9];
-        sprintf(codeBuf, "%08X", learnedIRCodes[j]);
-        html += "<option value='" + String(codeBuf) + "'>Code " + String(j) + " (0x" + String(codeBuf) + ")</option>";
-      }
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>Cues</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>Cue List & Chase</h1>";
+    html += "<p>Platí v režimu IR to DMX. IR kód scény přepne na statickou scénu, GO pak pokračuje prolínáním z ní.</p>";
+    html += "<form method='GET' action='/cues'>";
+    html += "Režim: <select name='mode'>";
+    const char *modeNames[3] = { "Scenes only", "Cue list", "Chase" };
+    char row[192];
+    for (int m = 0; m < 3; m++) {
+      snprintf(row, sizeof(row), "<option value='%d'%s>%s</option>", m, cueMode == m ? " selected" : "", modeNames[m]);
+      html += row;
     }
-    html += "</select></div>";
-    html += "</div>";
-  }
-
-  // Odeslání a skripty
-  html += "<input type='submit' value='Uložit nastavení'></form>";
-  html += R"(
-<script>
-var libraryData = {
-  'Samsung': {
-    'TV': {
-      'Power': 'E0E040BF', 'Volume Up': 'E0E0E01F', 'Volume Down': 'E0E0D02F',
-      'Channel Up': 'E0E048B7', 'Channel Down': 'E0E008F7'
-    },
-    'Soundbar': {
-      'Power': 'E0E0F00F', 'Mute': 'E0E0D00F', 'Volume Up': 'E0E0E01F'
-    }
-  },
-  'LG': {
-    'TV': {
-      'Power': '20DF10EF', 'Volume Up': '20DF8877', 'Volume Down': '20DF9867',
-      'Input HDMI1': '20DF00FF'
-    }
-  },
-  'Sony': {
-    'TV': {
-      'Power': 'A90', 'Volume Up': '490', 'Volume Down': 'C90', 'Mute': '290'
-    }
-  },
-  'Panasonic': {
-    'TV': {
-      'Power': '4004', 'Volume Up': '400C', 'Volume Down': '400E'
-    },
-    'DVD': {
-      'Play': '500F', 'Pause': '5010', 'Stop': '500B'
-    }
-  },
-  'Philips': {
-    'TV': {
-      'Power': '30CF', 'Volume Up': '30DF', 'Volume Down': '30EF'
-    }
-  },
-  'Yamaha': {
-    'AV Receiver': {
-      'Power': 'A55A', 'Mute': 'A45A', 'Volume Up': 'A15E', 'Volume Down': 'A05E'
-    }
-  },
-  'Generic': {
-    'Air Conditioner': {
-      'Power': '20DF10EF', 'Temp Up': '20DF40BF', 'Temp Down': '20DF807F',
-      'Mode Cool': '20DFC03F', 'Mode Heat': '20DF20DF'
+    html += "</select><br><br>";
+
+    const char *codeLabels[3] = { "GO", "BACK", "PAUSE" };
+    const char *codeNames[3]  = { "go", "back", "pause" };
+    for (int c = 0; c < 3; c++) {
+      snprintf(row, sizeof(row), "%s IR kód (hex): <input type='text' name='%s' value='%08lX'><br>",
+               codeLabels[c], codeNames[c], (unsigned long)cueIrCodes[c]);
+      html += row;
     }
-  }
-};
+    snprintf(row, sizeof(row), "<small>Naposledy naučený kód: %08lX</small>", (unsigned long)lastLearnedCode);
+    html += row;
+
+    html += "<h3>Cue list</h3><table><tr><th>#</th><th>Scéna (1–6, prázdné = konec)</th><th>Fade [s]</th><th>Wait [s] (0 = GO)</th></tr>";
+    for (int i = 0; i < CUE_MAX_CUES; i++) {
+      const Cue &c = cueList.cues[i];
+      bool used = i < cueList.count;
+      char scene[4] = "";
+      if (used) snprintf(scene, sizeof(scene), "%u", c.scene + 1);
+      snprintf(row, sizeof(row), "<tr><td>%d</td><td><input type='number' name='c%d_s' min='1' max='6' value='%s' style='width:50px;'></td>",
+               i + 1, i + 1, scene);
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='number' name='c%d_f' min='0' max='65' step='0.1' value='%.1f' style='width:60px;'></td>",
+               i + 1, used ? c.fadeMs / 1000.0 : 0.0);
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='number' name='c%d_w' min='0' max='65' step='0.1' value='%.1f' style='width:60px;'></td></tr>",
+               i + 1, used ? c.waitMs / 1000.0 : 0.0);
+      html += row;
+    }
+    html += "</table>";
 
-function updateDeviceType(channel) {
-  var manu = document.getElementById('code_library_' + channel + '_manufacturer').value;
-  var devSelect = document.getElementById('code_library_' + channel + '_devicetype');
-  // Vynulovat všechny typy podle manu
-  var opts = "";
-  for (var dev in libraryData[manu]) {
-    opts += "<option value='" + dev + "'>" + dev + "</option>";
-  }
-  devSelect.innerHTML = opts;
-  updateCommand(channel);
-}
+    html += "<h3>Chase</h3>";
+    html += "Kroky (scény, např. 1,2,3,4): <input type='text' name='steps' value='";
+    for (int i = 0; i < chase.count; i++) {
+      snprintf(row, sizeof(row), "%s%u", i ? "," : "", chase.steps[i] + 1);
+      html += row;
+    }
+    html += "'><br>";
+    snprintf(row, sizeof(row), "BPM: <input type='number' name='bpm' min='1' max='600' value='%u' style='width:60px;'> ", chase.bpm);
+    html += row;
+    snprintf(row, sizeof(row), "Fade [%% kroku]: <input type='number' name='cfade' min='0' max='100' value='%u' style='width:50px;'><br><br>",
+             chase.fadePct);
+    html += row;
+    html += "<input type='submit' value='Save'></form>";
+    html += "</body></html>";
 
-function updateCommand(channel) {
-  var manu = document.getElementById('code_library_' + channel + '_manufacturer').value;
-  var dev  = document.getElementById('code_library_' + channel + '_devicetype').value;
-  var cmds = libraryData[manu][dev];
-  var options = "";
-  for (var k in cmds) {
-    options += "<option value='" + k + "'>" + k + " (0x" + cmds[k] + ")</option>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
   }
-  document.getElementById('code_library_' + channel + '_command').innerHTML = options;
-}
 
-function showOptions(channel) {
-  var m = document.querySelector('input[name="channel' + channel + '_method"]:checked').value;
-  document.getElementById('code_manual_'  + channel).style.display  = (m=='manual')  ? 'block':'none';
-  document.getElementById('code_library_' + channel).style.display  = (m=='library') ? 'block':'none';
-  document.getElementById('code_learned_' + channel).style.display  = (m=='learned') ? 'block':'none';
-  if (m=='library') updateDeviceType(channel);
-}
-</script>
-</body></html>
-)";
+  // "/merge" – priority zdrojů, LTP kanály, živé přepsání kanálů a benchmark slučování
+  if (path == "/merge") {
+    if (queryIs(query, "save", "1")) {
+      for (int s = 0; s < MERGE_SOURCES; s++) {
+        char key[16];
+        snprintf(key, sizeof(key), "prio%d", s);
+        const char *v = queryValue(query, key);
+        if (!*v) continue;
+        mergePriorities[s] = constrain(atol(v), 0, 255);
+        signalPostCmd(CMD_SET_MERGE_PRIORITY, s, mergePriorities[s]);
+      }
+      uint8_t bits[MERGE_CHANNELS / 8];
+      parseChannelRanges(queryValue(query, "ltp"), bits, MERGE_CHANNELS);
+      for (int ch = 0; ch < MERGE_CHANNELS; ch++) {
+        uint8_t m = 1 << (ch % 8);
+        if ((bits[ch / 8] & m) != (mergeLtpBits[ch / 8] & m)) {
+          signalPostCmd(CMD_SET_MERGE_LTP, (bits[ch / 8] & m) ? 1 : 0, 0, ch);
+        }
+      }
+      memcpy(mergeLtpBits, bits, sizeof(bits));
+      configSave();
+    }
+    const char *chStr = queryValue(query, "ch");
+    if (*chStr) {
+      int ch = atoi(chStr);
+      if (ch >= 1 && ch <= MERGE_CHANNELS) {
+        uint8_t v = constrain(atol(queryValue(query, "v")), 0, 255);
+        webLevels[ch - 1] = v;
+        webCovered[(ch - 1) / 8] |= 1 << ((ch - 1) % 8);
+        signalPostCmd(CMD_SET_WEB_LEVEL, 0, 0, ((uint32_t)(ch - 1) << 8) | v);
+      }
+    }
+    if (queryIs(query, "release", "1")) {
+      memset(webCovered, 0, sizeof(webCovered));
+      signalPostCmd(CMD_RELEASE_WEB);
+    }
+    if (queryIs(query, "bench", "1")) {
+      // běží v UI úloze na jádře 0 – signálovou cestu nezdrží
+      lastMergeBench = dmxMergeBench(1000, []() -> uint32_t { return micros(); });
+    }
 
-  client.print(html);
-  delay(1);
-  client.stop();
-  Serial.println("Client disconnected.");
+    const char *srcNames[MERGE_SOURCES] = { "IR scene", "Cue / chase", "Show playback", "Web override", "DMX input (Thru)" };
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>DMX Merge</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>DMX Merge</h1>";
+    html += "<p>Platí v režimech IR to DMX a DMX Thru. Kanál řídí zdroj s nejvyšší prioritou, který ho pokrývá; "
+            "při shodě priorit HTP (vyšší hodnota), u LTP kanálů poslední změna.</p>";
+    html += "<form method='GET' action='/merge'><input type='hidden' name='save' value='1'>";
+    for (int s = 0; s < MERGE_SOURCES; s++) {
+      char row[128];
+      snprintf(row, sizeof(row), "%s: <input type='number' name='prio%d' min='0' max='255' value='%u' style='width:60px;'><br>",
+               srcNames[s], s, mergePriorities[s]);
+      html += row;
+    }
+    html += "LTP kanály (např. 1-6,10): <input type='text' name='ltp' value='";
+    appendChannelRanges(html, mergeLtpBits, MERGE_CHANNELS);
+    html += "'><br>";
+    html += "<input type='submit' value='Save'></form>";
+
+    html += "<h3>Web override</h3><form method='GET' action='/merge'>";
+    html += "Kanál: <input type='number' name='ch' min='1' max='512' style='width:60px;'> ";
+    html += "Hodnota: <input type='number' name='v' min='0' max='255' style='width:60px;'> ";
+    html += "<input type='submit' value='Set'></form>";
+    html += "<button onclick=\"window.location='/merge?release=1'\">Release all</button><p>";
+    html += "Přepsané kanály: ";
+    appendChannelRanges(html, webCovered, MERGE_CHANNELS, "-");
+    html += "</p>";
+
+    html += "<h3>Benchmark (512 kanálů × 4 zdroje)</h3>";
+    html += "<button onclick=\"window.location='/merge?bench=1'\">Run</button>";
+    if (lastMergeBench.iterations) {
+      char line[96];
+      snprintf(line, sizeof(line), "<p>po bajtech %.2f µs, po slovech %.2f µs na rámec%s</p>",
+               (float)lastMergeBench.scalarUs / lastMergeBench.iterations,
+               (float)lastMergeBench.wordUs / lastMergeBench.iterations,
+               lastMergeBench.match ? "" : " – VÝSLEDKY SE LIŠÍ");
+      html += line;
+    }
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/curves" – výstupní křivky kanálů (gamma, kvadratická, vlastní, min/max, inverze)
+  if (path == "/curves") {
+    const char *msg = NULL;
+    if (queryIs(query, "save", "1")) {
+      // přiřazení podle rozsahů kanálů; kanál ve více profilech dostane ten poslední
+      memset(curveConfig.channelProfile, 0, sizeof(curveConfig.channelProfile));
+      for (int p = 1; p < CURVE_PROFILES; p++) {
+        CurveProfile &cp = curveConfig.profiles[p];
+        char key[16];
+        snprintf(key, sizeof(key), "t%d", p);
+        cp.type = (CurveType)constrain(atol(queryValue(query, key)), CURVE_LINEAR, CURVE_CUSTOM);
+        snprintf(key, sizeof(key), "g%d", p);
+        cp.gammaX10 = constrain((int)(atof(queryValue(query, key)) * 10 + 0.5f), 1, 255);
+        snprintf(key, sizeof(key), "lo%d", p);
+        cp.min = constrain(atol(queryValue(query, key)), 0, 255);
+        snprintf(key, sizeof(key), "hi%d", p);
+        cp.max = constrain(atol(queryValue(query, key)), 0, 255);
+        snprintf(key, sizeof(key), "inv%d", p);
+        cp.invert = queryIs(query, key, "1");
+        // body "0,10,,255": prázdná položka bod nemění
+        snprintf(key, sizeof(key), "pts%d", p);
+        const char *pts = queryValue(query, key);
+        for (int i = 0; i < CURVE_POINTS && pts; i++) {
+          const char *comma = strchr(pts, ',');
+          if (*pts && pts != comma) cp.points[i] = constrain(atol(pts), 0, 255);
+          pts = comma ? comma + 1 : NULL;
+        }
+        uint8_t bits[CURVE_CHANNELS / 8];
+        snprintf(key, sizeof(key), "ch%d", p);
+        parseChannelRanges(queryValue(query, key), bits, CURVE_CHANNELS);
+        for (int ch = 0; ch < CURVE_CHANNELS; ch++) {
+          if (bits[ch / 8] & (1 << (ch % 8))) curveConfig.channelProfile[ch] = p;
+        }
+      }
+      if (!signalSetCurves(curveConfig)) msg = "Signálová úloha nepřevzala předchozí změnu – zkus znovu.";
+      configSave();
+    }
+    if (queryIs(query, "bench", "1")) {
+      // běží v UI úloze na jádře 0 – signálovou cestu nezdrží
+      lastCurveBench = curveBench(100, []() -> uint32_t { return micros(); });
+    }
+
+    const char *typeNames[4] = { "Linear", "Gamma", "Square", "Custom" };
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>Output Curves</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>Output Curves</h1>";
+    html += "<p>Platí v režimech IR to DMX a DMX Thru. Výstup = min + křivka(vstup) × (max − min), inverze otočí křivku. "
+            "Vlastní křivka prochází body pro vstup 0, 64, 128, 192 a 255. Kanály bez profilu jdou ven beze změny.</p>";
+    if (msg) {
+      html += "<p><b>";
+      html += msg;
+      html += "</b></p>";
+    }
+    html += "<form method='GET' action='/curves'><input type='hidden' name='save' value='1'>";
+    html += "<table border='1' cellpadding='4'><tr><th>#</th><th>Typ</th><th>Gamma</th><th>Min</th><th>Max</th>"
+            "<th>Inv</th><th>Body (custom)</th><th>Kanály (např. 1-6,10)</th><th>0/64/128/192/255 &rarr;</th></tr>";
+    char row[160];
+    for (int p = 1; p < CURVE_PROFILES; p++) {
+      const CurveProfile &cp = curveConfig.profiles[p];
+      uint8_t bits[CURVE_CHANNELS / 8] = {0};
+      for (int ch = 0; ch < CURVE_CHANNELS; ch++) {
+        if (curveConfig.channelProfile[ch] == p) bits[ch / 8] |= 1 << (ch % 8);
+      }
+      snprintf(row, sizeof(row), "<tr><td>%d</td><td><select name='t%d'>", p, p);
+      html += row;
+      for (int t = 0; t < 4; t++) {
+        snprintf(row, sizeof(row), "<option value='%d'%s>%s</option>", t, cp.type == t ? " selected" : "", typeNames[t]);
+        html += row;
+      }
+      html += "</select></td>";
+      snprintf(row, sizeof(row), "<td><input type='text' name='g%d' value='%.1f' style='width:40px;'></td>", p, cp.gammaX10 / 10.0f);
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='number' name='lo%d' min='0' max='255' value='%u' style='width:50px;'></td>", p, cp.min);
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='number' name='hi%d' min='0' max='255' value='%u' style='width:50px;'></td>", p, cp.max);
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='checkbox' name='inv%d' value='1'%s></td>", p, cp.invert ? " checked" : "");
+      html += row;
+      snprintf(row, sizeof(row), "<td><input type='text' name='pts%d' value='", p);
+      html += row;
+      for (int i = 0; i < CURVE_POINTS; i++) {
+        snprintf(row, sizeof(row), "%s%u", i ? "," : "", cp.points[i]);
+        html += row;
+      }
+      snprintf(row, sizeof(row), "' style='width:120px;'></td><td><input type='text' name='ch%d' value='", p);
+      html += row;
+      appendChannelRanges(html, bits, CURVE_CHANNELS);
+      html += "'></td><td>";
+      const uint8_t probe[CURVE_POINTS] = { 0, 64, 128, 192, 255 };
+      for (int i = 0; i < CURVE_POINTS; i++) {
+        snprintf(row, sizeof(row), "%s%u", i ? "/" : "", curveValue(cp, probe[i]));
+        html += row;
+      }
+      html += "</td></tr>";
+    }
+    html += "</table><input type='submit' value='Save'></form>";
+
+    html += "<h3>Benchmark (512 kanálů, 7 profilů)</h3>";
+    html += "<button onclick=\"window.location='/curves?bench=1'\">Run</button>";
+    if (lastCurveBench.iterations) {
+      char line[160];
+      float lut = (float)lastCurveBench.lutUs / lastCurveBench.iterations;
+      snprintf(line, sizeof(line), "<p>tabulky %.2f µs (%.3f %% rámce 22,7 ms), přímý výpočet %.2f µs na rámec%s</p>",
+               lut, lut * 100 / 22700, (float)lastCurveBench.mathUs / lastCurveBench.iterations,
+               lastCurveBench.match ? "" : " – VÝSLEDKY SE LIŠÍ");
+      html += line;
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "<p>Výstup: poslední %lu µs, max %lu µs</p>",
+             (unsigned long)mergeStats.curveLastUs, (unsigned long)mergeStats.curveMaxUs);
+    html += line;
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/nudge" – IR akce pro posun skupin kanálů a master v IR→DMX
+  if (path == "/nudge") {
+    const char *msg = NULL;
+    if (queryIs(query, "save", "1")) {
+      for (int i = 0; i < NUDGE_ACTIONS; i++) {
+        NudgeAction &a = nudgeConfig.actions[i];
+        char key[16];
+        snprintf(key, sizeof(key), "code%d", i + 1);
+        a.code = strtoul(queryValue(query, key), NULL, 16);
+        snprintf(key, sizeof(key), "k%d", i + 1);
+        a.kind = (NudgeKind)constrain(atol(queryValue(query, key)), NUDGE_NONE, NUDGE_RESET);
+        snprintf(key, sizeof(key), "g%d", i + 1);
+        a.group = constrain(atol(queryValue(query, key)) - 1, 0, NUDGE_GROUPS - 1);
+      }
+      for (int g = 0; g < NUDGE_GROUPS; g++) {
+        char key[16];
+        snprintf(key, sizeof(key), "grp%d", g + 1);
+        parseChannelRanges(queryValue(query, key), nudgeConfig.groups[g], NUDGE_CHANNELS);
+      }
+      nudgeConfig.step = constrain(atol(queryValue(query, "step")), 1, 255);
+      nudgeConfig.rampStart = constrain(atol(queryValue(query, "rs")), 1, 2000);
+      nudgeConfig.rampMax = constrain(atol(queryValue(query, "rm")), 1, 2000);
+      nudgeConfig.accelMs = constrain((long)(atof(queryValue(query, "acc")) * 1000), 0L, 10000L);
+      if (!signalSetNudge(nudgeConfig)) msg = "Signálová úloha nepřevzala předchozí změnu – zkus znovu.";
+      configSave();
+    }
+
+    const char *kindNames[6] = { "-", "Group up", "Group down", "Master up", "Master down", "Reset" };
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>IR Nudge</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>IR Nudge</h1>";
+    html += "<p>Platí v režimech IR to DMX a DMX Thru. Stisk posune skupinu kanálů (nebo master celého výstupu) o jeden krok, "
+            "držené tlačítko jede rampou, která zrychluje. Posuny se přičítají ke sloučenému výstupu každý rámec; "
+            "výběr scény je smaže, master zůstává až do Reset nebo změny režimu.</p>";
+    if (msg) {
+      html += "<p><b>";
+      html += msg;
+      html += "</b></p>";
+    }
+    html += "<form method='GET' action='/nudge'><input type='hidden' name='save' value='1'>";
+    html += "<table border='1' cellpadding='4'><tr><th>#</th><th>IR kód (hex)</th><th>Akce</th><th>Skupina</th></tr>";
+    char row[192];
+    for (int i = 0; i < NUDGE_ACTIONS; i++) {
+      const NudgeAction &a = nudgeConfig.actions[i];
+      snprintf(row, sizeof(row), "<tr><td>%d</td><td><input type='text' name='code%d' value='%08lX' style='width:90px;'></td>"
+               "<td><select name='k%d'>", i + 1, i + 1, (unsigned long)a.code, i + 1);
+      html += row;
+      for (int k = 0; k < 6; k++) {
+        snprintf(row, sizeof(row), "<option value='%d'%s>%s</option>", k, a.kind == k ? " selected" : "", kindNames[k]);
+        html += row;
+      }
+      snprintf(row, sizeof(row), "</select></td><td><select name='g%d'>", i + 1);
+      html += row;
+      for (int g = 1; g <= NUDGE_GROUPS; g++) {
+        snprintf(row, sizeof(row), "<option%s>%d</option>", a.group == g - 1 ? " selected" : "", g);
+        html += row;
+      }
+      html += "</select></td></tr>";
+    }
+    html += "</table>";
+    snprintf(row, sizeof(row), "<small>Naposledy naučený kód: %08lX</small>", (unsigned long)lastLearnedCode);
+    html += row;
+
+    html += "<h3>Skupiny kanálů</h3>";
+    for (int g = 0; g < NUDGE_GROUPS; g++) {
+      snprintf(row, sizeof(row), "Skupina %d (např. 1-6,10): <input type='text' name='grp%d' value='", g + 1, g + 1);
+      html += row;
+      appendChannelRanges(html, nudgeConfig.groups[g], NUDGE_CHANNELS);
+      html += "'><br>";
+    }
+    html += "<h3>Rampa</h3>";
+    snprintf(row, sizeof(row), "Krok stisku: <input type='number' name='step' min='1' max='255' value='%u' style='width:60px;'><br>",
+             nudgeConfig.step);
+    html += row;
+    snprintf(row, sizeof(row), "Rychlost na začátku [hodnot/s]: <input type='number' name='rs' min='1' max='2000' value='%u' style='width:60px;'><br>",
+             nudgeConfig.rampStart);
+    html += row;
+    snprintf(row, sizeof(row), "Nejvyšší rychlost [hodnot/s]: <input type='number' name='rm' min='1' max='2000' value='%u' style='width:60px;'><br>",
+             nudgeConfig.rampMax);
+    html += row;
+    snprintf(row, sizeof(row), "Zrychlení za [s]: <input type='number' name='acc' min='0' max='10' step='0.1' value='%.1f' style='width:60px;'><br><br>",
+             nudgeConfig.accelMs / 1000.0);
+    html += row;
+    html += "<input type='submit' value='Save'></form>";
+
+    char line[96];
+    snprintf(line, sizeof(line), "<p>Master %u %%, posunuté kanály %u</p>",
+             (mergeStats.nudgeMaster * 100 + 127) / 255, mergeStats.nudgeChannels);
+    html += line;
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/config" – celá konfigurace jako jeden blob: GET = export, POST = import
+  if (path == "/config") {
+    if (isPost) {
+      handleConfigImport(client);
+      return;
+    }
+    static DeviceConfig cfg;
+    static uint8_t blob[CONFIG_MAX_SIZE];
+    configCollect(cfg);
+    size_t len = configSerialize(cfg, blob, sizeof(blob));
+    client.printf("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                  "Content-Disposition: attachment; filename=\"dmxir-config.bin\"\r\n"
+                  "Content-Length: %u\r\n\r\n", (unsigned)len);
+    client.write(blob, len);
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/irimport" – hromadný import IR kódů (Pronto hex, LIRC .conf) do knihovny
+  if (path == "/irimport") {
+    if (isPost) {
+      handleIrImport(client, queryIs(query, "replace", "1"));
+      return;
+    }
+    if (queryIs(query, "clear", "1")) {
+      irLibraryCount = 0;
+      irLibrarySave();
+    }
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>IR Import</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>IR code import</h1>";
+    html += "<p>Soubor Pronto hex (jeden kód na řádek, volitelně se jménem: <i>Power: 0000 006D …</i>) nebo LIRC .conf. "
+            "Převádějí se 32bitové kódy NEC a podobné (Samsung); ostatní protokoly se jen spočítají. "
+            "Importované kódy pak jdou vybrat u kanálu na stránce IR kódů.</p>";
+    html += "<input type='file' id='f'> <label><input type='checkbox' id='rep'> nahradit knihovnu</label> "
+            "<button onclick='up()'>Upload</button><pre id='r'></pre>";
+    html += "<script>function up(){var f=document.getElementById('f').files[0];if(!f)return;"
+            "var q=document.getElementById('rep').checked?'?replace=1':'';"
+            "fetch('/irimport'+q,{method:'POST',body:f}).then(r=>r.text()).then(t=>document.getElementById('r').innerText=t);}</script>";
+    if (lastIrImport.stats.bytes) {
+      char line[160];
+      snprintf(line, sizeof(line), "<p>Poslední import: %u příkazů, převedeno %u, nepodporováno %u, %lu B za %lu ms</p>",
+               lastIrImport.stats.commands, lastIrImport.stats.converted, lastIrImport.stats.unsupported,
+               (unsigned long)lastIrImport.stats.bytes, (unsigned long)lastIrImport.totalMs);
+      html += line;
+    }
+    char row[96];
+    snprintf(row, sizeof(row), "<h3>Knihovna (%u/%u)</h3><table border='1' cellpadding='4'>", irLibraryCount, IR_LIB_MAX);
+    html += row;
+    for (int i = 0; i < irLibraryCount; i++) {
+      snprintf(row, sizeof(row), "<tr><td>%s</td><td>0x%08lX</td></tr>", irLibrary[i].name, (unsigned long)irLibrary[i].code);
+      html += row;
+    }
+    html += "</table><br><button onclick=\"window.location='/irimport?clear=1'\">Clear library</button>";
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/api/irlib" – importované kódy pro výběr u kanálu (app.js)
+  if (path == "/api/irlib") {
+    ArenaText body(reqArena, clientSink, &client);
+    body += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-store\r\n\r\n{\"codes\":[";
+    for (int i = 0; i < irLibraryCount; i++) {
+      char entry[IR_IMPORT_NAME + 32];
+      snprintf(entry, sizeof(entry), "%s{\"name\":\"%s\",\"code\":\"%08lX\"}", i ? "," : "",
+               irLibrary[i].name, (unsigned long)irLibrary[i].code);
+      body += entry;
+    }
+    body += "]}";
+    body.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/backup" – stažení a nahrání konfigurace z prohlížeče
+  if (path == "/backup") {
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>Backup</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>Configuration backup</h1>";
+    html += "<p><a href='/config'>Download configuration</a></p>";
+    html += "<p>Nahrání přepíše IR kódy, scény, cue list, chase i nastavení slučování a převodník se restartuje.</p>";
+    html += "<input type='file' id='f'> <button onclick='up()'>Upload</button><p id='r'></p>";
+    html += "<script>function up(){var f=document.getElementById('f').files[0];if(!f)return;"
+            "fetch('/config',{method:'POST',body:f}).then(r=>r.text()).then(t=>document.getElementById('r').innerText=t);}</script>";
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/metrics" – textové metriky (jeden řádek = jedna hodnota);
+  // ?log=0..4 nastaví úroveň logu za běhu (0 = nic, 4 = debug, viz log.h)
+  if (path == "/metrics") {
+    const char *lvl = queryValue(query, "log");
+    if (*lvl) logSetLevel(constrain(atoi(lvl), LOG_LEVEL_NONE, LOG_LEVEL));
+    ArenaText body(reqArena, clientSink, &client);
+    body += "HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=UTF-8\r\n\r\n";
+    appendDmxMetrics(body);
+    appendBootMetrics(body);
+    body.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/heap" – halda za provozu: teď a historie po HEAP_SAMPLE_MS (heap_monitor.h)
+  if (path == "/heap") {
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>Heap</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>Heap</h1>";
+    char line[160];
+    HeapSample now = heapSampleNow(millis());
+    snprintf(line, sizeof(line), "<p>Volno %lu B, největší blok %lu B, fragmentace %u %%, minimum od startu %lu B, selhané alokace %lu</p>",
+             (unsigned long)now.freeBytes, (unsigned long)now.largestBlock, heapFragPct(now),
+             (unsigned long)now.minFree, (unsigned long)heapFailedAllocs());
+    html += line;
+    const ReqArenaStats &ra = reqArena.stats();
+    snprintf(line, sizeof(line), "<p>HTTP aréna %u B: požadavků %lu, nejvíc %lu B, nevešlo se %lu, průběžně odesláno %lu×</p>",
+             REQ_ARENA_SIZE, (unsigned long)ra.requests, (unsigned long)ra.highWater,
+             (unsigned long)ra.failed, (unsigned long)ra.flushes);
+    html += line;
+    html += "<h3>Historie (po 10 min, nejnovější nahoře)</h3><table border='1' cellpadding='4'>"
+            "<tr><th>Uptime</th><th>Volno [B]</th><th>Největší blok [B]</th><th>Fragmentace</th><th>Minimum [B]</th></tr>";
+    for (size_t i = heapHistoryCount(); i-- > 0; ) {
+      HeapSample h = heapHistoryAt(i);
+      snprintf(line, sizeof(line), "<tr><td>%lu:%02lu</td><td>%lu</td><td>%lu</td><td>%u %%</td><td>%lu</td></tr>",
+               (unsigned long)(h.uptimeS / 3600), (unsigned long)(h.uptimeS / 60 % 60),
+               (unsigned long)h.freeBytes, (unsigned long)h.largestBlock, heapFragPct(h), (unsigned long)h.minFree);
+      html += line;
+    }
+    html += "</table></body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/trace.json" – posledních TRACE_EVENTS událostí pro chrome://tracing / Perfetto (trace.h)
+  if (path == "/trace.json") {
+    client.print("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                 "Content-Disposition: attachment; filename=\"dmxir-trace.json\"\r\n"
+                 "Connection: close\r\n\r\n");
+    traceWriteJson(client);
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/dmx" – poslední zveřejněný rámec (vstup v DMX→IR, výstup v IR→DMX);
+  // ?since=<seq> nic neposílá, pokud se od rámce seq nic nezměnilo
+  if (path == "/dmx") {
+    const DmxFrame &frame = dmxFrames.acquire();
+    ArenaText body(reqArena, clientSink, &client);
+    body += "HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=UTF-8\r\n\r\n";
+    char line[96];
+    snprintf(line, sizeof(line), "seq %lu\nts_us %lu\nslots %u\nchanged_seq %lu\n",
+             (unsigned long)frame.seq, (unsigned long)frame.timestampUs, frame.length,
+             (unsigned long)frame.changedSeq);
+    body += line;
+    // ?since=<seq>: monitor, který už rámec má, dostane jen hlavičku
+    const char *since = queryValue(query, "since");
+    if (*since && frame.changedSeq <= strtoul(since, NULL, 10)) {
+      body += "unchanged\n";
+      body.flush();
+      delay(1);
+      client.stop();
+      return;
+    }
+    for (int ch = 1; ch < frame.length; ch++) {
+      snprintf(line, sizeof(line), "%u%c", frame.slots[ch], (ch % 16 == 0) ? '\n' : ' ');
+      body += line;
+    }
+    body += "\n";
+    body.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/show.dmxs" – stažení záznamu (formát viz show_format.h, tools/show_dump.py)
+  if (path == "/show.dmxs") {
+    File f;
+    if (showState() != SHOW_RECORDING) f = LittleFS.open(SHOW_FILE_PATH, "r");
+    if (!f) {
+      client.print("HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\n\r\nno show recorded (or recording in progress)\n");
+      delay(1);
+      client.stop();
+      return;
+    }
+    client.printf("HTTP/1.1 200 OK\r\nContent-Type: application/octet-stream\r\n"
+                  "Content-Length: %u\r\n\r\n", (unsigned)f.size());
+    uint8_t buf[512];
+    size_t n;
+    while ((n = f.read(buf, sizeof(buf))) > 0) client.write(buf, n);
+    f.close();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/show" – záznam (DMX→IR vstup) a přehrávání (IR→DMX výstup)
+  //   ?rec=1 / ?play=1 / ?stop=1
+  if (path == "/show") {
+    if (strstr(query, "rec=1"))       showRecordStart();
+    else if (strstr(query, "play=1")) showPlayStart();
+    else if (strstr(query, "stop=1")) showStop();
+
+    static const char *stateNames[] = { "idle", "recording", "playing" };
+    ArenaText html(reqArena, clientSink, &client);
+    html += "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=UTF-8\r\n\r\n";
+    html += "<html><head><meta charset='UTF-8'><title>DMX Show</title></head><body>";
+    html += "<button onclick=\"window.location='/'\">&larr; Back to IR Codes</button>";
+    html += "<h1>DMX Show</h1>";
+    char row[96];
+    snprintf(row, sizeof(row), "<p>Stav: %s, soubor: %lu B</p>", stateNames[showState()], (unsigned long)showFileSize());
+    html += row;
+    html += "<p>Záznam běží v režimu DMX to IR, přehrávání v režimu IR to DMX.</p>";
+    html += "<button onclick=\"window.location='/show?rec=1'\">Record</button> ";
+    html += "<button onclick=\"window.location='/show?play=1'\">Play</button> ";
+    html += "<button onclick=\"window.location='/show?stop=1'\">Stop</button> ";
+    html += "<a href='/show.dmxs'>Download</a>";
+    html += "</body></html>";
+    html.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // "/api/ircodes" – uložené kódy kanálů 1..6 pro stránku IR kódů (app.js)
+  if (path == "/api/ircodes") {
+    ArenaText body(reqArena, clientSink, &client);
+    body += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-store\r\n\r\n{\"codes\":[";
+    for (int i = 1; i <= 6; i++) {
+      char code[12];
+      snprintf(code, sizeof(code), "%s\"%08lX\"", i > 1 ? "," : "", (unsigned long)learnedIRCodes[i]);
+      body += code;
+    }
+    body += "]}";
+    body.flush();
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // Stranka pro konfiguraci IR kodu
+  // 1) Zpracovani nastaveni IR kodu z prichoziho pozadavku
+  bool irCodesChanged = false;
+  for (int i = 1; i <= 6; i++) {
+    char key[40];
+    snprintf(key, sizeof(key), "channel%d_method", i);
+    const char *method = queryValue(query, key);
+    if (*method) {
+      uint32_t newCode = 0;
+
+      if (strcmp(method, "manual") == 0) {
+        char codeStr[9] = {0};   // nejvýš 8 hex číslic
+        snprintf(key, sizeof(key), "code%d_manual", i);
+        strncpy(codeStr, queryValue(query, key), 8);
+        newCode = strtoul(codeStr, NULL, 16);
+      } else if (strcmp(method, "library") == 0) {
+        snprintf(key, sizeof(key), "code%d_library_manufacturer", i);
+        const char *manu = queryValue(query, key);
+        snprintf(key, sizeof(key), "code%d_library_devicetype", i);
+        const char *devt = queryValue(query, key);
+        snprintf(key, sizeof(key), "code%d_library_command", i);
+        const char *cmd  = queryValue(query, key);
+        if (*manu && *devt && *cmd) {
+          newCode = getIRCodeFromLibrary(manu, devt, cmd);
+          if (newCode == 0) {
+            LOG_W("Neplatný výběr z knihovny pro kanál %d", i);
+          }
+        }
+      } else if (strcmp(method, "learned") == 0 || strcmp(method, "imported") == 0) {
+        snprintf(key, sizeof(key), "code%d_%s", i, method);
+        newCode = strtoul(queryValue(query, key), NULL, 16);
+      }
+
+      if (newCode != 0) {
+        learnedIRCodes[i] = newCode;
+        signalPostCmd(CMD_SET_IR_CODE, i, 0, newCode);
+        irCodesChanged = true;
+        LOG_I("Kanál %d aktualizován metodou %s s kódem 0x%08lX", i, method, (unsigned long)newCode);
+      }
+    }
+  }
+
+  if (irCodesChanged) configSave();
+
+  // 2) Po uložení zpět na stránku (reload formulář znovu neodešle)
+  if (*query) {
+    client.print("HTTP/1.1 303 See Other\r\nLocation: /\r\n\r\n");
+    delay(1);
+    client.stop();
+    return;
+  }
+
+  // 3) Statické soubory z web/ (gzip ve flash); "/" i neznámá cesta = stránka IR kódů
+  const WebAsset *asset = webAssetFind(path.c_str());
+  if (!asset) asset = webAssetFind("/index.html");
+  serveWebAsset(client, *asset, readRequestHeader(client, "if-none-match"));
 }
 
 
+void uiTask(void *);
+
 //
 // setup() – inicializace modulů, načtení uložených IR kódů, spuštění WiFi AP a serveru
 //
 void setup() {
-  Serial.begin(115200, SERIAL_8N1, 34, 1);
-  delay(1000);
-  Serial.println("Terminál (UART0) přemapován: RX na GPIO34, TX na GPIO1");
+  bootMark(BOOT_SETUP);
+  // na terminál se nečeká – souhrn startu vypíše bootReport(), až doběhne WiFi
+  // hromadný upload po sériovém protokolu přijde rychleji, než ho UI úloha čte
+  Serial.setRxBufferSize(SERIAL_RX_BUFFER);
+  Serial.begin(SERIAL_PROTO_BAUD, SERIAL_8N1, 34, 1);
+  logBegin();
+  heapMonitorBegin();
+  LOG_I("Terminál (UART0) přemapován: RX na GPIO34, TX na GPIO1");
   
   pinMode(MAX485_CTRL_PIN, OUTPUT);
   digitalWrite(MAX485_CTRL_PIN, HIGH);
   
-  initDMXTransciever();
-  
-  irrecv.enableIRIn();
-  Serial.println("IR přijímač inicializován na pinu 16");
-  
-  display.begin(SH1106_SWITCHCAPVCC, SCREEN_ADDRESS);
-  Wire.beginTransmission(SCREEN_ADDRESS);
-  Wire.write(0x00);
-  Wire.write(0x81);
-  Wire.write(0xFF);
-  Wire.endTransmission();
-  
-  display.clearDisplay();
-  display.setTextSize(2);
-  display.setTextColor(WHITE);
-  display.setCursor(15, 5);
-  display.println("DMX<->IR");
-  display.display();
-  delay(1000);
-  display.clearDisplay();
-  
-  WiFi.softAP(ssid, password);
-  Serial.println("Access Point spuštěn");
-  Serial.print("AP IP adresa: ");
-  Serial.println(WiFi.softAPIP());
-  server.begin();
-  
+  // DMX a IR instalujeme tady (loopTask na jádře 1), jejich ISR tak běží
+  // na stejném jádře jako signálová úloha
+  installDmxDriver();
   pinMode(18, INPUT_PULLDOWN);
-  
-  encoder.attachHalfQuad(ENCODER_PIN_A, ENCODER_PIN_B);
-  resetEncoder();
-  updateMenuBaseline();
-  
-  pinMode(ENCODER_BTN_PIN, INPUT_PULLUP);
-  
-  menuMode = true;
-  menuLevel = 0;
-  updateMenuBaseline();
-  drawMenu();
-  
-  irsend.begin();
+  bootMark(BOOT_SIGNAL_IO);
   
   preferences.begin("irlearn", false);
-  for (int i = 1; i <= 6; i++) {
-    char key[10];
-    sprintf(key, "ircode%d", i);
-    learnedIRCodes[i] = preferences.getUInt(key, 0);
-    Serial.print("Načten IR kód pro kanál ");
-    Serial.print(i);
-    Serial.print(": 0x");
-    Serial.println(learnedIRCodes[i], HEX);
+  sceneBankBegin();
+  configLoad();
+  irLibraryLoad();
+  scenesFromBank();
+  bootMode = (AppMode)preferences.getUChar("mode", MODE_MENU);
+  if (!isSignalMode(bootMode)) bootMode = MODE_MENU;
+  bootMark(BOOT_CONFIG);
+
+  // Signálová úloha (DMX/IR) na jádře 1 – startuje hned, v obnoveném režimu.
+  // Displej, LittleFS a WiFi dokončí UI úloha na jádře 0 (uiBegin()).
+  signalInitConfig(learnedIRCodes, scenes);
+  signalInitCues(cueList, chase, cueMode, cueIrCodes);
+  signalInitMerge(mergePriorities, mergeLtpBits);
+  signalInitCurves(curveConfig);
+  signalInitNudge(nudgeConfig);
+  if (bootMode != MODE_MENU) signalPostCmd(CMD_SET_MODE, signalModeFor(bootMode));
+  signalTaskStart();
+
+  inputBegin();
+  xTaskCreatePinnedToCore(uiTask, "ui", 8192, NULL, UI_TASK_PRIORITY, NULL, UI_TASK_CORE);
+}
+
+//
+// Stisk tlačítka v menu – potvrzení vybrané položky
+//
+void handleMenuPress() {
+  LOG_D("Tlačítko stisknuto v menu");
+  if (menuLevel == 0) {
+    if (menuIndexMain == 0) {
+      LOG_I("Vybráno: DMX to IR");
+      enterSignalMode(MODE_DMX_TO_IR, true);
+    } else if (menuIndexMain == 1) {
+      LOG_I("Vybráno: IR to DMX");
+      enterSignalMode(MODE_IR_TO_DMX, true);
+    } else if (menuIndexMain == 2) {
+      // Při výběru IR Learn z hlavního menu přejdeme do submenu a resetujeme index
+      menuLevel = 2;
+      menuIndexIRLearn = 0;
+      updateMenuBaseline();
+      drawMenu();
+      LOG_I("Vybráno: IR Learn (submenu)");
+    } else if (menuIndexMain == 3) {
+      menuLevel = 1;
+      updateMenuBaseline();
+      drawMenu();
+      LOG_I("Vybráno: Settings");
+    } else if (menuIndexMain == 4) {
+      LOG_I("Vybráno: DMX Thru");
+      enterSignalMode(MODE_DMX_THRU, true);
+    }
+  }
+  else if (menuLevel == 1) {
+    if (menuIndexSettings == 0 && wifiReady) {
+      wifiAPEnabled = !wifiAPEnabled;
+      if (wifiAPEnabled) {
+        WiFi.softAP(ssid, password);
+        LOG_I("WiFi AP zapnut");
+      } else {
+        WiFi.softAPdisconnect(true);
+        LOG_I("WiFi AP vypnut");
+      }
+      drawMenu();
+    } else if (menuIndexSettings == 1) {
+      menuLevel = 0;
+      updateMenuBaseline();
+      drawMenu();
+      LOG_I("Návrat z Settings");
+    }
+  }
+  else if (menuLevel == 2) {
+    if (menuIndexIRLearn < 6) {
+      // Přechod do IR Learn režimu až po uvolnění a následném stisku tlačítka
+      irLearnPos = menuIndexIRLearn;
+      activeMode = MODE_IR_LEARN;
+      menuLevel = 3;
+      menuMode = false;
+      irLearnStartTime = millis();
+      updateMenuBaseline();
+      drawMenu();
+      signalPostCmd(CMD_SET_MODE, SIG_IR_LEARN);
+      LOG_I("Nastavuji IR Learn pro pozici %d", irLearnPos + 1);
+    } else {
+      menuLevel = 0;
+      updateMenuBaseline();
+      menuIndexIRLearn = 0;
+      drawMenu();
+      LOG_I("Návrat z IR Learn");
+    }
   }
+}
 
-  // Načtení uložených DMX scén
-  for (int i = 0; i < 6; i++) {
-    char key[12];
-    sprintf(key, "scene%d", i + 1);
-    size_t len = preferences.getBytes(key, scenes[i], sizeof(scenes[i]));
-    Serial.printf("Načtena scéna %d: načteno %u bajtů, první kanál = %d\n",
-                  i + 1, (unsigned)len, scenes[i][0]);
+//
+// Binární protokol na UART0 (serial_proto.h) – obsluhuje ho UI úloha mezi
+// webem a menu. Odpovědi i proud metrik jdou jedním Serial.write(), takže se
+// s řádky logu nepromíchají uvnitř rámce.
+//
+void serialSend(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len) {
+  static uint8_t out[SERIAL_PROTO_ENCODED_MAX];
+  size_t n = serialFrameEncode(type, seq, payload, len, out, sizeof(out));
+  if (!n) return;
+  Serial.write(out, n);
+  serialTxFrames++;
+}
+
+void serialNak(uint8_t seq, uint8_t type, SerialNak code) {
+  uint8_t p[2] = { code, type };
+  serialSend(SP_NAK, seq, p, sizeof(p));
+}
+
+void serialSendMetrics() {
+  const DmxStatsSnapshot &st = uiDmxStats;
+  const IrRxStats &ir = irRxStats();
+  SerialMetrics m;
+  m.uptimeMs        = millis();
+  m.mode            = activeMode;
+  m.signalPresent   = st.signalPresent;
+  m.framesPerSec    = st.framesPerSec;
+  m.errorsPerSec    = st.errorsPerSec;
+  m.lastSlots       = st.lastSlots;
+  m.framesTotal     = st.framesTotal;
+  m.framesPublished = dmxFrames.publishedCount();
+  m.framesUnchanged = dmxFrames.unchangedCount();
+  m.uartErrors      = st.uartErrors;
+  m.signalLosses    = st.signalLosses;
+  m.intervalMaxUs   = st.intervalMaxUs;
+  m.jitterUs        = st.jitterUs;
+  m.mergeLastUs     = mergeStats.lastUs;
+  m.mergeMaxUs      = mergeStats.maxUs;
+  m.mergeChannels   = mergeStats.channels;
+  m.curveLastUs     = mergeStats.curveLastUs;
+  m.irDecoded       = ir.decoded;
+  m.irRepeats       = ir.repeats;
+  m.logDropped      = logStats().dropped;
+  m.freeHeap        = ESP.getFreeHeap();
+  uint8_t p[SERIAL_METRICS_SIZE];
+  serialSend(SP_METRICS, serialStreamSeq++, p, serialMetricsEncode(m, p));
+}
+
+void serialHandleFrame() {
+  static uint8_t buf[SERIAL_PROTO_MAX_PAYLOAD];
+  uint8_t type = serialRx.type(), seq = serialRx.seq();
+  const uint8_t *in = serialRx.payload();
+  uint16_t len = serialRx.length();
+  uint8_t reply = type | SP_REPLY;
+
+  switch (type) {
+    case SP_PING:
+      buf[0] = SERIAL_PROTO_VERSION;
+      spPut16(buf + 1, SERIAL_PROTO_MAX_PAYLOAD);
+      spPut32(buf + 3, millis());
+      serialSend(reply, seq, buf, 7);
+      return;
+
+    case SP_GET_CONFIG: {
+      static DeviceConfig cfg;
+      configCollect(cfg);
+      serialSend(reply, seq, buf, configSerialize(cfg, buf, sizeof(buf)));
+      return;
+    }
+
+    case SP_SET_CONFIG: {
+      // stejně jako POST /config: ověřit, uložit, potvrdit a restartovat
+      const char *result = configStoreBlob(in, len);
+      if (result) {
+        LOG_W("Sériový import konfigurace odmítnut: %s", result);
+        serialNak(seq, type, SP_NAK_FAILED);
+        return;
+      }
+      serialSend(reply, seq, NULL, 0);
+      LOG_I("Konfigurace importována po sériové lince – restart");
+      logFlush(200);
+      ESP.restart();
+      return;
+    }
+
+    case SP_GET_SCENES:
+      buf[0] = 6;
+      buf[1] = 64;
+      memcpy(buf + 2, scenes, sizeof(scenes));
+      serialSend(reply, seq, buf, 2 + sizeof(scenes));
+      return;
+
+    case SP_SET_SCENES: {
+      if (len != 2 + sizeof(scenes) || in[0] != 6 || in[1] != 64) break;
+      bool changed = false;
+      for (int sc = 0; sc < 6; sc++) {
+        for (int ch = 0; ch < 64; ch++) {
+          uint8_t v = in[2 + sc * 64 + ch];
+          if (scenes[sc][ch] == v) continue;
+          scenes[sc][ch] = v;
+          changed = true;
+          if (!sceneBankMapped()) signalPostCmd(CMD_SET_SCENE_VALUE, sc, ch, v);
+        }
+      }
+      if (changed) configSave();
+      if (changed && sceneBankMapped()) {
+        if (!sceneBankWrite(&scenes[0][0], SIGNAL_SCENES, SIGNAL_SCENE_CH)) {
+          serialNak(seq, type, SP_NAK_FAILED);
+          return;
+        }
+        signalPostCmd(CMD_SCENE_BANK_SWAP);
+      }
+      serialSend(reply, seq, NULL, 0);
+      return;
+    }
+
+    case SP_GET_IR: {
+      uint8_t *p = buf;
+      for (int i = 1; i <= 6; i++, p += 4) spPut32(p, learnedIRCodes[i]);
+      *p++ = irLibraryCount;
+      for (int i = 0; i < irLibraryCount; i++) {
+        memcpy(p, irLibrary[i].name, IR_IMPORT_NAME);
+        spPut32(p + IR_IMPORT_NAME, irLibrary[i].code);
+        p += IR_IMPORT_NAME + 4;
+      }
+      serialSend(reply, seq, buf, p - buf);
+      return;
+    }
+
+    case SP_SET_IR: {
+      if (len < 25 || in[24] > IR_LIB_MAX || len != 25 + in[24] * (IR_IMPORT_NAME + 4)) break;
+      for (int i = 1; i <= 6; i++) {
+        uint32_t code = spGet32(in + (i - 1) * 4);
+        if (learnedIRCodes[i] == code) continue;
+        learnedIRCodes[i] = code;
+        signalPostCmd(CMD_SET_IR_CODE, i, 0, code);
+      }
+      irLibraryCount = in[24];
+      const uint8_t *p = in + 25;
+      for (int i = 0; i < irLibraryCount; i++, p += IR_IMPORT_NAME + 4) {
+        char name[IR_IMPORT_NAME];
+        memcpy(name, p, IR_IMPORT_NAME - 1);
+        name[IR_IMPORT_NAME - 1] = 0;
+        irLibrarySetName(irLibrary[i], name);
+        irLibrary[i].code = spGet32(p + IR_IMPORT_NAME);
+      }
+      if (irLibrarySave() && configSave()) serialSend(reply, seq, NULL, 0);
+      else serialNak(seq, type, SP_NAK_FAILED);
+      return;
+    }
+
+    case SP_INJECT:
+      if (len > MERGE_CHANNELS) break;
+      // živý rámec: když signálová úloha nestihla převzít předchozí, tenhle se zahodí
+      if (!signalInjectFrame(in, len)) {
+        serialNak(seq, type, SP_NAK_BUSY);
+        return;
+      }
+      memcpy(webLevels, in, len);
+      memset(webCovered, 0, sizeof(webCovered));
+      for (uint16_t ch = 0; ch < len; ch++) webCovered[ch / 8] |= 1 << (ch % 8);
+      serialSend(reply, seq, NULL, 0);
+      return;
+
+    case SP_GET_FRAME: {
+      const DmxFrame &frame = dmxFrames.acquire();
+      spPut32(buf, frame.seq);
+      memcpy(buf + 4, frame.slots, frame.length);
+      serialSend(reply, seq, buf, 4 + frame.length);
+      return;
+    }
+
+    case SP_STREAM:
+      if (len != 2) break;
+      serialStreamMs = spGet16(in);
+      serialStreamLast = millis();
+      serialSend(reply, seq, NULL, 0);
+      return;
+
+    default:
+      serialNak(seq, type, SP_NAK_UNKNOWN);
+      return;
+  }
+  serialNak(seq, type, SP_NAK_LENGTH);
+}
+
+void handleSerialProto() {
+  static uint8_t chunk[128];
+  int avail;
+  while ((avail = Serial.available()) > 0) {
+    size_t n = Serial.readBytes(chunk, min(avail, (int)sizeof(chunk)));
+    for (size_t i = 0; i < n; i++) {
+      if (serialRx.push(chunk[i])) serialHandleFrame();
+    }
+  }
+  if (serialStreamMs && millis() - serialStreamLast >= serialStreamMs) {
+    serialStreamLast = millis();
+    serialSendMetrics();
   }
 }
 
 //
-// loop() – hlavní smyčka: obsluha DMX/IR režimů a webového serveru
+// Události z enkodéru a tlačítka
 //
-void loop() {
-  // Aktualizujeme stav tlačítka – pokud je tlačítko uvolněno, nastavíme flag buttonReady
-  if (digitalRead(ENCODER_BTN_PIN) == HIGH) {
-    buttonReady = true;
+void handleInputEvents() {
+  InputEvent in;
+  while (inputQueue.pop(in)) {
+    switch (in.type) {
+      case INPUT_ROTATE:
+        if (menuMode) menuPos += in.delta;
+        break;
+      case INPUT_LONG_PRESS:
+        returnToMenu();
+        break;
+      case INPUT_PRESS:
+        if (menuMode) handleMenuPress();
+        else returnToMenu();
+        break;
+    }
   }
-  
-  handleWiFiServer();
+}
+
+//
+// uiLoop() – jeden průchod UI úlohy: vstupy, webový server, menu a kreslení podle událostí
+//
+void uiLoop() {
+  handleInputEvents();
+  handleSignalEvents();
+  handleSerialProto();
+  if (wifiReady) handleWiFiServer();
+  heapMonitorTick(millis());
 
   if (menuMode) {
     int newIndex;
     if (menuLevel == 0) {
-      newIndex = getRelativeIndex(4);
+      newIndex = getRelativeIndex(MAIN_MENU_ITEMS);
       if (newIndex != menuIndexMain) {
         menuIndexMain = newIndex;
         drawMenu();
-        Serial.print("Main menu index: ");
-        Serial.println(menuIndexMain);
       }
     }
     else if (menuLevel == 1) {
@@ -955,8 +2273,6 @@ void loop() {
       if (newIndex != menuIndexSettings) {
         menuIndexSettings = newIndex;
         drawMenu();
-        Serial.print("Settings menu index: ");
-        Serial.println(menuIndexSettings);
       }
     }
     else if (menuLevel == 2) {
@@ -964,101 +2280,83 @@ void loop() {
       if (newIndex != menuIndexIRLearn) {
         menuIndexIRLearn = newIndex;
         drawMenu();
-        Serial.print("IR Learn submenu index: ");
-        Serial.println(menuIndexIRLearn);
       }
     }
-    
-    if (digitalRead(ENCODER_BTN_PIN) == LOW && buttonReady && (millis() - lastButtonTime > debounceDelay)) {
-      lastButtonTime = millis();
-      buttonReady = false; // Zablokujeme opakované zpracování, dokud tlačítko nebude uvolněno
-      Serial.println("Tlačítko stisknuto v menu!");
-      if (menuLevel == 0) {
-        if (menuIndexMain == 0) {
-          activeMode = MODE_DMX_TO_IR;
-          menuMode = false;
-          Serial.println("Vybráno: DMX to IR");
-          updateMenuBaseline();
-          initDMXTransciever();
-          digitalWrite(MAX485_CTRL_PIN, LOW);
-        } else if (menuIndexMain == 1) {
-          activeMode = MODE_IR_TO_DMX;
-          menuMode   = false;
-          Serial.println("Vybráno: IR to DMX");
-          updateMenuBaseline();
-          digitalWrite(MAX485_CTRL_PIN, HIGH);
-          
-          
-          // reset stavů
-          irToDmxFirstEntry = true;
-          irToDmxLastScene  = -1;
-} else if (menuIndexMain == 2) {
-          // Při výběru IR Learn z hlavního menu přejdeme do submenu a resetujeme index
-          menuLevel = 2;
-          menuIndexIRLearn = 0;
-          updateMenuBaseline();
-          drawMenu();
-          Serial.println("Vybráno: IR Learn (submenu)");
-        } else if (menuIndexMain == 3) {
-          menuLevel = 1;
-          updateMenuBaseline();
-          drawMenu();
-          Serial.println("Vybráno: Settings");
-        }
-      }
-      else if (menuLevel == 1) {
-        if (menuIndexSettings == 0) {
-          wifiAPEnabled = !wifiAPEnabled;
-          if (wifiAPEnabled) {
-            WiFi.softAP(ssid, password);
-            Serial.println("WiFi AP zapnut");
-          } else {
-            WiFi.softAPdisconnect(true);
-            Serial.println("WiFi AP vypnut");
-          }
-          drawMenu();
-        } else if (menuIndexSettings == 1) {
-          menuLevel = 0;
-          updateMenuBaseline();
-          drawMenu();
-          Serial.println("Návrat z Settings");
-        }
-      }
-      else if (menuLevel == 2) {
-        if (menuIndexIRLearn < 6) {
-          // Přechod do IR Learn režimu až po uvolnění a následném stisku tlačítka
-          irLearnPos = menuIndexIRLearn;
-          activeMode = MODE_IR_LEARN;
-          menuLevel = 3;
-          menuMode = false;
-          irLearnStartTime = millis();
-          updateMenuBaseline();
-          drawMenu();
-          Serial.print("Nastavuji IR Learn pro pozici ");
-          Serial.println(irLearnPos + 1);
-        } else {
-          menuLevel = 0;
-          updateMenuBaseline();
-          menuIndexIRLearn = 0;
-          drawMenu();
-          Serial.println("Návrat z IR Learn");
-        }
-      }
-      delay(50);
-    }
   }
   else {
-    if (activeMode == MODE_IR_TO_DMX) {
-      runIrToDmx();
-      checkReturnToMenu();
-    } else if (activeMode == MODE_DMX_TO_IR) {
-      runDmxToIr();
-      checkReturnToMenu();
-    } else if (activeMode == MODE_IR_LEARN) {
-      if (menuLevel == 3) {
-        runIrLearn();
-      }
-      checkReturnToMenu();
+    if (activeMode == MODE_DMX_TO_IR) {
+      updateDmxToIrView();
+    }
+    if (activeMode == MODE_IR_LEARN && menuLevel == 3) {
+      runIrLearn();
     }
   }
-}
\ No newline at end of file
+
+  uiRender();
+}
+
+//
+// WiFi AP a HTTP server – softAP() trvá stovky ms, proto ve vlastní jednorázové
+// úloze; UI mezitím kreslí a obsluhuje enkodér
+//
+void wifiStartTask(void *) {
+  WiFi.softAP(ssid, password);
+  LOG_I("Access Point spuštěn, IP %s", WiFi.softAPIP().toString().c_str());
+  server.begin();
+  wifiReady = true;
+  bootMark(BOOT_WIFI);
+  bootReport();
+  vTaskDelete(NULL);
+}
+
+//
+// Druhá polovina startu (UI úloha, jádro 0): displej, obnovený režim nebo menu,
+// LittleFS a nakonec WiFi na pozadí
+//
+void uiBegin() {
+  display.begin(SH1106_SWITCHCAPVCC, SCREEN_ADDRESS);
+  Wire.beginTransmission(SCREEN_ADDRESS);
+  Wire.write(0x00);
+  Wire.write(0x81);
+  Wire.write(0xFF);
+  Wire.endTransmission();
+  display.clearDisplay();
+  initScreens();
+
+  if (bootMode != MODE_MENU) {
+    // signálová úloha už v režimu běží (setup()) – jen obrazovka
+    const char *names[] = { "", "DMX to IR", "IR to DMX", "", "DMX Thru" };
+    LOG_I("Obnoven režim %s", names[bootMode]);
+    enterSignalMode(bootMode, false);
+  } else {
+    menuMode = true;
+    menuLevel = 0;
+    updateMenuBaseline();
+    drawMenu();
+  }
+  uiRender();
+  bootMark(BOOT_DISPLAY);
+
+  // Záznam/přehrávání show (LittleFS + vlastní úloha na jádře 0)
+  showBegin();
+  bootMark(BOOT_STORAGE);
+
+  xTaskCreatePinnedToCore(wifiStartTask, "wifi", 4096, NULL, UI_TASK_PRIORITY, NULL, UI_TASK_CORE);
+}
+
+void uiTask(void *) {
+  uiBegin();
+  // vstupy budí UI task notification – jinak stačí projít smyčku jednou za 10 ms
+  inputSetNotifyTask(xTaskGetCurrentTaskHandle());
+  for (;;) {
+    uiLoop();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+  }
+}
+
+//
+// loop() – Arduino úloha už nic nedělá, vše běží v pinovaných úlohách
+//
+void loop() {
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,123 @@
+#include <string.h>
+#include <math.h>
+#include "output_curves.h"
+
+static const uint8_t customX[CURVE_POINTS] = { 0, 64, 128, 192, 255 };
+
+void curveProfileDefaults(CurveProfile &p) {
+  p.type = CURVE_LINEAR;
+  p.gammaX10 = 22;
+  p.min = 0;
+  p.max = 255;
+  p.invert = false;
+  for (int i = 0; i < CURVE_POINTS; i++) p.points[i] = customX[i];
+}
+
+void curveDefaults(CurveConfig &cfg) {
+  for (int p = 0; p < CURVE_PROFILES; p++) curveProfileDefaults(cfg.profiles[p]);
+  memset(cfg.channelProfile, 0, sizeof(cfg.channelProfile));
+}
+
+uint8_t curveValue(const CurveProfile &p, uint8_t in) {
+  float x = in / 255.0f;
+  float y;
+  switch (p.type) {
+    case CURVE_GAMMA:
+      y = powf(x, (p.gammaX10 ? p.gammaX10 : 10) / 10.0f);
+      break;
+    case CURVE_SQUARE:
+      y = x * x;
+      break;
+    case CURVE_CUSTOM: {
+      int k = in >> 6;
+      if (k > CURVE_POINTS - 2) k = CURVE_POINTS - 2;
+      float t = (float)(in - customX[k]) / (customX[k + 1] - customX[k]);
+      y = (p.points[k] + t * (p.points[k + 1] - p.points[k])) / 255.0f;
+      break;
+    }
+    default:
+      y = x;
+      break;
+  }
+  if (p.invert) y = 1.0f - y;
+  int v = (int)floorf(p.min + y * (p.max - p.min) + 0.5f);
+  return (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+CurveTable::CurveTable() : extent_(0) {
+  memset(map_, 0, sizeof(map_));
+  memset(valid_, 0, sizeof(valid_));
+  for (int v = 0; v < 256; v++) lut_[0][v] = (uint8_t)v;
+}
+
+void CurveTable::build(const CurveConfig &cfg) {
+  for (int p = 1; p < CURVE_PROFILES; p++) {
+    const CurveProfile &src = cfg.profiles[p];
+    if (valid_[p] && memcmp(&built_[p], &src, sizeof(src)) == 0) continue;
+    for (int v = 0; v < 256; v++) lut_[p][v] = curveValue(src, (uint8_t)v);
+    built_[p] = src;
+    valid_[p] = true;
+  }
+  extent_ = 0;
+  for (int ch = 0; ch < CURVE_CHANNELS; ch++) {
+    uint8_t p = cfg.channelProfile[ch];
+    map_[ch] = (p < CURVE_PROFILES) ? p : 0;
+    if (map_[ch]) extent_ = ch + 1;
+  }
+}
+
+void CurveTable::apply(uint8_t *out, uint16_t count) const {
+  if (count > extent_) count = extent_;
+  // rámec začíná za start kódem (liché adresy) – jen bajtový přístup
+  const uint8_t *map = map_;
+  for (uint16_t i = 0; i < count; i++) out[i] = lut_[map[i]][out[i]];
+}
+
+CurveBench curveBench(uint32_t iterations, uint32_t (*nowUs)()) {
+  static CurveConfig cfg;
+  static CurveTable table;
+  static uint8_t src[CURVE_CHANNELS], outM[CURVE_CHANNELS], outL[CURVE_CHANNELS];
+
+  // profily 1..7 všech typů, kanály po blocích 8 napřeskáčku (každý 8. beze změny)
+  curveDefaults(cfg);
+  const CurveType types[CURVE_PROFILES] = { CURVE_LINEAR, CURVE_GAMMA, CURVE_SQUARE, CURVE_CUSTOM,
+                                            CURVE_GAMMA, CURVE_LINEAR, CURVE_CUSTOM, CURVE_SQUARE };
+  for (int p = 1; p < CURVE_PROFILES; p++) {
+    CurveProfile &cp = cfg.profiles[p];
+    cp.type = types[p];
+    cp.gammaX10 = 18 + p;
+    cp.min = (p & 1) ? 0 : 10 * p;
+    cp.max = (p & 2) ? 255 : 200;
+    cp.invert = p == 5;
+    const uint8_t pts[CURVE_POINTS] = { 0, 20, 90, 200, 255 };
+    memcpy(cp.points, pts, CURVE_POINTS);
+  }
+  uint32_t seed = 12345;
+  for (int ch = 0; ch < CURVE_CHANNELS; ch++) {
+    cfg.channelProfile[ch] = (ch / 8) % CURVE_PROFILES;
+    seed = seed * 1103515245 + 12345;
+    src[ch] = (uint8_t)(seed >> 16);
+  }
+  cfg.channelProfile[CURVE_CHANNELS - 1] = 1;   // celý rámec
+  table.build(cfg);
+
+  CurveBench r;
+  r.iterations = iterations;
+  uint32_t t0 = nowUs();
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int ch = 0; ch < CURVE_CHANNELS; ch++) {
+      uint8_t p = cfg.channelProfile[ch];
+      outM[ch] = p ? curveValue(cfg.profiles[p], src[ch]) : src[ch];
+    }
+  }
+  uint32_t t1 = nowUs();
+  for (uint32_t i = 0; i < iterations; i++) {
+    memcpy(outL, src, CURVE_CHANNELS);
+    table.apply(outL, CURVE_CHANNELS);
+  }
+  uint32_t t2 = nowUs();
+  r.mathUs = t1 - t0;
+  r.lutUs = t2 - t1;
+  r.match = memcmp(outM, outL, CURVE_CHANNELS) == 0;
+  return r;
+}
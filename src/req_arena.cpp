@@ -0,0 +1,102 @@
+#include <string.h>
+#include "req_arena.h"
+
+ReqArena::ReqArena(uint8_t *buf, size_t size)
+    : buf_(buf), size_(size), top_(0), peak_(0), reservedPeak_(0), idle_(0) {
+  memset(&stats_, 0, sizeof(stats_));
+}
+
+void *ReqArena::alloc(size_t n) {
+  size_t at = (top_ + 3) & ~(size_t)3;
+  if (at + n > size_) {
+    stats_.failed++;
+    return NULL;
+  }
+  top_ = at + n;
+  notePeak();
+  return buf_ + at;
+}
+
+void ReqArena::notePeak() {
+  if (top_ > reservedPeak_) reservedPeak_ = top_;
+  if (top_ - idle_ > peak_) peak_ = top_ - idle_;
+}
+
+char *ReqArena::scratch(size_t &avail) {
+  size_t at = (top_ + 3) & ~(size_t)3;
+  avail = at < size_ ? size_ - at : 0;
+  return (char *)buf_ + at;
+}
+
+void ReqArena::commit(size_t n) {
+  size_t avail;
+  char *p = scratch(avail);
+  top_ = (p - (char *)buf_) + (n < avail ? n : avail);
+  notePeak();
+}
+
+void ReqArena::reset() {
+  stats_.requests++;
+  stats_.lastUsed = peak_;
+  stats_.lastReserved = reservedPeak_;
+  if (peak_ > stats_.highWater) stats_.highWater = peak_;
+  top_ = 0;
+  peak_ = 0;
+  reservedPeak_ = 0;
+  idle_ = 0;
+}
+
+ArenaText::ArenaText(ReqArena &arena, ArenaSink sink, void *ctx)
+    : arena_(arena), sink_(sink), ctx_(ctx), len_(0), maxLen_(0), truncated_(false) {
+  size_t avail;
+  buf_ = arena.scratch(avail);
+  cap_ = avail > REQ_ARENA_RESERVE ? avail - REQ_ARENA_RESERVE : 0;
+  // okno patří textu; alokace z rezervy jdou nad něj. Do použitých bajtů se
+  // počítá až text, který se do okna opravdu zapíše (append)
+  arena.idle_ += cap_;
+  arena.commit(cap_);
+  if (cap_) buf_[0] = 0;
+  else {
+    static char empty[1];
+    buf_ = empty;
+    arena.stats_.failed++;
+  }
+}
+
+ArenaText &ArenaText::append(const char *s, size_t n) {
+  while (n) {
+    // místo na '\0' zůstává vždy
+    size_t room = cap_ > len_ + 1 ? cap_ - len_ - 1 : 0;
+    if (!room) {
+      if (!sink_ || !len_) {
+        truncated_ = true;
+        return *this;
+      }
+      flush();
+      arena_.stats_.flushes++;
+      continue;
+    }
+    size_t k = n < room ? n : room;
+    memcpy(buf_ + len_, s, k);
+    len_ += k;
+    buf_[len_] = 0;
+    if (len_ > maxLen_) {
+      arena_.idle_ -= len_ - maxLen_;
+      maxLen_ = len_;
+      arena_.notePeak();
+    }
+    s += k;
+    n -= k;
+  }
+  return *this;
+}
+
+ArenaText &ArenaText::operator+=(const char *s) {
+  return append(s, strlen(s));
+}
+
+void ArenaText::flush() {
+  if (sink_ && len_) sink_(ctx_, buf_, len_);
+  len_ = 0;
+  if (cap_) buf_[0] = 0;
+}
@@ -0,0 +1,141 @@
+#include <Arduino.h>
+#include <atomic>
+#include <esp_partition.h>
+#include "scene_bank.h"
+#include "crc32.h"
+#include "trace.h"
+#include "log.h"
+
+#define SCENE_BANK_MAGIC "SCNB"
+
+struct SlotHeader {
+  char     magic[4];
+  uint32_t generation;
+  uint16_t count;
+  uint16_t channels;
+  uint32_t crc;
+};
+static_assert(sizeof(SlotHeader) == SCENE_BANK_HEADER, "SlotHeader: 16 B");
+
+static const esp_partition_t *part = NULL;
+static spi_flash_mmap_handle_t mapHandle;
+static const uint8_t *mapped = NULL;
+static SceneBankInfo info = {};
+
+static std::atomic<int8_t> activeSlot(-1);
+static std::atomic<int8_t> readerSlot(-1);   // slot, ze kterého čte signálová úloha
+
+static const SlotHeader *slotHeader(int slot) {
+  return (const SlotHeader *)(mapped + slot * SCENE_BANK_SLOT_SIZE);
+}
+
+static bool slotValid(int slot) {
+  const SlotHeader *h = slotHeader(slot);
+  if (memcmp(h->magic, SCENE_BANK_MAGIC, 4) != 0 || h->generation == 0xFFFFFFFF) return false;
+  size_t len = (size_t)h->count * h->channels;
+  if (!h->count || h->count > SCENE_BANK_MAX_SCENES || !h->channels ||
+      len > SCENE_BANK_SLOT_SIZE - SCENE_BANK_HEADER) return false;
+  return crc32Update(0, (const uint8_t *)h + SCENE_BANK_HEADER, len) == h->crc;
+}
+
+static void selectActive() {
+  int best = -1;
+  for (int s = 0; s < 2; s++) {
+    if (!slotValid(s)) continue;
+    if (best < 0 || slotHeader(s)->generation > slotHeader(best)->generation) best = s;
+  }
+  activeSlot.store(best, std::memory_order_release);
+  info.activeSlot = best;
+  if (best >= 0) {
+    info.generation = slotHeader(best)->generation;
+    info.count = slotHeader(best)->count;
+    info.channels = slotHeader(best)->channels;
+  }
+}
+
+bool sceneBankBegin() {
+  part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)SCENE_BANK_SUBTYPE,
+                                  SCENE_BANK_LABEL);
+  if (!part || part->size < 2 * SCENE_BANK_SLOT_SIZE) {
+    LOG_W("Oddíl banky scén nenalezen – scény zůstávají v RAM");
+    return false;
+  }
+  const void *ptr;
+  if (esp_partition_mmap(part, 0, 2 * SCENE_BANK_SLOT_SIZE, SPI_FLASH_MMAP_DATA, &ptr, &mapHandle) != ESP_OK) {
+    LOG_E("Mapování banky scén selhalo – scény zůstávají v RAM");
+    part = NULL;
+    return false;
+  }
+  mapped = (const uint8_t *)ptr;
+  info.mapped = true;
+  selectActive();
+  LOG_I("Banka scén: slot %d, generace %lu", info.activeSlot, (unsigned long)info.generation);
+  return true;
+}
+
+bool sceneBankMapped() {
+  return mapped != NULL;
+}
+
+const uint8_t *sceneBankData(uint16_t &count, uint16_t &channels) {
+  int s = activeSlot.load(std::memory_order_acquire);
+  if (!mapped || s < 0) return NULL;
+  const SlotHeader *h = slotHeader(s);
+  count = h->count;
+  channels = h->channels;
+  return (const uint8_t *)h + SCENE_BANK_HEADER;
+}
+
+const uint8_t *sceneBankAcquire(uint16_t &count, uint16_t &channels) {
+  readerSlot.store(activeSlot.load(std::memory_order_acquire), std::memory_order_release);
+  return sceneBankData(count, channels);
+}
+
+bool sceneBankWrite(const uint8_t *data, uint16_t count, uint16_t channels) {
+  size_t len = (size_t)count * channels;
+  if (!mapped || !count || count > SCENE_BANK_MAX_SCENES || len > SCENE_BANK_SLOT_SIZE - SCENE_BANK_HEADER) {
+    info.writeErrors++;
+    return false;
+  }
+  int cur = activeSlot.load(std::memory_order_acquire);
+  int target = (cur == 0) ? 1 : 0;
+
+  // signálová úloha ještě může číst cílový slot (přepnutí z minulého zápisu nepřevzala)
+  uint32_t waitStart = millis();
+  while (readerSlot.load(std::memory_order_acquire) == target) {
+    if (millis() - waitStart >= SCENE_BANK_READER_WAIT_MS) {
+      info.writeErrors++;
+      return false;
+    }
+    delay(1);
+  }
+
+  TraceScope trace(TRACE_FLASH_WRITE, count);
+  uint32_t start = micros();
+  size_t offset = target * SCENE_BANK_SLOT_SIZE;
+  size_t eraseLen = (SCENE_BANK_HEADER + len + SPI_FLASH_SEC_SIZE - 1) & ~(SPI_FLASH_SEC_SIZE - 1);
+  SlotHeader h;
+  memcpy(h.magic, SCENE_BANK_MAGIC, 4);
+  h.generation = (cur >= 0 ? slotHeader(cur)->generation : 0) + 1;
+  h.count = count;
+  h.channels = channels;
+  h.crc = crc32Update(0, data, len);
+
+  // hlavička až po datech – do té doby je slot neplatný
+  bool ok = esp_partition_erase_range(part, offset, eraseLen) == ESP_OK &&
+            esp_partition_write(part, offset + SCENE_BANK_HEADER, data, len) == ESP_OK &&
+            esp_partition_write(part, offset, &h, sizeof(h)) == ESP_OK &&
+            slotValid(target);
+  info.lastWriteUs = micros() - start;
+  if (!ok) {
+    info.writeErrors++;
+    return false;
+  }
+  info.writes++;
+  selectActive();
+  return true;
+}
+
+const SceneBankInfo &sceneBankInfo() {
+  return info;
+}
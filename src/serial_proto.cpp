@@ -0,0 +1,137 @@
+#include <string.h>
+#include "serial_proto.h"
+#include "crc32.h"
+
+void SerialFrameDecoder::reset() {
+  fill_ = 0;
+  overflow_ = false;
+  type_ = 0;
+  seq_ = 0;
+  length_ = 0;
+  memset(&stats_, 0, sizeof(stats_));
+}
+
+bool SerialFrameDecoder::push(uint8_t byte) {
+  if (byte != 0) {
+    if (fill_ < sizeof(buf_)) buf_[fill_++] = byte;
+    else overflow_ = true;
+    return false;
+  }
+  // oddělovač: prázdný úsek (dvě nuly za sebou) nic neznamená
+  bool ok = false;
+  if (overflow_) stats_.overflows++;
+  else if (fill_) ok = finishFrame();
+  fill_ = 0;
+  overflow_ = false;
+  return ok;
+}
+
+// COBS na místě – výstup nikdy nepředběhne vstup
+bool SerialFrameDecoder::finishFrame() {
+  uint16_t in = 0, out = 0;
+  while (in < fill_) {
+    uint8_t code = buf_[in++];
+    if (in + code - 1 > fill_) {
+      stats_.malformed++;
+      return false;
+    }
+    for (uint8_t k = 1; k < code; k++) buf_[out++] = buf_[in++];
+    if (code != 0xFF && in < fill_) buf_[out++] = 0;
+  }
+
+  if (out < SERIAL_PROTO_HEADER + 4 || out - SERIAL_PROTO_HEADER - 4 != spGet16(buf_ + 2)) {
+    stats_.malformed++;
+    return false;
+  }
+  uint16_t body = out - 4;
+  if (crc32Update(0, buf_, body) != spGet32(buf_ + body)) {
+    stats_.crcErrors++;
+    return false;
+  }
+  type_ = buf_[0];
+  seq_ = buf_[1];
+  length_ = body - SERIAL_PROTO_HEADER;
+  stats_.frames++;
+  return true;
+}
+
+// Průběžný COBS zápis: kód bloku se doplní, až je známa jeho délka
+struct CobsWriter {
+  uint8_t *out;
+  size_t   size;
+  size_t   pos;
+  size_t   codePos;
+  uint8_t  code;
+  bool     full;
+
+  void begin() {
+    codePos = pos++;
+    code = 1;
+  }
+  void put(uint8_t b) {
+    if (pos >= size) {
+      full = true;
+      return;
+    }
+    if (b == 0) {
+      out[codePos] = code;
+      begin();
+      return;
+    }
+    out[pos++] = b;
+    if (++code == 0xFF) {
+      out[codePos] = code;
+      begin();
+    }
+  }
+  void put(const uint8_t *p, size_t len) {
+    while (len--) put(*p++);
+  }
+};
+
+size_t serialFrameEncode(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len,
+                         uint8_t *out, size_t outSize) {
+  if (len > SERIAL_PROTO_MAX_PAYLOAD || outSize < 4) return 0;
+  uint8_t header[SERIAL_PROTO_HEADER] = { type, seq, 0, 0 };
+  spPut16(header + 2, len);
+  uint8_t crc[4];
+  spPut32(crc, crc32Update(crc32Update(0, header, sizeof(header)), payload, len));
+
+  out[0] = 0;
+  // poslední bajt zůstane na koncový oddělovač
+  CobsWriter w = { out, outSize - 1, 1, 0, 0, false };
+  w.begin();
+  w.put(header, sizeof(header));
+  w.put(payload, len);
+  w.put(crc, sizeof(crc));
+  if (w.full || w.pos >= outSize) return 0;
+  out[w.codePos] = w.code;
+  out[w.pos++] = 0;
+  return w.pos;
+}
+
+size_t serialMetricsEncode(const SerialMetrics &m, uint8_t out[SERIAL_METRICS_SIZE]) {
+  uint8_t *p = out;
+  spPut32(p, m.uptimeMs);        p += 4;
+  *p++ = m.mode;
+  *p++ = m.signalPresent;
+  spPut16(p, m.framesPerSec);    p += 2;
+  spPut16(p, m.errorsPerSec);    p += 2;
+  spPut16(p, m.lastSlots);       p += 2;
+  spPut32(p, m.framesTotal);     p += 4;
+  spPut32(p, m.framesPublished); p += 4;
+  spPut32(p, m.framesUnchanged); p += 4;
+  spPut32(p, m.uartErrors);      p += 4;
+  spPut32(p, m.signalLosses);    p += 4;
+  spPut32(p, m.intervalMaxUs);   p += 4;
+  spPut32(p, m.jitterUs);        p += 4;
+  spPut32(p, m.mergeLastUs);     p += 4;
+  spPut32(p, m.mergeMaxUs);      p += 4;
+  spPut16(p, m.mergeChannels);   p += 2;
+  spPut32(p, m.curveLastUs);     p += 4;
+  spPut32(p, m.irDecoded);       p += 4;
+  spPut32(p, m.irRepeats);       p += 4;
+  spPut32(p, m.logDropped);      p += 4;
+  spPut32(p, m.freeHeap);        p += 4;
+  return p - out;
+}
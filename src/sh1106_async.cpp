@@ -0,0 +1,151 @@
+#include <Arduino.h>
+#include <Wire.h>
+#include "sh1106_async.h"
+#include "signal_task.h"
+#include "trace.h"
+
+// pending sdílí UI a přenosová úloha – kopie 1 kB pod spinlockem trvá jednotky µs
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+
+void SH1106Async::begin(uint8_t switchvcc, uint8_t i2caddr, bool reset) {
+  Adafruit_SH1106::begin(switchvcc, i2caddr, reset);
+  addr = i2caddr;
+  Wire.setClock(SH1106_ASYNC_I2C_HZ);
+  memset(fb, 0, sizeof(fb));
+  shownValid = false;
+  if (!task) {
+    // stejné jádro a priorita jako UI – úloha skoro celou dobu spí na semaforu ovladače I2C
+    xTaskCreatePinnedToCore(flushTask, "oled", 3072, this, UI_TASK_PRIORITY, (TaskHandle_t *)&task, UI_TASK_CORE);
+  }
+}
+
+void SH1106Async::clearDisplay() {
+  memset(fb, 0, sizeof(fb));
+}
+
+void SH1106Async::display() {
+  portENTER_CRITICAL(&pendingMux);
+  if (hasPending) flushStats.coalesced++;
+  memcpy(pending, fb, sizeof(pending));
+  hasPending = true;
+  flushStats.requested++;
+  portEXIT_CRITICAL(&pendingMux);
+  if (task) xTaskNotifyGive((TaskHandle_t)task);
+}
+
+bool SH1106Async::busy() const {
+  return hasPending || transferring;
+}
+
+bool SH1106Async::waitIdle(uint32_t timeoutMs) {
+  unsigned long start = millis();
+  while (busy()) {
+    if (millis() - start >= timeoutMs) return false;
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+void SH1106Async::flushTask(void *arg) {
+  SH1106Async *self = (SH1106Async *)arg;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (self->hasPending) self->flushOnce();
+  }
+}
+
+void SH1106Async::flushOnce() {
+  portENTER_CRITICAL(&pendingMux);
+  memcpy(tx, pending, sizeof(tx));
+  hasPending = false;
+  transferring = true;
+  portEXIT_CRITICAL(&pendingMux);
+
+  traceRecord(TRACE_DISPLAY_FLUSH, TRACE_BEGIN);
+  uint32_t start = micros();
+  uint32_t sent = flushStats.pagesSent;
+  for (uint8_t page = 0; page < SH1106_ASYNC_PAGES; page++) {
+    const uint8_t *src = &tx[page * SH1106_LCDWIDTH];
+    uint8_t *dst = &shown[page * SH1106_LCDWIDTH];
+    if (shownValid && memcmp(src, dst, SH1106_LCDWIDTH) == 0) {
+      flushStats.pagesSkipped++;
+      continue;
+    }
+    sendPage(page, src);
+    memcpy(dst, src, SH1106_LCDWIDTH);
+    flushStats.pagesSent++;
+  }
+  shownValid = true;
+
+  uint32_t us = micros() - start;
+  traceRecord(TRACE_DISPLAY_FLUSH, TRACE_END, (uint16_t)(flushStats.pagesSent - sent));
+  flushStats.lastFlushUs = us;
+  if (us > flushStats.maxFlushUs) flushStats.maxFlushUs = us;
+  flushStats.flushed++;
+  transferring = false;
+  if (doneCb) doneCb();
+}
+
+void SH1106Async::sendPage(uint8_t page, const uint8_t *data) {
+  // adresa stránky a sloupce jednou transakcí (Co = 0, D/C = 0)
+  Wire.beginTransmission(addr);
+  Wire.write(0x00);
+  Wire.write(0xB0 + page);
+  Wire.write(SH1106_SETLOWCOLUMN | (SH1106_ASYNC_COL_OFFSET & 0x0F));
+  Wire.write(SH1106_SETHIGHCOLUMN | (SH1106_ASYNC_COL_OFFSET >> 4));
+  Wire.endTransmission();
+
+  // data po polovinách stránky – Wire má na ESP32 buffer 128 B
+  const uint8_t chunk = SH1106_LCDWIDTH / 2;
+  for (uint8_t off = 0; off < SH1106_LCDWIDTH; off += chunk) {
+    Wire.beginTransmission(addr);
+    Wire.write(0x40);
+    Wire.write(data + off, chunk);
+    Wire.endTransmission();
+  }
+}
+
+// ========================
+// Kreslení do vlastního framebufferu (stejné pořadí bitů jako knihovna)
+// ========================
+void SH1106Async::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+
+  int16_t t;
+  switch (getRotation()) {
+    case 1: t = x; x = WIDTH - 1 - y; y = t; break;
+    case 2: x = WIDTH - 1 - x; y = HEIGHT - 1 - y; break;
+    case 3: t = x; x = y; y = HEIGHT - 1 - t; break;
+  }
+
+  uint8_t &b = fb[x + (y / 8) * SH1106_LCDWIDTH];
+  uint8_t mask = 1 << (y & 7);
+  switch (color) {
+    case WHITE:   b |= mask;  break;
+    case BLACK:   b &= ~mask; break;
+    case INVERSE: b ^= mask;  break;
+  }
+}
+
+void SH1106Async::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (getRotation() != 0) {
+    for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+    return;
+  }
+  if (y < 0 || y >= HEIGHT) return;
+  if (x < 0) { w += x; x = 0; }
+  if (x + w > WIDTH) w = WIDTH - x;
+  if (w <= 0) return;
+
+  uint8_t *p = &fb[x + (y / 8) * SH1106_LCDWIDTH];
+  uint8_t mask = 1 << (y & 7);
+  switch (color) {
+    case WHITE:   while (w--) *p++ |= mask;  break;
+    case BLACK:   mask = ~mask; while (w--) *p++ &= mask; break;
+    case INVERSE: while (w--) *p++ ^= mask;  break;
+  }
+}
+
+void SH1106Async::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+}
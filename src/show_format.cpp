@@ -0,0 +1,103 @@
+#include "show_format.h"
+
+void showWriteHeader(uint8_t *out) {
+  memset(out, 0, SHOW_HEADER_SIZE);
+  memcpy(out, SHOW_MAGIC, 4);
+  out[4] = SHOW_VERSION;
+  out[5] = 0;
+  out[6] = SHOW_MAX_SLOTS & 0xFF;
+  out[7] = SHOW_MAX_SLOTS >> 8;
+}
+
+bool showCheckHeader(const uint8_t *in) {
+  return memcmp(in, SHOW_MAGIC, 4) == 0 && in[4] == SHOW_VERSION;
+}
+
+void ShowEncoder::reset() {
+  memset(prev, 0, sizeof(prev));
+  prevLen = 0;
+  lastMs = 0;
+  undoMs = 0;
+  lastKeyMs = 0;
+  needKey = true;
+  started = false;
+}
+
+size_t ShowEncoder::encodeKey(const uint8_t *slots, uint16_t len, uint32_t dt, uint8_t *out) {
+  size_t n = 0;
+  out[n++] = SHOW_REC_KEY;
+  n += showPutVarint(out + n, dt);
+  n += showPutVarint(out + n, len);
+  memcpy(out + n, slots, len);
+  n += len;
+  return n;
+}
+
+size_t ShowEncoder::encode(const uint8_t *slots, uint16_t len, uint32_t nowMs, uint8_t *out) {
+  if (len > SHOW_MAX_SLOTS) len = SHOW_MAX_SLOTS;
+  if (!started) {
+    started = true;
+    lastMs = nowMs;
+  }
+  uint32_t dt = nowMs - lastMs;
+  undoMs = lastMs;
+
+  // klíčový rámec: začátek, vynucený, periodický nebo změna délky
+  if (needKey || len != prevLen || nowMs - lastKeyMs >= SHOW_KEYFRAME_MS) {
+    size_t n = encodeKey(slots, len, dt, out);
+    memcpy(prev, slots, len);
+    prevLen = len;
+    lastMs = nowMs;
+    lastKeyMs = nowMs;
+    needKey = false;
+    return n;
+  }
+
+  // rozdílový rámec – nejdřív úseky, pak hlavička s jejich počtem
+  uint8_t body[SHOW_MAX_RECORD];
+  size_t bodyLen = 0;
+  uint32_t runs = 0;
+  uint16_t pos = 0, lastEnd = 0;
+  while (pos < len) {
+    if (slots[pos] == prev[pos]) { pos++; continue; }
+    uint16_t start = pos, end = pos + 1, same = 0;
+    for (uint16_t i = pos + 1; i < len; i++) {
+      if (slots[i] != prev[i]) { end = i + 1; same = 0; }
+      else if (++same >= SHOW_MERGE_GAP) break;
+    }
+    if (bodyLen + 6 + (end - start) > sizeof(body)) {
+      // změn je tolik, že se vyplatí klíčový rámec
+      needKey = true;
+      return encode(slots, len, nowMs, out);
+    }
+    bodyLen += showPutVarint(body + bodyLen, start - lastEnd);
+    bodyLen += showPutVarint(body + bodyLen, end - start);
+    memcpy(body + bodyLen, slots + start, end - start);
+    bodyLen += end - start;
+    runs++;
+    lastEnd = end;
+    pos = end;
+  }
+  if (runs == 0) return 0;   // beze změny
+
+  size_t n = 0;
+  out[n++] = SHOW_REC_DELTA;
+  n += showPutVarint(out + n, dt);
+  n += showPutVarint(out + n, runs);
+  if (n + bodyLen > SHOW_MAX_RECORD) {
+    needKey = true;
+    return encode(slots, len, nowMs, out);
+  }
+  memcpy(out + n, body, bodyLen);
+  n += bodyLen;
+  memcpy(prev, slots, len);
+  lastMs = nowMs;
+  return n;
+}
+
+size_t ShowEncoder::encodeEnd(uint32_t nowMs, uint8_t *out) {
+  size_t n = 0;
+  out[n++] = SHOW_REC_END;
+  n += showPutVarint(out + n, started ? nowMs - lastMs : 0);
+  return n;
+}
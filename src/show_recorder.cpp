@@ -0,0 +1,247 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "show_recorder.h"
+#include "signal_task.h"
+#include "log.h"
+
+SpscByteRing<SHOW_RING_SIZE>             showRecRing;
+SpscQueue<ShowPlayFrame, SHOW_PLAY_QUEUE> showPlayQueue;
+
+enum ShowCtl : uint8_t {
+  SHOW_CTL_RECORD,
+  SHOW_CTL_PLAY,
+  SHOW_CTL_STOP
+};
+
+// UI → úloha "show"
+static SpscQueue<uint8_t, 4> showCtlQueue;
+static TaskHandle_t showTaskHandle = NULL;
+
+// Stav sdílený se signálovou úlohou – jen atomické přepínače
+static std::atomic<bool>     recActive(false);
+static std::atomic<uint32_t> recSession(0);
+static std::atomic<uint32_t> playSession(0);   // 0 = nic se nepřehrává
+
+static volatile ShowState state = SHOW_IDLE;
+static ShowStats stats = {};
+static volatile uint32_t fileSize = 0;
+
+// ========================
+// Úloha "show" – soubor, zápis a dekódování
+// ========================
+static File showFile;
+static uint8_t wbuf[SHOW_WRITE_CHUNK];
+static size_t wlen = 0;
+static ShowDecoder<File> decoder(showFile);
+static ShowPlayFrame playFrame;
+static uint32_t playCounter = 0;
+static bool playEof = false;
+
+static bool flushChunk() {
+  if (!wlen) return true;
+  uint32_t start = micros();
+  size_t w = showFile.write(wbuf, wlen);
+  uint32_t us = micros() - start;
+  stats.lastWriteUs = us;
+  if (us > stats.maxWriteUs) stats.maxWriteUs = us;
+  stats.flashWrites++;
+  stats.bytesWritten += w;
+  fileSize += w;
+  bool ok = (w == wlen);
+  wlen = 0;
+  return ok;
+}
+
+// Přesune data z kruhového bufferu do souboru – zapisuje jen celé bloky.
+// false = zápis selhal (plná flash)
+static bool drainRing() {
+  for (;;) {
+    wlen += showRecRing.read(wbuf + wlen, sizeof(wbuf) - wlen);
+    if (wlen < sizeof(wbuf)) return true;
+    if (!flushChunk()) return false;
+  }
+}
+
+static void startRecording() {
+  showFile = LittleFS.open(SHOW_FILE_PATH, "w");
+  if (!showFile) {
+    stats.writeErrors++;
+    return;
+  }
+  // zbytky z minula pryč (ring je prázdný, pokud předchozí záznam skončil normálně)
+  while (showRecRing.read(wbuf, sizeof(wbuf))) {}
+  fileSize = 0;
+  showWriteHeader(wbuf);
+  wlen = SHOW_HEADER_SIZE;
+  recSession.fetch_add(1, std::memory_order_relaxed);
+  recActive.store(true, std::memory_order_release);
+  state = SHOW_RECORDING;
+}
+
+static void stopRecording() {
+  recActive.store(false, std::memory_order_release);
+  // signálová úloha mohla vzít příznak těsně předtím – nechme rámec dopsat
+  vTaskDelay(pdMS_TO_TICKS(SHOW_STOP_SETTLE_MS));
+  bool ok = drainRing();
+  if (ok) {
+    if (wlen + 2 > sizeof(wbuf)) ok = flushChunk();
+    wbuf[wlen++] = SHOW_REC_END;
+    wbuf[wlen++] = 0;
+    ok = ok && flushChunk();
+  }
+  // při chybě zůstane soubor bez 'E' – dekodér ho přehraje do posledního celého záznamu
+  if (!ok) stats.writeErrors++;
+  wlen = 0;
+  showFile.close();
+  state = SHOW_IDLE;
+}
+
+static void startPlaying() {
+  showFile = LittleFS.open(SHOW_FILE_PATH, "r");
+  if (!showFile) return;
+  fileSize = showFile.size();
+  if (!decoder.begin()) {
+    stats.formatErrors++;
+    showFile.close();
+    return;
+  }
+  playEof = false;
+  playSession.store(++playCounter, std::memory_order_release);
+  state = SHOW_PLAYING;
+}
+
+static void stopPlaying() {
+  playSession.store(0, std::memory_order_release);
+  showFile.close();
+  state = SHOW_IDLE;
+}
+
+// Udržuje frontu přehrávače plnou; po konci souboru počká, až signál vše odvysílá
+static void feedPlayer() {
+  while (!playEof && !showPlayQueue.full()) {
+    if (!decoder.next()) {
+      if (decoder.error()) stats.formatErrors++;
+      playEof = true;
+      break;
+    }
+    const ShowFrame &f = decoder.current();
+    playFrame.timeMs = f.timeMs;
+    playFrame.len = f.len;
+    playFrame.session = playCounter;
+    memcpy(playFrame.slots, f.slots, f.len);
+    showPlayQueue.push(playFrame);
+    stats.framesQueued++;
+  }
+  if (playEof && showPlayQueue.empty()) stopPlaying();
+}
+
+static void handleCtl(uint8_t ctl) {
+  if (state == SHOW_RECORDING) stopRecording();
+  if (state == SHOW_PLAYING)   stopPlaying();
+  switch (ctl) {
+    case SHOW_CTL_RECORD: startRecording(); break;
+    case SHOW_CTL_PLAY:   startPlaying();   break;
+    default: break;
+  }
+}
+
+static void showTask(void *) {
+  for (;;) {
+    uint8_t ctl;
+    while (showCtlQueue.pop(ctl)) handleCtl(ctl);
+
+    if (state == SHOW_RECORDING) {
+      if (!drainRing()) stopRecording();   // plná flash – zapsaná část zůstane čitelná
+    }
+    else if (state == SHOW_PLAYING) feedPlayer();
+
+    // 10 ms = ~4 DMX rámce; v klidu jen čeká na příkaz
+    ulTaskNotifyTake(pdTRUE, state == SHOW_IDLE ? portMAX_DELAY : pdMS_TO_TICKS(10));
+  }
+}
+
+void showBegin() {
+  if (!LittleFS.begin(true)) {
+    LOG_E("LittleFS se nepodařilo připojit – záznam show nebude k dispozici");
+    return;
+  }
+  File f = LittleFS.open(SHOW_FILE_PATH, "r");
+  if (f) {
+    fileSize = f.size();
+    f.close();
+  }
+  // jádro 0 s UI – zápis do flash nesmí brát čas signálové úloze
+  xTaskCreatePinnedToCore(showTask, "show", 4096, NULL, UI_TASK_PRIORITY, &showTaskHandle, UI_TASK_CORE);
+}
+
+static void postCtl(ShowCtl ctl) {
+  if (!showTaskHandle) return;
+  showCtlQueue.push(ctl);
+  xTaskNotifyGive(showTaskHandle);
+}
+
+void showRecordStart() { postCtl(SHOW_CTL_RECORD); }
+void showPlayStart()   { postCtl(SHOW_CTL_PLAY); }
+void showStop()        { postCtl(SHOW_CTL_STOP); }
+
+ShowState showState() { return state; }
+const ShowStats &showStats() { return stats; }
+uint32_t showFileSize() { return fileSize; }
+
+// ========================
+// Signálová strana
+// ========================
+void showCaptureFrame(const uint8_t *slots, uint16_t len, uint32_t nowMs) {
+  static ShowEncoder enc;
+  static uint32_t session = 0;
+  static uint8_t rec[SHOW_MAX_RECORD];
+
+  if (!recActive.load(std::memory_order_acquire)) return;
+  uint32_t s = recSession.load(std::memory_order_relaxed);
+  if (s != session) {
+    session = s;
+    enc.reset();
+  }
+  size_t n = enc.encode(slots, len, nowMs, rec);
+  if (n == 0) {
+    stats.framesUnchanged++;
+    return;
+  }
+  if (!showRecRing.write(rec, n)) {
+    // ztráta se počítá v showRecRing.dropped()
+    enc.discardLast();
+    return;
+  }
+  stats.framesRecorded++;
+}
+
+const uint8_t *showPlaybackFrame(uint32_t nowMs, uint16_t &len) {
+  static uint8_t out[SHOW_MAX_SLOTS];
+  static uint16_t outLen = 0;
+  static uint32_t session = 0;
+  static uint32_t baseMs = 0;
+
+  uint32_t active = playSession.load(std::memory_order_acquire);
+  const ShowPlayFrame *pf;
+  while ((pf = showPlayQueue.front()) != NULL) {
+    if (pf->session != active) {   // zbytek zastaveného přehrávání
+      showPlayQueue.drop();
+      continue;
+    }
+    if (session != active) {
+      // první rámec nového přehrávání určuje počátek času
+      session = active;
+      baseMs = nowMs - pf->timeMs;
+      outLen = 0;
+    }
+    if (nowMs - baseMs < pf->timeMs) break;
+    memcpy(out, pf->slots, pf->len);
+    outLen = pf->len;
+    stats.framesPlayed++;
+    showPlayQueue.drop();
+  }
+
+  if (!active || session != active || !outLen) return NULL;
+  len = outLen;
+  return out;
+}
@@ -0,0 +1,645 @@
+#include <Arduino.h>
+#include <atomic>
+#include <esp_dmx.h>
+#include <IRremoteESP8266.h>
+#include <IRsend.h>
+#include <driver/uart.h>  // kvůli uart_driver_delete()
+#include "signal_task.h"
+#include "frame_store.h"
+#include "show_recorder.h"
+#include "boot_timing.h"
+#include "ir_receiver.h"
+#include "input_events.h"
+#include "scene_bank.h"
+#include "trace.h"
+#include "log.h"
+
+#ifndef dmx_driver_uninstall
+static inline void dmx_driver_uninstall(dmx_port_t port) {
+  uart_driver_delete(port);
+}
+#endif
+
+SpscQueue<SignalCmd, 64> signalCmdQueue;
+SpscQueue<SignalEvt, 32> signalEvtQueue;
+MergeStats mergeStats = {};
+FrameStore dmxFrames;
+
+// ========================
+// DMX nastavení – využíváme UART1 (DMX_NUM_1 z esp_dmx)
+// Přijaté i vysílané rámce jdou přes dmxFrames (DMX kanály 1 až 6 = slots[1] až slots[6])
+#define ENABLE_PIN 13 //nezapojený pin, pouze jako dummy
+static dmx_port_t dmxPort = DMX_NUM_1;
+static bool dmxInstalled = false;
+#if DMX_THRU_ENABLED
+static dmx_port_t thruPort = DMX_NUM_2;   // jen vysílá (průchozí režim)
+#endif
+
+// IR přijímač (pin 16) má vlastní úlohu – události čteme z irEvents (ir_receiver.h)
+
+// Pin druhého portu nesmí být žádný z již zapojených (viz signal_task.h)
+static constexpr bool pinUsedElsewhere(int pin) {
+  return pin == 18 || pin == 19 || pin == MAX485_CTRL_PIN || pin == ENABLE_PIN ||   // DMX1
+         pin == IR_RECV_PIN || pin == 17 ||                                       // IR
+         pin == ENCODER_PIN_A || pin == ENCODER_PIN_B || pin == ENCODER_BTN_PIN ||
+         pin == 21 || pin == 22 ||                                                // OLED I2C
+         pin == 34 || pin == 1;                                                   // terminál
+}
+static_assert(!pinUsedElsewhere(DMX_THRU_TX_PIN) && !pinUsedElsewhere(DMX_THRU_EN_PIN) &&
+              DMX_THRU_TX_PIN != DMX_THRU_EN_PIN, "DMX_THRU_*_PIN koliduje s jiným zapojením");
+
+// ========================
+// IR vysílač – využívá pin 17 (IR LED)
+static IRsend irsend(17);
+
+// Vlastní kopie konfigurace – mění se jen příkazy z fronty
+static uint32_t irCodes[8] = {0};
+static uint8_t  sceneData[SIGNAL_SCENES][SIGNAL_SCENE_CH] = { {0} };
+// Scény pro výstup: přímo z mapované banky ve flash (scene_bank.h), bez ní sceneData
+static const uint8_t (*sceneTable)[SIGNAL_SCENE_CH] = sceneData;
+
+static SignalMode mode = SIG_IDLE;
+
+// pro DMX→IR režim
+static uint8_t  dmxPrev[7] = {0};         // 1..6, drží předchozí stav (==255)
+static uint32_t lastIrSent[7] = {0};      // poslední odeslaný IR kód pro každý kanál
+static DmxStats dmxStats;
+static unsigned long lastStatsEvt  = 0;
+
+// pro IR→DMX režim
+static int irToDmxScene = -1;
+static CueEngine cueEngine;
+static CueList   cueList;
+static Chase     chaseCfg;
+static uint32_t  cueIrCodes[3] = {0};     // indexováno CueCommand
+static uint8_t   cueOut[CUE_CHANNELS];
+static CueStatus cuePosted = {};
+static DmxMerger merger;
+static DmxThru   thru(merger);
+
+// Výstupní křivky: signálová úloha čte curveSets[curveActive], UI plní druhou
+// sadu a přepnutí převezme signálová úloha mezi rámci (CMD_CURVES_SWAP)
+static CurveTable curveSets[2];
+static std::atomic<uint8_t> curveActive(0);
+static std::atomic<bool>    curveSwapPending(false);
+
+// Vložený rámec ze sériového protokolu: UI píše jen mimo injectPending,
+// signálová úloha ho při CMD_INJECT_FRAME předá slučování a příznak shodí
+static uint8_t  injectLevels[MERGE_CHANNELS];
+static uint16_t injectCount = 0;
+static std::atomic<bool> injectPending(false);
+
+// Relativní ovládání IR ovladačem (skupiny nahoru/dolů, master) – mezi
+// sloučením a křivkami. Nová konfigurace přichází přes nudgeStaging stejně
+// jako vložený rámec.
+static NudgeEngine nudge;
+static NudgeConfig nudgeStaging;
+static std::atomic<bool> nudgePending(false);
+
+// Vysílání v IR→DMX běží v pevném rytmu CUE_TICK_MS (vTaskDelayUntil nenačítá
+// zpoždění). Čas pro cue engine i přehrávání show = počet ticků × perioda,
+// takže časování nezávisí na zátěži WiFi ani displeje na druhém jádře.
+static TickType_t outWake = 0;
+static uint32_t   outTicks = 0;
+
+void installDmxDriver() {
+  if (dmxInstalled) return;
+  // jednorázová instalace
+  dmx_driver_uninstall(dmxPort);
+  dmx_config_t config = DMX_CONFIG_DEFAULT;
+  dmx_driver_install(dmxPort, &config, DMX_INTR_FLAGS_DEFAULT);
+  dmx_set_pin(dmxPort, 19, 18, ENABLE_PIN);
+  LOG_I("DMX driver inicializován");
+#if DMX_THRU_ENABLED
+  dmx_driver_install(thruPort, &config, DMX_INTR_FLAGS_DEFAULT);
+  dmx_set_pin(thruPort, DMX_THRU_TX_PIN, DMX_PIN_NO_CHANGE, DMX_THRU_EN_PIN);
+  LOG_I("Druhý DMX port (průchozí výstup) inicializován");
+#endif
+  dmxInstalled = true;
+
+  irReceiverBegin();
+  irsend.begin();
+  LOG_I("IR přijímač inicializován na pinu 16");
+}
+
+// Převezme aktivní slot banky scén (při startu a po CMD_SCENE_BANK_SWAP)
+static void selectScenes() {
+  uint16_t count = 0, channels = 0;
+  const uint8_t *bank = sceneBankMapped() ? sceneBankAcquire(count, channels) : NULL;
+  if (bank && count >= SIGNAL_SCENES && channels == SIGNAL_SCENE_CH) {
+    sceneTable = (const uint8_t (*)[SIGNAL_SCENE_CH])bank;
+  } else {
+    sceneTable = sceneData;
+  }
+  cueEngine.setScenes(sceneTable, SIGNAL_SCENES);
+}
+
+void signalInitConfig(const uint32_t codes[8], const uint8_t scenes[SIGNAL_SCENES][SIGNAL_SCENE_CH]) {
+  memcpy(irCodes, codes, sizeof(irCodes));
+  memcpy(sceneData, scenes, sizeof(sceneData));
+  selectScenes();
+}
+
+void signalInitCues(const CueList &list, const Chase &chase, CueMode mode, const uint32_t codes[3]) {
+  cueList = list;
+  chaseCfg = chase;
+  memcpy(cueIrCodes, codes, sizeof(cueIrCodes));
+  cueEngine.setScenes(sceneTable, SIGNAL_SCENES);
+  cueEngine.setCueList(cueList);
+  cueEngine.setChase(chaseCfg);
+  cueEngine.setMode(mode);
+}
+
+void signalInitMerge(const uint8_t priorities[MERGE_SOURCES], const uint8_t ltpBits[MERGE_CHANNELS / 8]) {
+  for (int s = 0; s < MERGE_SOURCES; s++) merger.setPriority((MergeSource)s, priorities[s]);
+  for (int ch = 0; ch < MERGE_CHANNELS; ch++) merger.setLtp(ch, ltpBits[ch / 8] & (1 << (ch % 8)));
+}
+
+void signalInitCurves(const CurveConfig &cfg) {
+  curveSets[curveActive.load(std::memory_order_relaxed)].build(cfg);
+}
+
+void signalInitNudge(const NudgeConfig &cfg) {
+  nudge.setConfig(cfg);
+}
+
+bool signalSetCurves(const CurveConfig &cfg) {
+  // neaktivní sadu ještě může číst signálová úloha, dokud nepřevezme minulé přepnutí
+  uint32_t waitStart = millis();
+  while (curveSwapPending.load(std::memory_order_acquire)) {
+    if (millis() - waitStart >= SIGNAL_CURVES_WAIT_MS) return false;
+    vTaskDelay(1);
+  }
+  curveSets[curveActive.load(std::memory_order_acquire) ^ 1].build(cfg);
+  curveSwapPending.store(true, std::memory_order_release);
+  signalPostCmd(CMD_CURVES_SWAP);
+  return true;
+}
+
+bool signalSetNudge(const NudgeConfig &cfg) {
+  uint32_t waitStart = millis();
+  while (nudgePending.load(std::memory_order_acquire)) {
+    if (millis() - waitStart >= SIGNAL_NUDGE_WAIT_MS) return false;
+    vTaskDelay(1);
+  }
+  nudgeStaging = cfg;
+  nudgePending.store(true, std::memory_order_release);
+  signalPostCmd(CMD_NUDGE_CONFIG);
+  return true;
+}
+
+bool signalInjectFrame(const uint8_t *levels, uint16_t count) {
+  if (injectPending.load(std::memory_order_acquire)) return false;
+  if (count > MERGE_CHANNELS) count = MERGE_CHANNELS;
+  memcpy(injectLevels, levels, count);
+  injectCount = count;
+  injectPending.store(true, std::memory_order_release);
+  signalPostCmd(CMD_INJECT_FRAME);
+  return true;
+}
+
+void signalPostCmd(SignalCmdType type, uint8_t a, uint8_t b, uint32_t value) {
+  SignalCmd cmd = { type, a, b, value };
+  while (!signalCmdQueue.push(cmd)) {
+    vTaskDelay(1);
+  }
+}
+
+static void postEvent(const SignalEvt &evt) {
+  // signálová cesta nikdy nečeká – při plné frontě se událost zahodí (viz dropped())
+  signalEvtQueue.push(evt);
+}
+
+//
+// Neblokující příjem jednoho DMX rámce – převede chyby driveru na DmxFrameResult
+//
+static DmxFrameResult receiveDmxFrame(TickType_t wait, size_t &slots, uint8_t &startCode) {
+  dmx_packet_t packet;
+  slots = dmx_receive(dmxPort, &packet, wait);
+  startCode = 0;
+  switch (packet.err) {
+    case DMX_OK:                 break;
+    case DMX_ERR_TIMEOUT:        return DMX_FRAME_NONE;
+    case DMX_ERR_UART_OVERFLOW:
+    case DMX_ERR_DATA_COLLISION: return DMX_FRAME_UART_ERROR;
+    case DMX_ERR_IMPROPER_SLOT:  return DMX_FRAME_BREAK_ERROR;
+    case DMX_ERR_NOT_ENOUGH_SLOTS: return DMX_FRAME_SHORT;
+    default:                     return DMX_FRAME_UART_ERROR;
+  }
+  if (slots == 0) return DMX_FRAME_NONE;
+  startCode = (uint8_t)packet.sc;
+  return DMX_FRAME_OK;
+}
+
+static void enterMode(SignalMode newMode) {
+  mode = newMode;
+  merger.release(MERGE_SRC_INPUT);   // vstup průchozího režimu jinde nepatří do výstupu
+  dmxFrames.resetChanges();          // první rámec režimu se vyhodnotí celý
+  switch (mode) {
+    case SIG_DMX_TO_IR:
+      digitalWrite(MAX485_CTRL_PIN, LOW);
+      memset(dmxPrev,   0, sizeof(dmxPrev));
+      memset(lastIrSent,0, sizeof(lastIrSent));
+      dmxStats.reset();
+      lastStatsEvt  = 0;
+      break;
+    case SIG_IR_TO_DMX:
+      digitalWrite(MAX485_CTRL_PIN, HIGH);
+      irToDmxScene = -1;
+      nudge.reset();
+      outWake = xTaskGetTickCount();
+      // stisky z doby před vstupem do režimu se nepočítají
+      irReceiverFlush();
+      break;
+    case SIG_IR_LEARN:
+      irReceiverFlush();
+      break;
+#if DMX_THRU_ENABLED
+    case SIG_DMX_THRU: {
+      static const uint8_t dark[CUE_CHANNELS] = {0};
+      digitalWrite(MAX485_CTRL_PIN, LOW);   // port 1 přijímá, vysílá port 2
+      dmxStats.reset();
+      lastStatsEvt = 0;
+      irToDmxScene = -1;
+      nudge.reset();
+      // cue běží podle millis(), ne podle ticků IR→DMX – začíná se bez cue
+      cueEngine.release(dark);
+      thru.reset();
+      irReceiverFlush();
+      break;
+    }
+#endif
+    default:
+      break;
+  }
+}
+
+static void postIrSent(int ch, uint32_t code) {
+  SignalEvt evt;
+  evt.type = EVT_IR_SENT;
+  evt.ir.ch = (uint8_t)ch;
+  evt.ir.code = code;
+  postEvent(evt);
+}
+
+static void applyCmd(const SignalCmd &cmd) {
+  switch (cmd.type) {
+    case CMD_SET_MODE:
+      enterMode((SignalMode)cmd.a);
+      break;
+    case CMD_SET_IR_CODE:
+      if (cmd.a >= 1 && cmd.a <= 6) irCodes[cmd.a] = cmd.value;
+      break;
+    case CMD_SET_SCENE_VALUE:
+      if (cmd.a < SIGNAL_SCENES && cmd.b < SIGNAL_SCENE_CH) sceneData[cmd.a][cmd.b] = (uint8_t)cmd.value;
+      break;
+    case CMD_SCENE_BANK_SWAP:
+      selectScenes();
+      break;
+    case CMD_SET_CUE:
+      if (cmd.a < CUE_MAX_CUES) {
+        cueList.cues[cmd.a].scene  = cmd.b;
+        cueList.cues[cmd.a].fadeMs = (uint16_t)(cmd.value >> 16);
+        cueList.cues[cmd.a].waitMs = (uint16_t)cmd.value;
+        cueEngine.setCueList(cueList);
+      }
+      break;
+    case CMD_SET_CUE_COUNT:
+      cueList.count = (cmd.a <= CUE_MAX_CUES) ? cmd.a : CUE_MAX_CUES;
+      cueEngine.setCueList(cueList);
+      break;
+    case CMD_SET_CHASE_STEP:
+      if (cmd.a < CUE_MAX_STEPS) {
+        chaseCfg.steps[cmd.a] = cmd.b;
+        cueEngine.setChase(chaseCfg);
+      }
+      break;
+    case CMD_SET_CHASE:
+      chaseCfg.count   = cmd.a;
+      chaseCfg.fadePct = cmd.b;
+      chaseCfg.bpm     = (uint16_t)cmd.value;
+      cueEngine.setChase(chaseCfg);
+      break;
+    case CMD_SET_CUE_MODE:
+      cueEngine.setMode((CueMode)cmd.a);
+      break;
+    case CMD_SET_CUE_IR_CODE:
+      if (cmd.a <= CUE_PAUSE) cueIrCodes[cmd.a] = cmd.value;
+      break;
+    case CMD_SET_WEB_LEVEL:
+      merger.setChannel(MERGE_SRC_WEB, (uint16_t)(cmd.value >> 8), (uint8_t)cmd.value);
+      break;
+    case CMD_RELEASE_WEB:
+      merger.release(MERGE_SRC_WEB);
+      break;
+    case CMD_SET_MERGE_PRIORITY:
+      if (cmd.a < MERGE_SOURCES) merger.setPriority((MergeSource)cmd.a, cmd.b);
+      break;
+    case CMD_SET_MERGE_LTP:
+      merger.setLtp((uint16_t)cmd.value, cmd.a != 0);
+      break;
+    case CMD_CURVES_SWAP:
+      curveActive.store(curveActive.load(std::memory_order_relaxed) ^ 1, std::memory_order_release);
+      curveSwapPending.store(false, std::memory_order_release);
+      break;
+    case CMD_INJECT_FRAME:
+      if (injectCount) merger.setLevels(MERGE_SRC_WEB, injectLevels, injectCount);
+      else merger.release(MERGE_SRC_WEB);
+      injectPending.store(false, std::memory_order_release);
+      break;
+    case CMD_NUDGE_CONFIG:
+      nudge.setConfig(nudgeStaging);
+      nudgePending.store(false, std::memory_order_release);
+      break;
+  }
+}
+
+// Statistiky DMX vstupu pro UI 1× za sekundu
+static void postDmxStats() {
+  unsigned long now = millis();
+  if (now - lastStatsEvt >= 1000) {
+    lastStatsEvt = now;
+    SignalEvt evt;
+    evt.type = EVT_DMX_STATS;
+    evt.stats = dmxStats.snapshot();
+    postEvent(evt);
+  }
+}
+
+//
+// DMX → IR: rámec → edge-detekce na 255 → IR
+//
+static void serviceDmxToIr() {
+  // 1) Přijmi rámec – vadné rámce (chyba UART/break, krátké, start kód != 0) zahodíme.
+  //    Čekáme nejdéle 5 ms, aby se příkazy z UI vyřídily i bez signálu.
+  size_t slots;
+  uint8_t startCode;
+  DmxFrameResult res = receiveDmxFrame(pdMS_TO_TICKS(5), slots, startCode);
+  uint32_t nowUs = micros();
+  bool frameOk = dmxStats.record(res, nowUs, slots, startCode);
+  dmxStats.tick(nowUs);
+
+  if (frameOk) {
+    TraceScope trace(TRACE_DMX_FRAME, (uint16_t)slots);
+    DmxFrame &frame = dmxFrames.writeBuffer();
+    dmx_read(dmxPort, frame.slots, slots);
+    const uint8_t *data = frame.slots;
+    showCaptureFrame(data, (uint16_t)slots, millis());
+
+    // 2) EDGE-detekce, odeslání IR a mazání kódu, když klesne pod 255
+    for (int ch = 1; ch <= 6; ch++) {
+      bool highNow = (data[ch] == 255);
+      if (highNow && !dmxPrev[ch]) {
+        // právě přechod z <255 na 255 → pošli IR
+        uint32_t code = irCodes[ch];
+        if (code) {
+          traceRecord(TRACE_IR_SEND, TRACE_BEGIN, ch);
+          irsend.sendNEC(code, 32);
+          traceRecord(TRACE_IR_SEND, TRACE_END);
+          bootMark(BOOT_FIRST_IR);
+          lastIrSent[ch] = code;
+          postIrSent(ch, code);
+        }
+      }
+      else if (!highNow && lastIrSent[ch]) {
+        // jakmile poklesne pod 255, smažeme zobrazený kód
+        lastIrSent[ch] = 0;
+        postIrSent(ch, 0);
+      }
+      dmxPrev[ch] = highNow;
+    }
+
+    // 3) Zveřejni rámec pro displej a web (až po IR – nezdržuje signálovou cestu)
+    dmxFrames.publish((uint16_t)slots, nowUs);
+  }
+
+  // 4) Statistiky 1× za sekundu
+  postDmxStats();
+}
+
+static void postCueStatus() {
+  CueStatus st = cueEngine.status();
+  if (st.mode == cuePosted.mode && st.active == cuePosted.active && st.paused == cuePosted.paused &&
+      st.index == cuePosted.index && st.count == cuePosted.count) return;
+  cuePosted = st;
+  SignalEvt evt;
+  evt.type = EVT_CUE_STATE;
+  evt.cue = st;
+  postEvent(evt);
+}
+
+// IR kód v IR→DMX: nejdřív GO/BACK/PAUSE, pak scény (relativní akce a repeat
+// vyřídí dřív nudge.input())
+static void handleIrToDmxCode(uint32_t code, uint32_t nowMs) {
+  for (int c = CUE_GO; c <= CUE_PAUSE; c++) {
+    if (cueIrCodes[c] && code == cueIrCodes[c]) {
+      bootMark(BOOT_FIRST_IR);
+      cueEngine.command((CueCommand)c, nowMs);
+      return;
+    }
+  }
+  for (int i = 1; i <= 6; i++) {
+    if (code == irCodes[i]) {
+      bootMark(BOOT_FIRST_IR);
+      if (i != irToDmxScene || cueEngine.status().active) {
+        irToDmxScene = i;
+        // statická scéna přebírá výstup, další GO bude prolínat z ní
+        cueEngine.release(sceneTable[i - 1]);
+        nudge.clearOffsets();
+        SignalEvt evt;
+        evt.type = EVT_SCENE_SELECTED;
+        evt.scene = (uint8_t)i;
+        postEvent(evt);
+      }
+      break;
+    }
+  }
+}
+
+//
+// Zdroje řízené IR a webem (scéna, cue, show) pro jeden výstupní rámec –
+// společné pro IR→DMX a průchozí režim
+//
+static void updateIrSources(uint32_t nowMs) {
+  // všechny stisky od minulého rámce – žádný se neztratí ani nesplyne
+  IrEvent ir;
+  while (irReceiverPop(ir)) {
+    if (nudge.input(ir.code, ir.repeat, nowMs)) continue;
+    if (!ir.repeat) handleIrToDmxCode(ir.code, nowMs);
+  }
+  nudge.tick(nowMs);
+
+  uint16_t len = 0;
+  const uint8_t *show = showPlaybackFrame(nowMs, len);
+  if (show && len > 1) merger.setLevels(MERGE_SRC_SHOW, show + 1, len - 1);
+  else merger.release(MERGE_SRC_SHOW);
+
+  bool cue = cueEngine.tick(nowMs, cueOut);
+  if (cue) merger.setLevels(MERGE_SRC_CUE, cueOut, CUE_CHANNELS);
+  else merger.release(MERGE_SRC_CUE);
+
+  // běžící cue statickou scénu nahrazuje (GO prolíná z ní), neslučuje se s ní
+  if (!cue && irToDmxScene != -1) merger.setLevels(MERGE_SRC_SCENE, sceneTable[irToDmxScene - 1], SIGNAL_SCENE_CH);
+  else merger.release(MERGE_SRC_SCENE);
+  postCueStatus();
+}
+
+static void recordMerge(uint32_t us, uint16_t channels) {
+  mergeStats.merges++;
+  mergeStats.lastUs = us;
+  if (us > mergeStats.maxUs) mergeStats.maxUs = us;
+  mergeStats.channels = channels;
+}
+
+// Posuny a master z IR ovladače na sloučené kanály (out = kanál 1);
+// vrací počet kanálů k vyslání
+static uint16_t applyNudge(uint8_t *out, uint16_t channels) {
+  uint32_t start = micros();
+  channels = nudge.apply(out, channels);
+  mergeStats.nudgeLastUs = micros() - start;
+  mergeStats.nudgeMaster = nudge.master();
+  mergeStats.nudgeChannels = nudge.active() ? nudge.nudgedChannels() : 0;
+  return channels;
+}
+
+// Výstupní křivky na sloučené kanály (out = kanál 1)
+static void applyCurves(uint8_t *out, uint16_t channels) {
+  const CurveTable &curves = curveSets[curveActive.load(std::memory_order_relaxed)];
+  if (!curves.active()) return;
+  uint32_t start = micros();
+  curves.apply(out, channels);
+  uint32_t us = micros() - start;
+  mergeStats.curveLastUs = us;
+  if (us > mergeStats.curveMaxUs) mergeStats.curveMaxUs = us;
+}
+
+//
+// IR → DMX: výstup v pevném rytmu CUE_TICK_MS. Zdroje (scéna, cue, show, web)
+// se jednou za rámec sloučí podle priorit a HTP/LTP (dmx_merge.h), dostanou
+// posuny a master z IR ovladače (ir_nudge.h) a projdou výstupními křivkami
+// kanálů (output_curves.h).
+//
+static void serviceIrToDmx() {
+  updateIrSources(outTicks * CUE_TICK_MS);
+
+  // úsek = sloučení, zápis a start vysílání; čekání na linku a na takt do něj nepatří
+  uint16_t len = 0;
+  {
+    TraceScope trace(TRACE_DMX_OUT);
+    DmxFrame &frame = dmxFrames.writeBuffer();
+    uint32_t start = micros();
+    uint16_t channels = merger.merge(&frame.slots[1]);
+    recordMerge(micros() - start, channels);
+    channels = applyNudge(&frame.slots[1], channels);
+    applyCurves(&frame.slots[1], channels);
+
+    if (channels) {
+      frame.slots[0] = 0x00;  // start kód
+      len = channels + 1;
+      dmx_write(dmxPort, frame.slots, len);
+      dmxFrames.publish(len, micros());
+      dmx_send(dmxPort, len);
+    }
+    trace.setArg(len);
+  }
+  if (len) dmx_wait_sent(dmxPort, DMX_TIMEOUT_TICK);
+
+  outTicks++;
+  vTaskDelayUntil(&outWake, pdMS_TO_TICKS(CUE_TICK_MS));
+}
+
+#if DMX_THRU_ENABLED
+//
+// Průchozí režim: rámec z portu 1 → sloučení se zdroji IR/webu → port 2.
+// Rytmus určuje vstup; bez vstupu se vysílá po CUE_TICK_MS (dmx_thru.h).
+//
+static void serviceDmxThru() {
+  static uint8_t in[DMX_PACKET_SIZE];
+  size_t slots;
+  uint8_t startCode;
+  DmxFrameResult res = receiveDmxFrame(pdMS_TO_TICKS(CUE_TICK_MS), slots, startCode);
+  uint32_t nowUs = micros();
+  bool frameOk = dmxStats.record(res, nowUs, slots, startCode);
+  dmxStats.tick(nowUs);
+  if (frameOk) {
+    TraceScope trace(TRACE_DMX_FRAME, (uint16_t)slots);
+    dmx_read(dmxPort, in, slots);
+    thru.input(in, (uint16_t)slots, nowUs);
+  } else {
+    thru.idle(nowUs);
+  }
+
+  updateIrSources(millis());
+
+  // předchozí výstup musí být venku, než se přepíše buffer portu 2
+  dmx_wait_sent(thruPort, DMX_TIMEOUT_TICK);
+  {
+    TraceScope trace(TRACE_DMX_OUT);
+    DmxFrame &frame = dmxFrames.writeBuffer();
+    uint32_t start = micros();
+    uint16_t len = thru.output(frame.slots, start);
+    recordMerge(micros() - start, len ? len - 1 : 0);
+    if (len) len = applyNudge(&frame.slots[1], len - 1) + 1;
+    if (len) applyCurves(&frame.slots[1], len - 1);
+    if (len) {
+      dmx_write(thruPort, frame.slots, len);
+      dmx_send(thruPort, len);
+      dmxFrames.publish(len, micros());
+    }
+    trace.setArg(len);
+  }
+  postDmxStats();
+}
+#endif
+
+//
+// IR Learn: první platný (rozpoznaný, ne-repeat) kód pošle UI a vrátí se do klidu
+//
+static void serviceIrLearn() {
+  IrEvent ir;
+  if (!irReceiverPop(ir)) {
+    vTaskDelay(1);
+    return;
+  }
+
+  // ignor repeat (neznámé protokoly fronta vůbec nenese)
+  if (ir.repeat) return;
+
+  SignalEvt evt;
+  evt.type = EVT_IR_LEARNED;
+  evt.learned.protocol = ir.protocol;
+  evt.learned.code = ir.code;
+  postEvent(evt);
+  mode = SIG_IDLE;
+}
+
+void signalTaskStep() {
+  SignalCmd cmd;
+  while (signalCmdQueue.pop(cmd)) applyCmd(cmd);
+  bootMark(BOOT_SIGNAL_READY);
+  // IR události spotřebují jen IR→DMX a IR Learn – jinak se zahazují, ať se
+  // fronta nezaplní (a v DMX→IR nepřijímáme vlastní vysílání)
+  if (mode != SIG_IR_TO_DMX && mode != SIG_IR_LEARN && mode != SIG_DMX_THRU) irReceiverFlush();
+
+  switch (mode) {
+    case SIG_DMX_TO_IR: serviceDmxToIr(); break;
+    case SIG_IR_TO_DMX: serviceIrToDmx(); break;
+    case SIG_IR_LEARN:  serviceIrLearn(); break;
+#if DMX_THRU_ENABLED
+    case SIG_DMX_THRU:  serviceDmxThru(); break;
+#endif
+    default:            vTaskDelay(1);    break;
+  }
+}
+
+static void signalTask(void *) {
+  for (;;) signalTaskStep();
+}
+
+const DmxThruStats &dmxThruStats() {
+  return thru.stats();
+}
+
+void signalTaskStart() {
+  xTaskCreatePinnedToCore(signalTask, "signal", 4096, NULL, SIGNAL_TASK_PRIORITY, NULL, SIGNAL_TASK_CORE);
+}
@@ -0,0 +1,146 @@
+#include <Arduino.h>
+#include <atomic>
+#include <stdarg.h>
+#include "trace.h"
+
+static_assert((TRACE_EVENTS & (TRACE_EVENTS - 1)) == 0, "TRACE_EVENTS musí být mocnina 2");
+
+struct TraceEvent {
+  uint32_t tsUs;
+  uint8_t  id;
+  uint8_t  phase;
+  uint16_t arg;
+};
+
+struct TraceSlot {
+  std::atomic<uint32_t> seq;   // index události + 1, 0 = právě se zapisuje
+  TraceEvent ev;
+};
+
+static TraceSlot ring[TRACE_EVENTS];
+static std::atomic<uint32_t> head(0);
+
+enum TraceTrack : uint8_t { TRACK_SIGNAL = 1, TRACK_IR, TRACK_UI, TRACK_OLED, TRACK_COUNT };
+
+struct TraceInfo {
+  const char *name;
+  const char *argName;   // NULL = bez argumentu
+  uint8_t     track;
+};
+
+static const TraceInfo info[TRACE_IDS] = {
+  { "dmx_frame",     "slots",   TRACK_SIGNAL },
+  { "dmx_out",       "slots",   TRACK_SIGNAL },
+  { "ir_send",       "ch",      TRACK_SIGNAL },
+  { "ir_pop",        "wait_us", TRACK_SIGNAL },
+  { "ir_decode",     "code",    TRACK_IR },
+  { "display_flush", "pages",   TRACK_OLED },
+  { "http",          NULL,      TRACK_UI },
+  { "nvs_write",     NULL,      TRACK_UI },
+  { "flash_write",   "scenes",  TRACK_UI },
+};
+
+static const char *const trackNames[TRACK_COUNT] = {
+  NULL, "signal (core 1)", "ir (core 1)", "ui (core 0)", "oled (core 0)"
+};
+
+void traceRecord(TraceId id, TracePhase phase, uint16_t arg) {
+  // čas před přidělením slotu – konec úseku tak nezahrne čekání na jinou úlohu
+  uint32_t ts = micros();
+  uint32_t idx = head.fetch_add(1, std::memory_order_relaxed);
+  TraceSlot &slot = ring[idx & (TRACE_EVENTS - 1)];
+  slot.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.ev.tsUs = ts;
+  slot.ev.id = id;
+  slot.ev.phase = phase;
+  slot.ev.arg = arg;
+  slot.seq.store(idx + 1, std::memory_order_release);
+}
+
+uint32_t traceRecorded() {
+  return head.load(std::memory_order_relaxed);
+}
+
+// Platné události v pořadí zápisu; rozepsané a přepsané vynechá
+static size_t snapshot(TraceEvent *out) {
+  uint32_t end = head.load(std::memory_order_acquire);
+  uint32_t start = end > TRACE_EVENTS ? end - TRACE_EVENTS : 0;
+  size_t n = 0;
+  for (uint32_t idx = start; idx != end; idx++) {
+    TraceSlot &slot = ring[idx & (TRACE_EVENTS - 1)];
+    if (slot.seq.load(std::memory_order_acquire) != idx + 1) continue;
+    TraceEvent ev = slot.ev;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != idx + 1) continue;
+    out[n++] = ev;
+  }
+  return n;
+}
+
+// Výstup po 512 B – WiFiClient posílá každý write() jako samostatný segment
+struct JsonOut {
+  Print &out;
+  char   buf[512];
+  size_t len;
+  size_t total;
+
+  void flush() {
+    if (len) total += out.write((const uint8_t *)buf, len);
+    len = 0;
+  }
+
+  void add(const char *fmt, ...) {
+    char item[160];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(item, sizeof(item), fmt, ap);
+    va_end(ap);
+    if (n <= 0) return;
+    if ((size_t)n >= sizeof(item)) n = sizeof(item) - 1;
+    if (len + n > sizeof(buf)) flush();
+    memcpy(buf + len, item, n);
+    len += n;
+  }
+};
+
+size_t traceWriteJson(Print &out) {
+  JsonOut json = { out, {0}, 0, 0 };
+  json.add("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (int t = 1; t < TRACK_COUNT; t++) {
+    json.add("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+             t > 1 ? "," : "", t, trackNames[t]);
+  }
+
+  TraceEvent *events = (TraceEvent *)malloc(TRACE_EVENTS * sizeof(TraceEvent));
+  size_t n = events ? snapshot(events) : 0;
+  // nejstarší čas, ne první slot – jinak by dřívější čas v pozdějším slotu podtekl
+  uint32_t base = n ? events[0].tsUs : 0;
+  for (size_t i = 1; i < n; i++) {
+    if ((int32_t)(events[i].tsUs - base) < 0) base = events[i].tsUs;
+  }
+  uint8_t depth[TRACK_COUNT] = {0};
+  for (size_t i = 0; i < n; i++) {
+    const TraceEvent &ev = events[i];
+    if (ev.id >= TRACE_IDS) continue;
+    const TraceInfo &ti = info[ev.id];
+    // začátek bufferu: konec úseku, jehož začátek už byl přepsán
+    if (ev.phase == TRACE_END) {
+      if (!depth[ti.track]) continue;
+      depth[ti.track]--;
+    } else if (ev.phase == TRACE_BEGIN) {
+      depth[ti.track]++;
+    }
+    json.add(",{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u",
+             ti.name, ev.phase, (unsigned long)(ev.tsUs - base), ti.track);
+    if (ev.phase == TRACE_INSTANT) json.add(",\"s\":\"t\"");
+    // argument konce úseku (např. počet stránek) Chrome připojí k úseku
+    if (ti.argName && (ev.phase != TRACE_END || ev.arg)) json.add(",\"args\":{\"%s\":%u}", ti.argName, ev.arg);
+    json.add("}");
+  }
+  free(events);
+
+  json.add("]}\n");
+  json.flush();
+  return json.total;
+}
@@ -0,0 +1,178 @@
+#include <Arduino.h>
+#include <stdarg.h>
+#include "ui_widgets.h"
+#include "log.h"
+
+#ifndef BLACK
+#define BLACK 0
+#define WHITE 1
+#endif
+
+UiRenderStats uiRenderStats = {};
+
+// ========================
+// UiWidget
+// ========================
+void UiWidget::render(Adafruit_GFX &gfx) {
+  gfx.fillRect(x, y, w, h, BLACK);
+  draw(gfx);
+  dirty = false;
+}
+
+// ========================
+// UiLabel
+// ========================
+UiLabel::UiLabel(int16_t x, int16_t y, uint8_t cols, uint8_t size)
+    : UiWidget(x, y, cols * UI_FONT_W * size, UI_FONT_H * size), cols(cols), size(size) {
+  text[0] = '\0';
+}
+
+void UiLabel::setText(const char *s) {
+  char buf[UI_MAX_COLS + 1];
+  strncpy(buf, s, cols);
+  buf[cols] = '\0';
+  if (strcmp(buf, text) == 0) return;
+  strcpy(text, buf);
+  dirty = true;
+}
+
+void UiLabel::setTextf(const char *fmt, ...) {
+  char buf[UI_MAX_COLS + 1];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  setText(buf);
+}
+
+void UiLabel::draw(Adafruit_GFX &gfx) {
+  gfx.setTextSize(size);
+  gfx.setTextColor(WHITE);
+  gfx.setCursor(x, y);
+  gfx.print(text);
+}
+
+// ========================
+// UiValue
+// ========================
+UiValue::UiValue(int16_t x, int16_t y, const char *prefix, uint8_t digits)
+    : UiWidget(x, y, (strlen(prefix) + digits) * UI_FONT_W, UI_FONT_H),
+      prefix(prefix), value(0), digits(digits), valid(false) {}
+
+void UiValue::setValue(int32_t v) {
+  if (valid && v == value) return;
+  value = v;
+  valid = true;
+  dirty = true;
+}
+
+void UiValue::draw(Adafruit_GFX &gfx) {
+  char buf[UI_MAX_COLS + 1];
+  snprintf(buf, sizeof(buf), "%s%*ld", prefix, digits, (long)value);
+  gfx.setTextSize(1);
+  gfx.setTextColor(WHITE);
+  gfx.setCursor(x, y);
+  gfx.print(buf);
+}
+
+// ========================
+// UiList
+// ========================
+UiList::UiList(int16_t x, int16_t y, uint8_t rows)
+    : UiWidget(x, y, UI_MAX_COLS * UI_FONT_W, rows * UI_FONT_H),
+      rows(rows), count(0), selected(-1), dirtyRows(0xFF) {
+  memset(items, 0, sizeof(items));
+}
+
+void UiList::setCount(uint8_t n) {
+  if (n > rows) n = rows;
+  if (n == count) return;
+  // zmizelé i nové řádky
+  for (uint8_t i = (n < count ? n : count); i < rows; i++) dirtyRows |= (1 << i);
+  count = n;
+  dirty = true;
+}
+
+void UiList::setItem(uint8_t i, const char *s) {
+  if (i >= rows) return;
+  char buf[UI_MAX_COLS - 1];
+  strncpy(buf, s, sizeof(buf) - 1);
+  buf[sizeof(buf) - 1] = '\0';
+  if (strcmp(buf, items[i]) == 0) return;
+  strcpy(items[i], buf);
+  dirtyRows |= (1 << i);
+  dirty = true;
+}
+
+void UiList::setSelected(int8_t i) {
+  if (i == selected) return;
+  // stačí překreslit starý a nový řádek kurzoru
+  if (selected >= 0 && selected < rows) dirtyRows |= (1 << selected);
+  if (i >= 0 && i < rows) dirtyRows |= (1 << i);
+  selected = i;
+  dirty = true;
+}
+
+void UiList::drawRow(Adafruit_GFX &gfx, uint8_t row) {
+  int16_t ry = y + row * UI_FONT_H;
+  gfx.fillRect(x, ry, w, UI_FONT_H, BLACK);
+  if (row >= count) return;
+  gfx.setTextSize(1);
+  gfx.setTextColor(WHITE);
+  gfx.setCursor(x, ry);
+  gfx.print((row == selected) ? "> " : "  ");
+  gfx.print(items[row]);
+}
+
+void UiList::invalidate() {
+  dirtyRows = 0xFF;
+  dirty = true;
+}
+
+void UiList::render(Adafruit_GFX &gfx) {
+  for (uint8_t i = 0; i < rows; i++) {
+    if (dirtyRows & (1 << i)) drawRow(gfx, i);
+  }
+  dirtyRows = 0;
+  dirty = false;
+}
+
+void UiList::draw(Adafruit_GFX &gfx) {
+  for (uint8_t i = 0; i < rows; i++) drawRow(gfx, i);
+}
+
+// ========================
+// UiScreen
+// ========================
+bool UiScreen::add(UiWidget *w) {
+  if (count >= UI_MAX_WIDGETS) {
+    LOG_E("UiScreen: víc než %d widgetů, widget se nezobrazí", UI_MAX_WIDGETS);
+    return false;
+  }
+  widgets[count++] = w;
+  return true;
+}
+
+void UiScreen::invalidateAll() {
+  for (uint8_t i = 0; i < count; i++) widgets[i]->invalidate();
+}
+
+uint8_t UiScreen::render(Adafruit_GFX &gfx) {
+  uint32_t start = micros();
+  uint8_t drawn = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (!widgets[i]->isDirty()) continue;
+    widgets[i]->render(gfx);
+    drawn++;
+  }
+  if (drawn == 0) {
+    uiRenderStats.skipped++;
+    return 0;
+  }
+  uint32_t us = micros() - start;
+  uiRenderStats.renders++;
+  uiRenderStats.widgetsDrawn += drawn;
+  uiRenderStats.lastRenderUs = us;
+  if (us > uiRenderStats.maxRenderUs) uiRenderStats.maxRenderUs = us;
+  return drawn;
+}
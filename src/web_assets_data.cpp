@@ -0,0 +1,177 @@
+// Vygenerováno tools/build_web_assets.py z web/ – neupravovat ručně
+#include "web_assets.h"
+
+static const uint8_t asset_app_js[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x58, 0x4d, 0x6f, 0xdb, 0x36,
+  0x18, 0xbe, 0xfb, 0x57, 0x70, 0xbe, 0xd0, 0x5a, 0x02, 0x59, 0x6e, 0x92, 0x26, 0x4d, 0x6c, 0x0f,
+  0x8e, 0xed, 0x34, 0xd9, 0x9a, 0x34, 0x58, 0xb2, 0x00, 0x83, 0x61, 0x14, 0xb4, 0xc4, 0xc4, 0xb4,
+  0x25, 0xd1, 0xd3, 0x87, 0x5b, 0x77, 0x2d, 0xb0, 0x3f, 0xb0, 0xd3, 0x4e, 0x3d, 0xf6, 0xb8, 0x43,
+  0xb1, 0xc3, 0xee, 0xbb, 0x64, 0xf9, 0x23, 0xfb, 0x25, 0x7b, 0x49, 0x91, 0x32, 0xe5, 0x8f, 0x38,
+  0x03, 0x16, 0xc0, 0xb1, 0x44, 0xbe, 0x1f, 0xcf, 0xfb, 0xc9, 0x97, 0xae, 0x56, 0xd1, 0x55, 0x12,
+  0xdd, 0x7f, 0x0e, 0xc7, 0x04, 0x9d, 0x7d, 0x8f, 0xc6, 0xf7, 0x7f, 0x7a, 0x0f, 0x7f, 0xa0, 0x7f,
+  0x7e, 0xf9, 0x0d, 0xc5, 0x09, 0x49, 0x98, 0x3b, 0xbe, 0xff, 0x8c, 0x2a, 0x77, 0xef, 0xd9, 0x04,
+  0x4d, 0x29, 0xba, 0xf5, 0x49, 0x3c, 0xdc, 0x46, 0xdd, 0x6b, 0x72, 0x67, 0x1d, 0x21, 0x6f, 0x16,
+  0x92, 0x20, 0xa3, 0x18, 0xc5, 0x3c, 0x45, 0x23, 0x1a, 0x96, 0xaa, 0x55, 0x94, 0xfa, 0xfc, 0xe1,
+  0x2f, 0x1a, 0xc2, 0xea, 0xdf, 0xbf, 0xde, 0x7f, 0x89, 0x7d, 0xa2, 0x85, 0xbe, 0x47, 0x55, 0x32,
+  0x61, 0x55, 0x16, 0xb9, 0xdc, 0xa3, 0x31, 0x22, 0x88, 0x05, 0x13, 0x1e, 0x25, 0x7c, 0x4a, 0x04,
+  0xf1, 0x38, 0x64, 0x43, 0x3e, 0x0d, 0xc9, 0x9c, 0xcc, 0x67, 0x03, 0x5b, 0x08, 0x3c, 0xe1, 0x51,
+  0x90, 0xfa, 0xf7, 0x9f, 0x1f, 0x3e, 0xa1, 0x09, 0x8f, 0xef, 0xbf, 0xc0, 0x23, 0x72, 0x87, 0x24,
+  0x0c, 0xa9, 0x7f, 0xf1, 0x26, 0xa0, 0xc9, 0x90, 0x7b, 0x20, 0x4c, 0x08, 0x85, 0x57, 0x12, 0xa6,
+  0xc4, 0xdf, 0x56, 0x6f, 0x20, 0x21, 0x22, 0xd1, 0xec, 0xcd, 0xd7, 0xdb, 0x42, 0x8e, 0x5a, 0xa3,
+  0x24, 0x0a, 0xa9, 0x87, 0x42, 0x3a, 0xe0, 0x6a, 0x29, 0xc3, 0x41, 0x3d, 0xbb, 0x34, 0x25, 0x11,
+  0x52, 0x4c, 0x1d, 0x92, 0x10, 0xd4, 0x40, 0x3f, 0x97, 0x10, 0xc2, 0x57, 0x24, 0x88, 0xd3, 0xf0,
+  0x0e, 0x1f, 0xca, 0x57, 0x58, 0xb8, 0xbe, 0xc9, 0x9f, 0xe1, 0xed, 0x92, 0xbf, 0xa5, 0x11, 0x2c,
+  0xe0, 0xae, 0xd3, 0x75, 0x76, 0x9d, 0xe3, 0x13, 0xbc, 0x8d, 0xf0, 0x0d, 0xf7, 0xd3, 0x80, 0xa2,
+  0x1f, 0x26, 0x7a, 0xa3, 0xeb, 0xd4, 0xcc, 0x8d, 0x0e, 0x7f, 0x1b, 0xea, 0xad, 0x8e, 0xf3, 0x0c,
+  0xb6, 0xb4, 0xb8, 0x76, 0x66, 0x9b, 0xc1, 0xba, 0x7b, 0x70, 0xbc, 0x2f, 0x58, 0xf5, 0x8e, 0xc9,
+  0xeb, 0x1c, 0x9c, 0xec, 0x63, 0xc9, 0xfa, 0x31, 0x93, 0x80, 0xaf, 0x78, 0x1a, 0x7a, 0x03, 0x12,
+  0xad, 0x85, 0x78, 0xe2, 0x38, 0x12, 0xc9, 0x79, 0x9a, 0xd0, 0x39, 0x04, 0xe7, 0x11, 0xd8, 0x99,
+  0xfc, 0x92, 0xd2, 0x81, 0x5f, 0xbd, 0xdc, 0xe8, 0x8a, 0x67, 0x4e, 0xe7, 0xa4, 0xe6, 0x74, 0x97,
+  0x65, 0x8a, 0x8d, 0x83, 0x83, 0xfd, 0xfd, 0x15, 0xae, 0x10, 0x5b, 0x2f, 0x0e, 0x9e, 0xef, 0xcf,
+  0x5d, 0x71, 0x16, 0x4e, 0xd2, 0x04, 0x9d, 0x76, 0xce, 0xcf, 0x6a, 0x9a, 0x00, 0x70, 0x2e, 0xe1,
+  0xb9, 0xe2, 0xe1, 0x6c, 0x23, 0xa2, 0xd6, 0x0b, 0x67, 0x09, 0xcc, 0x6e, 0x61, 0x4d, 0xe3, 0x68,
+  0x67, 0xab, 0xda, 0x3d, 0xcf, 0xe0, 0x75, 0x41, 0xe1, 0x25, 0x09, 0x49, 0xcc, 0x43, 0xe6, 0x6e,
+  0xd4, 0xba, 0xeb, 0x38, 0xbb, 0xcb, 0x6a, 0x1d, 0xa7, 0xbd, 0x42, 0x2f, 0x2c, 0x77, 0x8b, 0xa1,
+  0xec, 0xdc, 0x74, 0x0a, 0x52, 0x7d, 0x22, 0xec, 0xc4, 0x7b, 0x2a, 0x58, 0x97, 0x24, 0x8d, 0x69,
+  0xb6, 0x50, 0x93, 0x90, 0xaf, 0x12, 0x3e, 0x51, 0x04, 0xc7, 0x4b, 0x98, 0x87, 0xcc, 0x67, 0x93,
+  0x78, 0x23, 0xe2, 0x1d, 0xa7, 0xbd, 0x1c, 0xb5, 0x1d, 0xf0, 0xfc, 0x0a, 0xc4, 0x3b, 0x22, 0xc2,
+  0x0b, 0x7a, 0x7e, 0x24, 0x01, 0x19, 0x92, 0xb9, 0x9a, 0xd6, 0x0d, 0xfa, 0x9e, 0xba, 0x94, 0x4d,
+  0xe9, 0xea, 0x8c, 0x6c, 0xed, 0xed, 0xb5, 0x4c, 0x77, 0xb7, 0x76, 0xb3, 0xf7, 0x82, 0xfe, 0x56,
+  0x6d, 0xaf, 0xbb, 0x42, 0x7f, 0xcb, 0xd9, 0xeb, 0x2e, 0xea, 0x7f, 0x49, 0x43, 0x1a, 0x99, 0x91,
+  0x69, 0xb1, 0x08, 0xb5, 0x79, 0xe8, 0xb1, 0x84, 0xf1, 0x70, 0x0d, 0x08, 0x33, 0x5d, 0xaf, 0x69,
+  0x30, 0x31, 0x92, 0x55, 0x17, 0xb4, 0x5c, 0x36, 0x53, 0xf5, 0xc0, 0xd9, 0x37, 0xaa, 0xf6, 0x1c,
+  0x5a, 0x09, 0xa8, 0xe1, 0xbe, 0xde, 0x6e, 0x3b, 0x3b, 0x59, 0x95, 0x89, 0x8d, 0x53, 0x4a, 0x12,
+  0xbd, 0x21, 0x3e, 0x06, 0xe8, 0xd2, 0xc7, 0x23, 0xd9, 0x77, 0x44, 0xeb, 0xba, 0x20, 0x01, 0x74,
+  0x46, 0xe8, 0x3a, 0xa6, 0x19, 0x4b, 0x06, 0x20, 0xe0, 0x28, 0xdd, 0xa6, 0xa1, 0x2b, 0xde, 0x11,
+  0xf5, 0x2b, 0xcc, 0xb3, 0x80, 0x25, 0xa2, 0x49, 0x1a, 0x85, 0xc8, 0xe3, 0x2e, 0xb8, 0x28, 0x4c,
+  0xec, 0x3b, 0x9a, 0x74, 0x7d, 0x2a, 0x1e, 0x8f, 0x67, 0x67, 0x9e, 0x20, 0x3a, 0x02, 0x6d, 0x73,
+  0x46, 0x3e, 0x11, 0x5f, 0x71, 0x65, 0x4c, 0x67, 0xf1, 0x36, 0xf2, 0xc9, 0x80, 0xfa, 0x96, 0x74,
+  0x8d, 0x12, 0x24, 0xd6, 0xed, 0x80, 0x4c, 0x2a, 0x39, 0x47, 0x65, 0x6c, 0x29, 0xdf, 0x29, 0x92,
+  0x72, 0x3d, 0x13, 0x82, 0xa6, 0xc4, 0x4f, 0x69, 0x03, 0x97, 0xd1, 0x16, 0x1a, 0xc3, 0xa7, 0x8c,
+  0x9b, 0xe2, 0xb1, 0x22, 0x85, 0xa2, 0x6f, 0x32, 0xe1, 0x82, 0xfb, 0x10, 0xc1, 0x3f, 0xd8, 0xaf,
+  0x57, 0x33, 0xc6, 0x66, 0xf9, 0x48, 0xf8, 0xc0, 0xb2, 0x47, 0x9c, 0x85, 0x15, 0x8c, 0xad, 0xa3,
+  0x92, 0x09, 0x51, 0xb5, 0xf9, 0xd3, 0x24, 0x00, 0x23, 0xb3, 0xae, 0x2e, 0xa0, 0xb2, 0x41, 0x86,
+  0x43, 0xb8, 0xcd, 0x05, 0x77, 0x61, 0xb1, 0x81, 0x41, 0x2e, 0xd0, 0x04, 0xf2, 0x3d, 0xe3, 0x93,
+  0x4b, 0xf0, 0xc1, 0xea, 0x98, 0xc0, 0x47, 0x8a, 0x29, 0x22, 0x1e, 0xe3, 0x40, 0x38, 0xb7, 0x6c,
+  0xba, 0x8d, 0x12, 0xfa, 0x2e, 0x01, 0x1d, 0x43, 0xea, 0x8e, 0xa9, 0xb7, 0x64, 0x28, 0x93, 0xad,
+  0x28, 0x99, 0x4d, 0xc0, 0x4c, 0xc9, 0x8e, 0x11, 0x1c, 0x7f, 0xca, 0xe6, 0x40, 0xda, 0x6c, 0x7a,
+  0x61, 0x2a, 0x57, 0xa4, 0x13, 0x94, 0x44, 0x70, 0x03, 0xd6, 0xd2, 0x31, 0x38, 0x02, 0x8c, 0x45,
+  0x5b, 0x2a, 0x7b, 0xe4, 0x5f, 0x19, 0xf1, 0xd0, 0xf5, 0xe1, 0x40, 0x6d, 0xe0, 0x78, 0xc8, 0xdf,
+  0xbe, 0x56, 0xe1, 0x29, 0x2b, 0x23, 0xca, 0x16, 0x6e, 0x22, 0xf1, 0x22, 0x70, 0x0a, 0xa3, 0x90,
+  0x34, 0xe7, 0xa3, 0xb6, 0x49, 0x1f, 0x6c, 0x8d, 0xa5, 0xa8, 0x38, 0xb8, 0x79, 0x01, 0x89, 0x53,
+  0xf4, 0xf9, 0x2d, 0x8f, 0xc0, 0x6a, 0xe0, 0x1b, 0x01, 0x47, 0xed, 0x08, 0xbe, 0xea, 0x0d, 0xf4,
+  0x1c, 0xbe, 0xb7, 0xb6, 0xb4, 0xed, 0xec, 0x16, 0xc0, 0x0b, 0x97, 0xf7, 0x46, 0x7d, 0xf4, 0x15,
+  0xb8, 0xd5, 0x51, 0x7f, 0x80, 0x5c, 0x6b, 0xdb, 0x6a, 0xac, 0x4c, 0x82, 0x9c, 0x4d, 0xe6, 0x42,
+  0x5b, 0x94, 0x80, 0x58, 0x1e, 0x49, 0xdc, 0x15, 0xe7, 0x1d, 0x2e, 0xd2, 0x60, 0x2b, 0x07, 0x97,
+  0x19, 0xa5, 0x6c, 0xd2, 0x27, 0x33, 0x40, 0x14, 0xd3, 0x40, 0x31, 0x19, 0xe9, 0x13, 0x92, 0x91,
+  0xda, 0x42, 0xcb, 0x3c, 0x23, 0xa9, 0x2d, 0x82, 0x66, 0xa2, 0xc8, 0x29, 0x96, 0x30, 0xcc, 0x93,
+  0x12, 0x7d, 0xf8, 0xf0, 0x34, 0xa7, 0xe6, 0x48, 0x3c, 0x36, 0x45, 0x2e, 0x4c, 0x4b, 0x71, 0x23,
+  0xcf, 0xc5, 0x66, 0x7d, 0xb8, 0xd3, 0xfc, 0x4e, 0xcc, 0x3a, 0x3e, 0xd2, 0x31, 0xc5, 0xf5, 0x2a,
+  0x2c, 0x62, 0x95, 0x07, 0x32, 0xad, 0x2a, 0x38, 0x9b, 0x61, 0x64, 0xeb, 0xd0, 0x4f, 0x49, 0x94,
+  0x52, 0x51, 0x37, 0x8a, 0x42, 0x8d, 0x28, 0x82, 0xe4, 0x95, 0x7a, 0x34, 0x77, 0xb3, 0xd0, 0xc8,
+  0x5d, 0xf5, 0x68, 0x15, 0x35, 0x68, 0xb7, 0x0a, 0x92, 0x33, 0xfd, 0xac, 0x69, 0x0a, 0xe0, 0xc1,
+  0xb8, 0x18, 0x23, 0xe6, 0x35, 0x64, 0x89, 0xa9, 0xf1, 0xea, 0x4d, 0x9e, 0x92, 0xb8, 0x99, 0x41,
+  0x3c, 0x44, 0x85, 0xfa, 0x10, 0x19, 0x6a, 0x96, 0x87, 0x2b, 0x68, 0x15, 0x33, 0x5e, 0x4e, 0x13,
+  0xa6, 0xd2, 0xa4, 0x5e, 0x05, 0xcd, 0x22, 0x4c, 0x1b, 0x71, 0xe8, 0xc1, 0x6e, 0x0e, 0x04, 0xc6,
+  0xd5, 0x99, 0x0f, 0x52, 0x3d, 0x16, 0x4f, 0xe0, 0x94, 0x3c, 0x0c, 0x21, 0x36, 0x38, 0x97, 0x05,
+  0xd2, 0x04, 0xd0, 0x5b, 0xe2, 0x42, 0x7c, 0x68, 0x04, 0x70, 0x63, 0xea, 0x53, 0x37, 0x59, 0xc2,
+  0xa8, 0x05, 0x07, 0x06, 0xf5, 0x63, 0x7a, 0x17, 0x08, 0xa1, 0x80, 0x21, 0xda, 0x77, 0x20, 0x32,
+  0x9d, 0x78, 0x24, 0xa1, 0x1d, 0x3a, 0x65, 0x2e, 0xbd, 0x06, 0xa7, 0x14, 0xca, 0xb8, 0x6c, 0x14,
+  0xbe, 0xee, 0xc2, 0xaf, 0x07, 0x23, 0x00, 0x64, 0x8b, 0xa6, 0x5b, 0x31, 0x46, 0x50, 0x6b, 0x1b,
+  0x15, 0xdb, 0xaf, 0xce, 0xb1, 0xfc, 0xb8, 0xe8, 0x8d, 0xfb, 0x22, 0x3f, 0xc7, 0xd0, 0xdc, 0xad,
+  0x2c, 0xa5, 0x32, 0xdb, 0x9a, 0xf5, 0x41, 0x94, 0xa7, 0x16, 0x38, 0x20, 0xc3, 0x82, 0x04, 0x98,
+  0xcd, 0xf6, 0x7b, 0x92, 0x58, 0x44, 0xf3, 0x51, 0xeb, 0x4d, 0xb2, 0x45, 0xdb, 0xdb, 0x3c, 0x00,
+  0x8c, 0x5e, 0xc1, 0xf0, 0x02, 0x36, 0x23, 0x38, 0x8a, 0x76, 0x33, 0x2e, 0x37, 0x23, 0x7c, 0x14,
+  0x94, 0xa6, 0x99, 0x6b, 0xd3, 0x9a, 0x70, 0x96, 0x61, 0xf8, 0x29, 0x19, 0x96, 0x55, 0xce, 0xc6,
+  0x0c, 0x53, 0x15, 0xf6, 0x08, 0x72, 0x55, 0x82, 0xb2, 0xfd, 0xe4, 0x5d, 0xd3, 0x0c, 0xd3, 0x93,
+  0x31, 0xe9, 0xb2, 0xdd, 0x08, 0x4a, 0xd7, 0x34, 0xaa, 0xd4, 0x09, 0x1a, 0x46, 0xf4, 0xb6, 0x81,
+  0xe1, 0x3e, 0x95, 0xb1, 0xe3, 0x66, 0xf6, 0x5d, 0xaf, 0x92, 0xa6, 0x75, 0x88, 0x8c, 0x20, 0xac,
+  0xb3, 0x20, 0xef, 0x16, 0xd2, 0x84, 0xbc, 0x25, 0xaf, 0xb7, 0x41, 0xbb, 0xb9, 0x78, 0x96, 0x2f,
+  0x55, 0x84, 0x6a, 0x8c, 0xf3, 0xa3, 0x5c, 0xa4, 0x34, 0x74, 0x7a, 0x98, 0x14, 0x8a, 0xa1, 0x95,
+  0x87, 0x85, 0xba, 0xfa, 0xc8, 0xc3, 0xdc, 0xac, 0x39, 0xcb, 0x96, 0xfd, 0x44, 0x74, 0xdf, 0x8d,
+  0x8c, 0x46, 0xba, 0x5a, 0x36, 0x83, 0xe5, 0xe8, 0xf4, 0xfa, 0xfc, 0x15, 0xa8, 0xdc, 0x50, 0x84,
+  0x3d, 0xa1, 0xb1, 0x6f, 0x59, 0x42, 0x49, 0x31, 0xb9, 0xb5, 0x0d, 0xab, 0x4c, 0x5d, 0xa4, 0xf9,
+  0xdf, 0xec, 0x94, 0x63, 0x4f, 0xe0, 0xc5, 0xd9, 0xa9, 0x58, 0x04, 0xd9, 0xfb, 0x6f, 0x4e, 0x90,
+  0x32, 0xfb, 0x4f, 0x72, 0x9e, 0x2e, 0xab, 0x82, 0xe7, 0x4a, 0xeb, 0x5a, 0x98, 0xc0, 0xb7, 0xb6,
+  0x77, 0x8d, 0x0b, 0x63, 0x00, 0x50, 0x8a, 0x1e, 0x26, 0x4e, 0x60, 0x2c, 0x9a, 0x58, 0xd1, 0x97,
+  0xe6, 0x28, 0xb4, 0xec, 0x49, 0x70, 0x41, 0x3e, 0xef, 0xfe, 0x94, 0xd2, 0x68, 0x76, 0x25, 0x13,
+  0x92, 0x47, 0x70, 0xc8, 0x89, 0x03, 0xa9, 0x27, 0x93, 0xb9, 0x6c, 0xcc, 0x83, 0x05, 0x07, 0xcb,
+  0xa9, 0xb0, 0xdc, 0x3f, 0xd4, 0x63, 0xd9, 0xaa, 0x64, 0x52, 0x67, 0x1e, 0x46, 0x73, 0x66, 0xcb,
+  0x96, 0x65, 0x67, 0xab, 0xaa, 0x03, 0x10, 0x15, 0x40, 0x02, 0x03, 0x92, 0x3a, 0xe2, 0x2c, 0x24,
+  0x86, 0xbd, 0x81, 0xcf, 0xdd, 0xb1, 0x9c, 0xf4, 0x64, 0x55, 0x6e, 0x72, 0xf2, 0x5a, 0xa1, 0x7e,
+  0x7e, 0xc4, 0x6f, 0x12, 0xaa, 0x7a, 0xd6, 0x93, 0x84, 0xe6, 0x93, 0xc1, 0x06, 0xa1, 0x79, 0xd3,
+  0x79, 0x8a, 0x54, 0x36, 0x1f, 0x26, 0x56, 0x8b, 0x15, 0x23, 0xe5, 0xa2, 0x55, 0x6b, 0x1b, 0x43,
+  0x31, 0x11, 0xe0, 0x3a, 0xf3, 0x2d, 0xdc, 0xb9, 0x2b, 0x69, 0xe4, 0x1b, 0xa9, 0x74, 0x4b, 0x13,
+  0x77, 0x28, 0xd7, 0xec, 0x64, 0x48, 0x43, 0x63, 0x3c, 0x8c, 0x0c, 0xaa, 0xc8, 0x1e, 0x09, 0x56,
+  0x4b, 0xa6, 0x97, 0xb8, 0x04, 0x5d, 0x46, 0x3c, 0x60, 0x31, 0xb5, 0x89, 0xef, 0x57, 0x7a, 0x5a,
+  0x32, 0x36, 0x7f, 0x9f, 0xc2, 0x90, 0xbd, 0x8b, 0x1b, 0x80, 0x19, 0x5b, 0xfd, 0x25, 0x4d, 0x9e,
+  0x71, 0x1b, 0x91, 0x3f, 0x6d, 0x35, 0x50, 0x0f, 0xe3, 0x3e, 0x0c, 0x96, 0xa1, 0x4b, 0x92, 0x8a,
+  0xd7, 0x73, 0xfa, 0x72, 0xc8, 0x8c, 0x41, 0x37, 0x42, 0xd5, 0x2a, 0x62, 0xa1, 0x47, 0xdf, 0xa1,
+  0x9a, 0x6d, 0x3f, 0x07, 0xd2, 0xb1, 0x1c, 0x09, 0x15, 0xff, 0x10, 0x6e, 0x3a, 0xe2, 0x02, 0x83,
+  0x0b, 0x23, 0x3a, 0xcb, 0x46, 0x74, 0xa6, 0x46, 0x74, 0x26, 0x46, 0x74, 0x49, 0x09, 0xd3, 0xf7,
+  0xea, 0x2b, 0x92, 0xd7, 0xab, 0xe5, 0x3a, 0x75, 0x34, 0x33, 0xc2, 0x78, 0xa1, 0xf5, 0x09, 0x39,
+  0xe0, 0x68, 0xcb, 0x06, 0xa8, 0xe0, 0xc9, 0xb9, 0x55, 0x99, 0x51, 0xab, 0x38, 0xaf, 0xc5, 0x05,
+  0x04, 0x40, 0x5e, 0xd0, 0x09, 0xf7, 0xc8, 0xc3, 0x27, 0xe6, 0x73, 0x14, 0x53, 0x38, 0x37, 0xe4,
+  0x0f, 0x7e, 0x49, 0xfe, 0x0b, 0xe0, 0xef, 0xf2, 0x97, 0xbf, 0x99, 0x2d, 0x0e, 0x02, 0x80, 0xf1,
+  0x2f, 0xc1, 0x7d, 0x13, 0xd1, 0x6b, 0x14, 0x00, 0x00,
+};
+
+static const uint8_t asset_index_html[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x65, 0x53, 0xc1, 0x6e, 0xd4, 0x30,
+  0x10, 0xbd, 0xf3, 0x15, 0x43, 0x4e, 0x20, 0x75, 0x37, 0x5a, 0xa4, 0x4a, 0x1c, 0x92, 0x1c, 0xd8,
+  0x16, 0xe8, 0xa1, 0x05, 0xc1, 0x56, 0x02, 0x6e, 0x8e, 0x3d, 0xdb, 0xb8, 0x71, 0x6c, 0xcb, 0x76,
+  0xb2, 0x84, 0x13, 0x3f, 0xc0, 0x07, 0x54, 0x9c, 0xf6, 0xc2, 0x6d, 0x4f, 0x9c, 0xe1, 0x92, 0xf6,
+  0x47, 0xf8, 0x12, 0xc6, 0x49, 0x85, 0xaa, 0x70, 0xf1, 0x8c, 0xe7, 0xbd, 0xf1, 0x8c, 0x5e, 0x5e,
+  0xb2, 0xc7, 0x27, 0x6f, 0xd6, 0x9b, 0x8f, 0x6f, 0x4f, 0xa1, 0x0a, 0x8d, 0x2a, 0x1e, 0x65, 0x63,
+  0xc8, 0x2a, 0x64, 0xa2, 0xc8, 0x1a, 0x0c, 0x0c, 0x78, 0xc5, 0x9c, 0xc7, 0x90, 0x27, 0x97, 0x9b,
+  0x97, 0x8b, 0xe7, 0xc9, 0x7d, 0x55, 0xb3, 0x06, 0xf3, 0xa4, 0x93, 0xb8, 0xb3, 0xc6, 0x85, 0x04,
+  0xb8, 0xd1, 0x01, 0x35, 0xb1, 0x76, 0x52, 0x84, 0x2a, 0x17, 0xd8, 0x49, 0x8e, 0x8b, 0xf1, 0x72,
+  0x24, 0xb5, 0x0c, 0x92, 0xa9, 0x85, 0xe7, 0x4c, 0x61, 0xbe, 0x4a, 0x68, 0x4a, 0x90, 0x41, 0x61,
+  0x71, 0xf6, 0x0e, 0xd6, 0x46, 0x20, 0x1d, 0x7a, 0x2b, 0xaf, 0xb2, 0x74, 0xaa, 0x66, 0x4a, 0xea,
+  0x1a, 0x1c, 0xaa, 0x3c, 0xf1, 0xa1, 0x57, 0xe8, 0x2b, 0x44, 0x9a, 0x50, 0x39, 0xdc, 0xe6, 0x49,
+  0x3a, 0x96, 0x96, 0xdc, 0x7b, 0xda, 0x24, 0x9d, 0xd6, 0x2c, 0x8d, 0xe8, 0xe9, 0x4d, 0xcd, 0x3a,
+  0x3a, 0xd9, 0x3f, 0x22, 0x47, 0x8d, 0xc4, 0x3a, 0x39, 0xff, 0x00, 0xef, 0xc7, 0x3c, 0x4b, 0x59,
+  0x01, 0x0f, 0x08, 0x95, 0xd9, 0xdd, 0xc3, 0x94, 0xcd, 0x40, 0xde, 0xc6, 0xde, 0x75, 0x3b, 0x75,
+  0x3d, 0x78, 0xb6, 0x41, 0x77, 0x85, 0x49, 0x71, 0x1e, 0xc3, 0x7f, 0x3d, 0xae, 0x9b, 0xba, 0x62,
+  0x9c, 0x81, 0xba, 0x15, 0xb1, 0xef, 0x22, 0x86, 0x19, 0x24, 0x9d, 0x6c, 0x46, 0x15, 0xa3, 0x20,
+  0x67, 0x63, 0x3a, 0x63, 0x94, 0x8c, 0xd7, 0xad, 0x4d, 0x8a, 0x17, 0x63, 0x9c, 0x81, 0x24, 0x02,
+  0x41, 0xaf, 0xe9, 0x9c, 0x56, 0x4d, 0x27, 0x21, 0xaa, 0xd5, 0x4c, 0xdf, 0xd6, 0xb1, 0x20, 0x8d,
+  0x26, 0xd5, 0x56, 0x04, 0xdb, 0xe2, 0x13, 0x13, 0x78, 0x1d, 0x10, 0x88, 0x55, 0x0f, 0x3f, 0x05,
+  0x3c, 0xa9, 0xf0, 0xf3, 0x53, 0xd0, 0x58, 0x1a, 0xe8, 0xfa, 0x12, 0x1d, 0x41, 0x5f, 0xe8, 0x3b,
+  0x97, 0xc3, 0x41, 0xd4, 0x3d, 0x58, 0x67, 0x40, 0x30, 0x3d, 0xfc, 0x82, 0xa8, 0x58, 0x4d, 0xd9,
+  0x5e, 0x1d, 0x41, 0x1d, 0xd0, 0x51, 0xa9, 0x6c, 0x69, 0x4a, 0xd7, 0x7b, 0x35, 0xec, 0x35, 0xd8,
+  0xbb, 0x1b, 0x09, 0x95, 0x11, 0xda, 0x84, 0xdb, 0xef, 0xf0, 0xec, 0xf8, 0x78, 0x99, 0xa5, 0x96,
+  0x26, 0x6e, 0x8d, 0x6b, 0x80, 0xf1, 0xb8, 0x03, 0x6d, 0x9d, 0x00, 0xf9, 0x88, 0x58, 0x79, 0xf2,
+  0xea, 0x74, 0x13, 0x2d, 0x21, 0x64, 0x07, 0x92, 0xae, 0xe4, 0x37, 0xad, 0x51, 0x91, 0x8e, 0x17,
+  0xec, 0xf6, 0xdb, 0x70, 0x08, 0xc3, 0xbe, 0xf9, 0xf3, 0xf5, 0x47, 0x96, 0x12, 0x81, 0x68, 0x52,
+  0xdb, 0x36, 0x40, 0xe8, 0x2d, 0xd9, 0xcf, 0xb7, 0x65, 0x23, 0xc9, 0x1a, 0x1d, 0x53, 0x2d, 0x5d,
+  0x2f, 0x95, 0xb9, 0xfb, 0x2d, 0x03, 0xed, 0xec, 0x03, 0xeb, 0x50, 0x0f, 0x87, 0xf8, 0x6e, 0x1a,
+  0xe7, 0x52, 0xf4, 0xdc, 0x49, 0x1b, 0xc0, 0x3b, 0x4e, 0xd3, 0x99, 0xb5, 0xcb, 0xeb, 0xd1, 0x42,
+  0x53, 0x39, 0xf2, 0x46, 0x1b, 0x91, 0x3a, 0xe3, 0x7f, 0xf0, 0x17, 0x6b, 0x77, 0x07, 0xde, 0x18,
+  0x03, 0x00, 0x00,
+};
+
+static const uint8_t asset_style_css[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x8f, 0xd1, 0x6a, 0xc3, 0x30,
+  0x0c, 0x45, 0xdf, 0xfb, 0x15, 0x82, 0x3c, 0x7b, 0xb8, 0x74, 0x8c, 0x60, 0x7f, 0x8d, 0x62, 0x2b,
+  0xa9, 0xa9, 0x23, 0x19, 0xdb, 0x1d, 0x29, 0xa3, 0xff, 0x5e, 0x7b, 0xdd, 0xd6, 0x3c, 0x4c, 0xa0,
+  0x07, 0xe9, 0x5e, 0x8e, 0xae, 0x26, 0xf1, 0x37, 0xf8, 0x82, 0x59, 0xb8, 0xaa, 0x19, 0xd7, 0x10,
+  0x6f, 0x06, 0x0a, 0x72, 0x51, 0x85, 0x72, 0x98, 0x2d, 0xac, 0x98, 0x97, 0xc0, 0x06, 0x8e, 0xb4,
+  0x5a, 0xb8, 0x1f, 0x18, 0x3f, 0x01, 0x9b, 0xdf, 0x87, 0x92, 0x22, 0x36, 0x6f, 0xe0, 0x18, 0x98,
+  0xd4, 0x14, 0xc5, 0x5d, 0x2c, 0x24, 0xf4, 0x3e, 0xf0, 0x62, 0xe0, 0x3d, 0x6d, 0x70, 0xd4, 0x69,
+  0x7b, 0x01, 0xf4, 0xf7, 0xae, 0xb7, 0xb6, 0x30, 0x49, 0xf6, 0x94, 0x1b, 0xb5, 0x8d, 0x45, 0x62,
+  0xf0, 0x30, 0x8c, 0xe3, 0x68, 0x0f, 0xf0, 0x53, 0x4f, 0x5d, 0x65, 0xf4, 0xe1, 0x5a, 0x0c, 0x9c,
+  0x3a, 0x68, 0x42, 0x77, 0x59, 0xb2, 0x5c, 0xd9, 0x1b, 0x18, 0x88, 0xc8, 0x82, 0x93, 0x28, 0x0d,
+  0x32, 0x68, 0xdd, 0x90, 0x95, 0xb6, 0xaa, 0x3c, 0x39, 0xc9, 0x58, 0x83, 0xb4, 0x83, 0x2c, 0x4c,
+  0x3d, 0xf2, 0x9b, 0x3b, 0x23, 0x33, 0xc5, 0x96, 0xfa, 0x9f, 0xb3, 0xce, 0xb9, 0x5d, 0xec, 0x7d,
+  0x64, 0x35, 0x49, 0xad, 0xb2, 0xfe, 0x2e, 0x77, 0xa0, 0xf3, 0xa9, 0xb1, 0x5e, 0x7f, 0x69, 0xf8,
+  0x78, 0x7e, 0xd5, 0x2c, 0x92, 0x6a, 0xf9, 0x13, 0x55, 0x95, 0x64, 0xba, 0xd8, 0xa5, 0x07, 0x4e,
+  0xbb, 0xbb, 0x93, 0x69, 0x01, 0x00, 0x00,
+};
+
+const WebAsset webAssets[] = {
+  { "/app.js", "application/javascript; charset=UTF-8", asset_app_js, sizeof(asset_app_js), "\"172aaf8aac225b85\"" },
+  { "/index.html", "text/html; charset=UTF-8", asset_index_html, sizeof(asset_index_html), "\"f90562ca81f4076b\"" },
+  { "/style.css", "text/css; charset=UTF-8", asset_style_css, sizeof(asset_style_css), "\"2dadfd868cc9239c\"" },
+};
+const size_t webAssetCount = 3;
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""
+Statické soubory webu (web/) → gzip pole ve flash (src/web_assets_data.cpp).
+
+Spouští ho PlatformIO před každým buildem (extra_scripts = pre:...), jde ale
+pustit i ručně: python3 tools/build_web_assets.py
+ETag je otisk zkomprimovaných dat – mění se jen se změnou obsahu. Výstup se
+přepíše jen při změně, aby zbytečně nespouštěl překlad.
+"""
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # noqa: F821 – definuje PlatformIO/SCons
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+WEB_DIR = os.path.join(ROOT, "web")
+OUT = os.path.join(ROOT, "src", "web_assets_data.cpp")
+
+TYPES = {
+    ".html": "text/html; charset=UTF-8",
+    ".js": "application/javascript; charset=UTF-8",
+    ".css": "text/css; charset=UTF-8",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "static const uint8_t %s[] = {\n%s\n};\n" % (name, "\n".join(lines))
+
+
+def build():
+    files = sorted(f for f in os.listdir(WEB_DIR) if os.path.splitext(f)[1] in TYPES)
+    out = ["// Vygenerováno tools/build_web_assets.py z web/ – neupravovat ručně",
+           '#include "web_assets.h"', ""]
+    table = []
+    raw_total = gz_total = 0
+    for f in files:
+        with open(os.path.join(WEB_DIR, f), "rb") as fh:
+            raw = fh.read()
+        gz = gzip.compress(raw, 9, mtime=0)
+        raw_total += len(raw)
+        gz_total += len(gz)
+        name = "asset_" + f.replace(".", "_").replace("-", "_")
+        etag = '\\"%s\\"' % hashlib.sha1(gz).hexdigest()[:16]
+        out.append(c_array(name, gz))
+        table.append('  { "/%s", "%s", %s, sizeof(%s), "%s" },' %
+                     (f, TYPES[os.path.splitext(f)[1]], name, name, etag))
+    out.append("const WebAsset webAssets[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("const size_t webAssetCount = %d;" % len(files))
+    text = "\n".join(out) + "\n"
+
+    old = None
+    if os.path.exists(OUT):
+        with open(OUT) as fh:
+            old = fh.read()
+    if old != text:
+        with open(OUT, "w") as fh:
+            fh.write(text)
+    print("web assets: %d souborů, %d B → %d B gzip" % (len(files), raw_total, gz_total))
+
+
+build()
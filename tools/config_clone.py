@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+Záloha a klonování konfigurace převodníků (GET/POST /config).
+
+  config_clone.py export 192.168.4.1 zaloha.bin
+  config_clone.py import zaloha.bin 192.168.4.1 [další adresy...]
+  config_clone.py check zaloha.bin
+
+Blob se před odesláním zkontroluje (hlavička, délka, CRC) – formát viz
+include/config_blob.h. Převodník po importu sám restartuje.
+"""
+import struct
+import sys
+import urllib.request
+import zlib
+
+MAGIC = b"DXCF"
+HEADER_SIZE = 16
+
+
+def check(blob):
+    if len(blob) < HEADER_SIZE or blob[:4] != MAGIC:
+        return "not a config blob"
+    version = blob[4]
+    length, crc = struct.unpack_from("<II", blob, 8)
+    if length != len(blob) - HEADER_SIZE:
+        return "bad size"
+    if zlib.crc32(blob[HEADER_SIZE:]) & 0xFFFFFFFF != crc:
+        return "CRC mismatch"
+    return "ok (version %d, %d B)" % (version, len(blob))
+
+
+def export(host, path):
+    with urllib.request.urlopen("http://%s/config" % host, timeout=5) as r:
+        blob = r.read()
+    with open(path, "wb") as f:
+        f.write(blob)
+    print("%s -> %s: %s" % (host, path, check(blob)))
+
+
+def import_(path, hosts):
+    with open(path, "rb") as f:
+        blob = f.read()
+    status = check(blob)
+    if not status.startswith("ok"):
+        print("%s: %s" % (path, status), file=sys.stderr)
+        return 1
+    failed = 0
+    for host in hosts:
+        req = urllib.request.Request("http://%s/config" % host, data=blob, method="POST",
+                                     headers={"Content-Type": "application/octet-stream"})
+        try:
+            with urllib.request.urlopen(req, timeout=5) as r:
+                print("%s: %s" % (host, r.read().decode().strip()))
+        except Exception as e:   # HTTPError nese text odmítnutí
+            body = e.read().decode().strip() if hasattr(e, "read") else str(e)
+            print("%s: %s" % (host, body), file=sys.stderr)
+            failed += 1
+    return 1 if failed else 0
+
+
+def main(argv):
+    if len(argv) == 4 and argv[1] == "export":
+        export(argv[2], argv[3])
+        return 0
+    if len(argv) >= 4 and argv[1] == "import":
+        return import_(argv[2], argv[3:])
+    if len(argv) == 3 and argv[1] == "check":
+        with open(argv[2], "rb") as f:
+            print(check(f.read()))
+        return 0
+    print(__doc__.strip(), file=sys.stderr)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
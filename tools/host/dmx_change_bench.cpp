@@ -0,0 +1,247 @@
+//
+// Benchmark skutečné cesty DMX→IR na PC: co stojí jeden přijatý rámec
+// v signálové úloze (kopie rámce, hrany 0→255 na kanálech 1..6, zveřejnění)
+// a jedna aktualizace OLED (6 úrovní, kódy, stav, UiScreen::render) –
+//   plain     bez detekce změn (rámec se jen zkopíruje a vyhodnotí)
+//   firmware  jako teď: hrany vždy, FrameStore::publish() si poznamená
+//             změnu rámce (changedSeq pro /dmx?since=)
+//   bitmap    odmítnutá varianta: bitmapa změněných kanálů před hranami,
+//             hrany jen u změněných kanálů, úrovně jen při posunu changedSeq
+// Scénáře: idle (pult posílá pořád stejný rámec), fader (kanál 3 jede
+// 0→255 za 3 s), busy (32 kanálů mimo 1..6 se mění v každém rámci),
+// edges (kanály 1..6 občas skočí na 255 a zpět).
+//
+// Kontroly (návratový kód 1 při chybě): všechny varianty pošlou stejné IR
+// kódy ve stejných rámcích a displej skončí se stejným obsahem.
+//
+// Překlad a spuštění: tools/host_bench.py dmx_change [rámců]
+//
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <chrono>
+#include <stdio.h>
+#include "frame_store.h"
+#include "ui_widgets.h"
+
+#define FRAME_US 22727    // 44 Hz, 512 kanálů
+#define VIEW_MS  100      // updateDmxToIrView()
+
+// Obrazovka DMX→IR jako v main.cpp
+struct DmxView {
+  UiScreen screen;
+  UiLabel  title{0, 0, UI_MAX_COLS};
+  UiValue  level[6] = {
+    UiValue(0,  8, "CH1:", 3), UiValue(0, 16, "CH2:", 3), UiValue(0, 24, "CH3:", 3),
+    UiValue(0, 32, "CH4:", 3), UiValue(0, 40, "CH5:", 3), UiValue(0, 48, "CH6:", 3)
+  };
+  UiLabel  code[6] = {
+    UiLabel(54,  8, 8), UiLabel(54, 16, 8), UiLabel(54, 24, 8),
+    UiLabel(54, 32, 8), UiLabel(54, 40, 8), UiLabel(54, 48, 8)
+  };
+  UiLabel  status{0, 56, UI_MAX_COLS};
+  uint32_t irSent[7] = {0};
+
+  DmxView() {
+    screen.add(&title);
+    for (int i = 0; i < 6; i++) {
+      screen.add(&level[i]);
+      screen.add(&code[i]);
+    }
+    screen.add(&status);
+    title.setText("Mode: DMX->IR");
+  }
+
+  // drawDmxToIr(): úrovně jen při levels, kódy a stav vždy
+  void update(const uint8_t *slots, uint16_t length, bool levels, uint32_t n) {
+    for (int ch = 1; ch <= 6; ch++) {
+      if (levels) level[ch - 1].setValue(ch < length ? slots[ch] : 0);
+      if (irSent[ch]) code[ch - 1].setTextf("%08X", irSent[ch]);
+      else code[ch - 1].setText("");
+    }
+    status.setTextf("%uHz j%luus E%lu", 44u, (unsigned long)(n / 44 % 7), 0ul);
+  }
+};
+
+// Edge-detekce z serviceDmxToIr(); vrací počet poslaných kódů
+struct IrEdges {
+  bool     prev[7] = {false};
+  uint32_t last[7] = {0};
+  uint32_t log[64];
+  uint32_t sent = 0;
+
+  void channel(int ch, const uint8_t *data, uint32_t n, DmxView &view) {
+    bool highNow = data[ch] == 255;
+    if (highNow && !prev[ch]) {
+      last[ch] = 0xA0000000u | ch;
+      view.irSent[ch] = last[ch];
+      if (sent < 64) log[sent] = n << 3 | ch;
+      sent++;
+    } else if (!highNow && last[ch]) {
+      last[ch] = 0;
+      view.irSent[ch] = 0;
+    }
+    prev[ch] = highNow;
+  }
+};
+
+// Bitmapa změněných kanálů po slovech (odmítnutá varianta, dříve
+// DmxChangeDetector::compare); prev = minulý rámec, vrací počet změn
+static uint16_t bitmapCompare(const uint8_t *channels, uint32_t *prev, uint32_t changed[16]) {
+  memset(changed, 0, 16 * sizeof(uint32_t));
+  uint16_t n = 0;
+  for (int i = 0; i < DMX_CHANGE_CHANNELS / 4; i++) {
+    uint32_t cur;
+    memcpy(&cur, __builtin_assume_aligned(channels + i * 4, 4), 4);
+    if (cur == prev[i]) continue;
+    uint32_t x = cur ^ prev[i];
+    prev[i] = cur;
+    for (int j = 0; j < 4; j++) {
+      if (x & (0xFFu << (j * 8))) {
+        changed[i >> 3] |= 1u << ((i & 7) * 4 + j);
+        n++;
+      }
+    }
+  }
+  return n;
+}
+
+enum Scenario { SC_IDLE, SC_FADER, SC_BUSY, SC_EDGES, SC_COUNT };
+static const char *scenarioName[SC_COUNT] = { "idle", "fader", "busy", "edges" };
+
+// Rámec n scénáře (513 slotů, slots[0] = start kód)
+static void makeFrame(Scenario sc, uint32_t n, uint8_t *slots) {
+  for (int ch = 1; ch < DMX_FRAME_SLOTS; ch++) slots[ch] = (uint8_t)(ch * 7);
+  slots[0] = 0;
+  for (int ch = 1; ch <= 6; ch++) slots[ch] = 0;
+  switch (sc) {
+    case SC_IDLE:
+      break;
+    case SC_FADER:
+      slots[3] = (uint8_t)(n % 132 * 255 / 131);   // 132 rámců = 3 s
+      break;
+    case SC_BUSY:
+      for (int k = 0; k < 32; k++) slots[100 + k * 9] = (uint8_t)(n * (k + 1));
+      break;
+    case SC_EDGES:
+      for (int ch = 1; ch <= 6; ch++) slots[ch] = (n / 22 + ch) % 6 == 0 ? 255 : 10;
+      break;
+    default:
+      break;
+  }
+}
+
+struct Result {
+  double   signalUs;
+  double   viewUs;
+  uint32_t views;
+  uint32_t irSent;
+};
+
+enum Variant { V_PLAIN, V_FIRMWARE, V_BITMAP, V_COUNT };
+static const char *variantName[V_COUNT] = { "plain", "firmware", "bitmap" };
+
+// Rámec n projde serviceDmxToIr(), každých VIEW_MS updateDmxToIrView()
+template <Variant V>
+static Result run(Scenario sc, uint32_t frames, Adafruit_GFX &gfx, IrEdges &edges) {
+  static FrameStore store;
+  static DmxFrame plain;   // bez FrameStore: jeden buffer, nic se nezveřejňuje
+  static uint8_t rx[DMX_FRAME_SLOTS];
+  static uint32_t prevWords[DMX_CHANGE_CHANNELS / 4];
+  uint32_t changed[16];
+  uint32_t bitmapChangedSeq = 0;
+  store.resetChanges();
+  memset(prevWords, 0, sizeof(prevWords));
+  DmxView view;
+  gfx.clear();
+  view.screen.invalidateAll();
+  view.screen.render(gfx);
+  uint32_t viewChangedSeq = UINT32_MAX;
+  uint32_t lastView = 0;
+  Result r = {};
+
+  for (uint32_t n = 0; n < frames; n++) {
+    makeFrame(sc, n, rx);
+    auto t0 = std::chrono::steady_clock::now();
+    if (V == V_PLAIN) {
+      memcpy(plain.slots, rx, DMX_FRAME_SLOTS);              // dmx_read()
+      for (int ch = 1; ch <= 6; ch++) edges.channel(ch, plain.slots, n, view);
+    } else if (V == V_FIRMWARE) {
+      DmxFrame &frame = store.writeBuffer();
+      memcpy(frame.slots, rx, DMX_FRAME_SLOTS);
+      for (int ch = 1; ch <= 6; ch++) edges.channel(ch, frame.slots, n, view);
+      store.publish(DMX_FRAME_SLOTS, n);
+    } else {
+      DmxFrame &frame = store.writeBuffer();
+      memcpy(frame.slots, rx, DMX_FRAME_SLOTS);
+      // první rámec celý jako změněný
+      if (bitmapCompare(frame.slots + 1, prevWords, changed) || n == 0) bitmapChangedSeq = n + 1;
+      if (n == 0) memset(changed, 0xFF, sizeof(changed));
+      for (int ch = 1; ch <= 6; ch++) {
+        if (!(changed[(ch - 1) >> 5] & (1u << ((ch - 1) & 31)))) continue;
+        edges.channel(ch, frame.slots, n, view);
+      }
+      store.publish(DMX_FRAME_SLOTS, n);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    r.signalUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+
+    uint32_t nowMs = (uint64_t)n * FRAME_US / 1000;
+    if (n && nowMs - lastView < VIEW_MS) continue;
+    lastView = nowMs;
+    auto t2 = std::chrono::steady_clock::now();
+    if (V == V_PLAIN) {
+      view.update(plain.slots, DMX_FRAME_SLOTS, true, n);
+    } else {
+      const DmxFrame &frame = store.acquire();
+      bool levels = true;
+      if (V == V_BITMAP) {
+        levels = bitmapChangedSeq != viewChangedSeq;
+        viewChangedSeq = bitmapChangedSeq;
+      }
+      view.update(frame.slots, frame.length, levels, n);
+    }
+    view.screen.render(gfx);
+    auto t3 = std::chrono::steady_clock::now();
+    r.viewUs += std::chrono::duration<double, std::micro>(t3 - t2).count();
+    r.views++;
+  }
+  r.irSent = edges.sent;
+  return r;
+}
+
+int main(int argc, char **argv) {
+  uint32_t frames = argc > 1 ? strtoul(argv[1], NULL, 10) : 44 * 600;   // 10 min
+  bool ok = true;
+
+  printf("%-6s %-9s %12s %12s %14s\n", "", "", "signal/frame", "oled/update", "total/s @44Hz");
+  for (int s = 0; s < SC_COUNT; s++) {
+    Scenario sc = (Scenario)s;
+    Adafruit_GFX gfx[V_COUNT] = { Adafruit_GFX(128, 64), Adafruit_GFX(128, 64), Adafruit_GFX(128, 64) };
+    IrEdges edges[V_COUNT];
+    Result r[V_COUNT];
+    r[V_PLAIN] = run<V_PLAIN>(sc, frames, gfx[V_PLAIN], edges[V_PLAIN]);
+    r[V_FIRMWARE] = run<V_FIRMWARE>(sc, frames, gfx[V_FIRMWARE], edges[V_FIRMWARE]);
+    r[V_BITMAP] = run<V_BITMAP>(sc, frames, gfx[V_BITMAP], edges[V_BITMAP]);
+
+    for (int v = 0; v < V_COUNT; v++) {
+      double perSec = r[v].signalUs / frames * 44 + r[v].viewUs / r[v].views * (1000 / VIEW_MS);
+      printf("%-6s %-9s %9.3f us %9.3f us %11.2f us\n", scenarioName[s], variantName[v],
+             r[v].signalUs / frames, r[v].viewUs / r[v].views, perSec);
+      if (v == V_PLAIN) continue;
+      uint32_t logged = edges[V_PLAIN].sent < 64 ? edges[V_PLAIN].sent : 64;
+      if (edges[v].sent != edges[V_PLAIN].sent ||
+          memcmp(edges[v].log, edges[V_PLAIN].log, sizeof(uint32_t) * logged) != 0) {
+        printf("FAIL %s/%s: IR sent %u vs %u\n", scenarioName[s], variantName[v],
+               edges[v].sent, edges[V_PLAIN].sent);
+        ok = false;
+      }
+      if (memcmp(gfx[v].buffer, gfx[V_PLAIN].buffer, sizeof(gfx[v].buffer)) != 0) {
+        printf("FAIL %s/%s: display differs\n", scenarioName[s], variantName[v]);
+        ok = false;
+      }
+    }
+  }
+
+  printf("%s\n", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
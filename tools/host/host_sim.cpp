@@ -0,0 +1,28 @@
+//
+// Společné pro host benchmarky: čas PC a log rovnou na stderr
+//
+#include <Arduino.h>
+#include <chrono>
+#include <stdarg.h>
+#include "log.h"
+
+static const auto hostStart = std::chrono::steady_clock::now();
+
+uint32_t micros() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - hostStart).count();
+}
+
+uint32_t millis() {
+  return micros() / 1000;
+}
+
+volatile uint8_t logRuntimeLevel = LOG_LEVEL_WARN;
+
+void logWrite(uint8_t, const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+}
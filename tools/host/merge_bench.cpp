@@ -0,0 +1,89 @@
+//
+// Slučování DMX zdrojů (dmx_merge.h) na PC: fuzz kontrola a benchmark.
+//
+// Fuzz: náhodné konfigurace (priority, pokrytí celými rámci i po kanálech,
+// LTP kanály, uvolnění zdrojů) a po každé změně se porovná merge() po slovech
+// s referenčním mergeScalar() po bajtech. Pak dmxMergeBench() – stejný
+// benchmark jako /merge?bench=1 na desce, jen s časem PC.
+//
+// Překlad a spuštění: tools/host_bench.py merge [konfigurací] [iterací]
+//
+#include <Arduino.h>
+#include <stdio.h>
+#include "dmx_merge.h"
+
+static uint32_t rng = 1;
+static uint32_t nextRand() {
+  rng = rng * 1664525u + 1013904223u;
+  return rng >> 8;
+}
+
+// false = první neshoda (vypíše se)
+static bool fuzzConfig(uint32_t cfg) {
+  static DmxMerger m;
+  m = DmxMerger();
+  static uint8_t levels[MERGE_CHANNELS], outW[MERGE_CHANNELS], outS[MERGE_CHANNELS];
+
+  for (int s = 0; s < MERGE_SOURCES; s++) {
+    // málo různých priorit, ať se často potkají stejné (HTP/LTP)
+    m.setPriority((MergeSource)s, (uint8_t)(nextRand() % 4 * 50));
+  }
+  int ltpMode = nextRand() % 3;
+  for (uint16_t ch = 0; ch < MERGE_CHANNELS; ch++) {
+    if (ltpMode == 1 ? nextRand() % 4 == 0 : ltpMode == 2) m.setLtp(ch, true);
+  }
+
+  for (int step = 0; step < 24; step++) {
+    MergeSource src = (MergeSource)(nextRand() % MERGE_SOURCES);
+    switch (nextRand() % 4) {
+      case 0:
+      case 1: {
+        uint16_t count = nextRand() % (MERGE_CHANNELS + 1);
+        for (uint16_t ch = 0; ch < count; ch++) levels[ch] = (uint8_t)nextRand();
+        m.setLevels(src, levels, count);
+        break;
+      }
+      case 2:
+        for (int k = nextRand() % 16; k >= 0; k--) {
+          m.setChannel(src, nextRand() % MERGE_CHANNELS, (uint8_t)nextRand());
+        }
+        break;
+      default:
+        m.release(src);
+        break;
+    }
+    memset(outW, 0xA5, sizeof(outW));
+    memset(outS, 0x5A, sizeof(outS));
+    uint16_t nW = m.merge(outW);
+    uint16_t nS = m.mergeScalar(outS);
+    // zapisuje se jen do vrácené délky
+    if (nW != nS || memcmp(outW, outS, nW) != 0) {
+      int ch = 0;
+      while (ch < nW && outW[ch] == outS[ch]) ch++;
+      printf("FAIL config %u step %d: count %u/%u, first difference ch %d (word %u, byte %u)\n",
+             cfg, step, nW, nS, ch + 1, ch < MERGE_CHANNELS ? outW[ch] : 0, ch < MERGE_CHANNELS ? outS[ch] : 0);
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  uint32_t configs = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+  uint32_t iterations = argc > 2 ? strtoul(argv[2], NULL, 10) : 20000;
+
+  uint32_t failed = 0;
+  for (uint32_t c = 0; c < configs; c++) {
+    if (!fuzzConfig(c)) failed++;
+  }
+  printf("fuzz %u configs x 24 updates: %u mismatches\n", configs, failed);
+
+  DmxMergeBench b = dmxMergeBench(iterations, micros);
+  printf("bench %u frames (512 ch x 4 sources): byte %.2f us, word %.2f us per frame%s\n",
+         b.iterations, (float)b.scalarUs / b.iterations, (float)b.wordUs / b.iterations,
+         b.match ? "" : " - RESULTS DIFFER");
+
+  bool ok = !failed && b.match;
+  printf("%s\n", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
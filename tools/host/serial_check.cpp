@@ -0,0 +1,180 @@
+//
+// Kontrola binárního protokolu na UART0 (serial_proto.h) proti referenčnímu
+// klientovi tools/serial_ctl.py – každá strana dekóduje rámce té druhé:
+//
+//   - firmware → Python: serialFrameEncode() zakóduje payloady plné nul,
+//     bloky kolem hranice COBS (254 B), payload 2048 B a snímek SerialMetrics,
+//     mezi rámci řádek logu; serial_ctl.py crosscheck je dekóduje, ověří CRC
+//     a vypíše délku, CRC payloadu a pole metrik
+//   - Python → firmware: rámce z encode() v serial_ctl.py s textem logu mezi
+//     nimi a jedním poškozeným rámcem projdou SerialFrameDecoder po bajtech;
+//     projdou všechny kromě poškozeného, ten se počítá jako chyba CRC
+//
+// Potřebuje python3 v PATH. Překlad a spuštění: tools/host_bench.py serial
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "serial_proto.h"
+#include "crc32.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { printf("FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); failures++; } \
+  } while (0)
+
+struct FrameInfo {
+  unsigned type, seq, length;
+  uint32_t crc;   // CRC-32 payloadu
+};
+
+// Kořen repozitáře z cesty k tomuto souboru (host_bench.py překládá s plnou cestou)
+static std::string repoRoot() {
+  std::string path = __FILE__;
+  size_t cut = path.rfind("/tools/host/");
+  return cut == std::string::npos ? std::string(".") : path.substr(0, cut);
+}
+
+static std::vector<uint8_t> fwStream;
+static std::vector<FrameInfo> fwFrames;
+
+static void fwFrame(uint8_t type, uint8_t seq, const uint8_t *payload, uint16_t len) {
+  static uint8_t out[SERIAL_PROTO_ENCODED_MAX];
+  size_t n = serialFrameEncode(type, seq, payload, len, out, sizeof(out));
+  CHECK(n > 0, "serialFrameEncode(len %u) failed", len);
+  fwStream.insert(fwStream.end(), out, out + n);
+  fwFrames.push_back({ type, seq, len, crc32Update(0, payload, len) });
+}
+
+static void fwLog(const char *line) {
+  fwStream.insert(fwStream.end(), line, line + strlen(line));
+}
+
+int main() {
+  std::string root = repoRoot();
+  std::string fwPath = root + "/.pio/build/host/serial_fw.bin";
+  std::string pyPath = root + "/.pio/build/host/serial_py.bin";
+
+  // firmware → Python
+  static uint8_t payload[SERIAL_PROTO_MAX_PAYLOAD + 1];
+  memset(payload, 0, sizeof(payload));
+  fwFrame(SP_PING | SP_REPLY, 1, payload, 0);
+  fwFrame(SP_GET_FRAME | SP_REPLY, 2, payload, 513);          // samé nuly
+  fwLog("   1.250 I [dmx] signal present\n");
+  for (int k = 0; k < 600; k++) payload[k] = k % 3 ? 0 : (uint8_t)(k + 1);
+  fwFrame(SP_GET_SCENES | SP_REPLY, 3, payload, 600);
+  for (int k = 0; k < 600; k++) payload[k] = (uint8_t)(k % 255 + 1);   // bez nul
+  for (uint16_t len : { 253, 254, 255, 508, 509 }) fwFrame(SP_GET_IR | SP_REPLY, (uint8_t)len, payload, len);
+  for (int k = 0; k < SERIAL_PROTO_MAX_PAYLOAD; k++) payload[k] = (k * 37 >> 3) % 5 ? (uint8_t)(k * 13) : 0;
+  fwFrame(SP_GET_CONFIG | SP_REPLY, 0, payload, SERIAL_PROTO_MAX_PAYLOAD);
+  fwLog("   2.000 W [web] client gone\n");
+
+  SerialMetrics m;
+  memset(&m, 0, sizeof(m));
+  m.uptimeMs = 123456789; m.mode = 4; m.signalPresent = 1;
+  m.framesPerSec = 44; m.errorsPerSec = 2; m.lastSlots = 513;
+  m.framesTotal = 4000000001u; m.framesPublished = 39000; m.framesUnchanged = 12;
+  m.uartErrors = 7; m.signalLosses = 3; m.intervalMaxUs = 23001; m.jitterUs = 180;
+  m.mergeLastUs = 35; m.mergeMaxUs = 410; m.mergeChannels = 512; m.curveLastUs = 9;
+  m.irDecoded = 65536; m.irRepeats = 255; m.logDropped = 1; m.freeHeap = 0x01020304;
+  const unsigned long expected[] = {
+    m.uptimeMs, m.mode, m.signalPresent, m.framesPerSec, m.errorsPerSec, m.lastSlots,
+    m.framesTotal, m.framesPublished, m.framesUnchanged, m.uartErrors, m.signalLosses,
+    m.intervalMaxUs, m.jitterUs, m.mergeLastUs, m.mergeMaxUs, m.mergeChannels,
+    m.curveLastUs, m.irDecoded, m.irRepeats, m.logDropped, m.freeHeap
+  };
+  uint8_t metrics[SERIAL_METRICS_SIZE];
+  CHECK(serialMetricsEncode(m, metrics) == SERIAL_METRICS_SIZE, "metrics size");
+  fwFrame(SP_METRICS, 7, metrics, SERIAL_METRICS_SIZE);
+
+  uint8_t big[SERIAL_PROTO_ENCODED_MAX];
+  CHECK(serialFrameEncode(SP_PING, 0, payload, SERIAL_PROTO_MAX_PAYLOAD + 1, big, sizeof(big)) == 0,
+        "payload over SERIAL_PROTO_MAX_PAYLOAD encoded");
+
+  FILE *f = fopen(fwPath.c_str(), "wb");
+  if (!f || fwrite(fwStream.data(), 1, fwStream.size(), f) != fwStream.size()) {
+    printf("FAIL cannot write %s\n", fwPath.c_str());
+    return 1;
+  }
+  fclose(f);
+
+  std::string cmd = "python3 '" + root + "/tools/serial_ctl.py' crosscheck '" + fwPath + "' '" + pyPath + "'";
+  FILE *py = popen(cmd.c_str(), "r");
+  if (!py) {
+    printf("FAIL cannot run %s\n", cmd.c_str());
+    return 1;
+  }
+  std::vector<FrameInfo> pyDecoded, pySent;
+  int textChunks = -1;
+  bool metricsSeen = false;
+  char line[1024];
+  while (fgets(line, sizeof(line), py)) {
+    FrameInfo fi;
+    if (sscanf(line, "frame %u %u %u %x", &fi.type, &fi.seq, &fi.length, &fi.crc) == 4) {
+      pyDecoded.push_back(fi);
+    } else if (sscanf(line, "sent %u %u %u %x", &fi.type, &fi.seq, &fi.length, &fi.crc) == 4) {
+      pySent.push_back(fi);
+    } else if (strncmp(line, "metrics ", 8) == 0) {
+      metricsSeen = true;
+      char *p = line + 8;
+      for (size_t k = 0; k < sizeof(expected) / sizeof(expected[0]); k++) {
+        unsigned long v = strtoul(p, &p, 10);
+        CHECK(v == expected[k], "metrics field %u: python %lu, expected %lu", (unsigned)k, v, expected[k]);
+      }
+    } else if (sscanf(line, "text %d", &textChunks) != 1) {
+      CHECK(false, "serial_ctl.py: %s", line);
+    }
+  }
+  int status = pclose(py);
+  CHECK(status == 0, "serial_ctl.py crosscheck exited with %d", status);
+
+  CHECK(pyDecoded.size() == fwFrames.size(), "python decoded %u frames, sent %u",
+        (unsigned)pyDecoded.size(), (unsigned)fwFrames.size());
+  for (size_t i = 0; i < pyDecoded.size() && i < fwFrames.size(); i++) {
+    const FrameInfo &a = pyDecoded[i], &b = fwFrames[i];
+    CHECK(a.type == b.type && a.seq == b.seq && a.length == b.length && a.crc == b.crc,
+          "frame %u: python %02X/%u/%u/%08X, firmware %02X/%u/%u/%08X", (unsigned)i,
+          a.type, a.seq, a.length, a.crc, b.type, b.seq, b.length, b.crc);
+  }
+  CHECK(metricsSeen, "python did not decode the metrics frame");
+  CHECK(textChunks == 2, "python saw %d log chunks, expected 2", textChunks);
+
+  // Python → firmware
+  f = fopen(pyPath.c_str(), "rb");
+  if (!f) {
+    printf("FAIL cannot read %s\n", pyPath.c_str());
+    return 1;
+  }
+  SerialFrameDecoder dec;
+  std::vector<FrameInfo> fwDecoded;
+  int c;
+  while ((c = fgetc(f)) != EOF) {
+    if (dec.push((uint8_t)c)) {
+      fwDecoded.push_back({ dec.type(), dec.seq(), dec.length(), crc32Update(0, dec.payload(), dec.length()) });
+    }
+  }
+  fclose(f);
+
+  CHECK(!pySent.empty(), "python sent no frames");
+  CHECK(fwDecoded.size() == pySent.size(), "decoder accepted %u frames, python sent %u",
+        (unsigned)fwDecoded.size(), (unsigned)pySent.size());
+  for (size_t i = 0; i < fwDecoded.size() && i < pySent.size(); i++) {
+    const FrameInfo &a = fwDecoded[i], &b = pySent[i];
+    CHECK(a.type == b.type && a.seq == b.seq && a.length == b.length && a.crc == b.crc,
+          "frame %u: decoder %02X/%u/%u/%08X, python %02X/%u/%u/%08X", (unsigned)i,
+          a.type, a.seq, a.length, a.crc, b.type, b.seq, b.length, b.crc);
+  }
+  const SerialProtoStats &st = dec.stats();
+  CHECK(st.crcErrors == 1, "crc errors %u, expected 1 (corrupted frame)", st.crcErrors);
+  CHECK(st.overflows == 0, "overflows %u", st.overflows);
+  // text logu neprojde COBS/délkou a počítá se jako malformed, rámce ne
+  CHECK(st.frames == pySent.size(), "stats.frames %u", st.frames);
+  printf("firmware -> python %u frames, python -> firmware %u frames (%u text, %u crc errors)\n",
+         (unsigned)pyDecoded.size(), (unsigned)fwDecoded.size(), st.malformed, st.crcErrors);
+
+  printf("%s\n", failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+//
+// Adafruit_GFX pro host benchmarky: 1bitový framebuffer 128×64 jako SH1106
+// a font 6×8 kreslený po pixelech jako výchozí font GFX. Počítá zapsané
+// pixely – to je práce, kterou render() na desce opravdu dělá.
+//
+#include <stdint.h>
+#include <string.h>
+
+class Adafruit_GFX {
+ public:
+  Adafruit_GFX(int16_t w, int16_t h) : width_(w), height_(h) { clear(); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    pixels++;
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
+    uint8_t &b = buffer[(y / 8) * 128 + x];
+    if (color) b |= 1 << (y & 7);
+    else b &= ~(1 << (y & 7));
+  }
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++)
+      for (int16_t i = x; i < x + w; i++) drawPixel(i, j, color);
+  }
+  void setTextSize(uint8_t s) { size_ = s ? s : 1; }
+  void setTextColor(uint16_t c) { color_ = c; }
+  void setCursor(int16_t x, int16_t y) { cx_ = x; cy_ = y; }
+  void print(const char *s) {
+    for (; *s; s++) drawChar(*s);
+  }
+  void clear() {
+    memset(buffer, 0, sizeof(buffer));
+  }
+
+  uint8_t  buffer[128 * 64 / 8];
+  uint32_t pixels = 0;
+
+ private:
+  void drawChar(char c) {
+    // tvar znaku nehraje roli, jen počet zápisů: 5×7 bodů + mezera, jako glcdfont
+    for (int8_t i = 0; i < 6; i++) {
+      uint8_t col = i < 5 ? (uint8_t)(c * (i + 3)) & 0x7F : 0;
+      for (int8_t j = 0; j < 8; j++) {
+        if (size_ == 1) drawPixel(cx_ + i, cy_ + j, (col >> j) & 1 ? color_ : 0);
+        else fillRect(cx_ + i * size_, cy_ + j * size_, size_, size_, (col >> j) & 1 ? color_ : 0);
+      }
+    }
+    cx_ += 6 * size_;
+  }
+
+  int16_t  width_, height_;
+  int16_t  cx_ = 0, cy_ = 0;
+  uint8_t  size_ = 1;
+  uint16_t color_ = 1;
+};
@@ -0,0 +1,12 @@
+#pragma once
+//
+// Arduino API pro host benchmarky (tools/host): skutečný čas PC, výpisy na stdout.
+//
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+uint32_t millis();
+uint32_t micros();
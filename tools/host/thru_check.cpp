@@ -0,0 +1,110 @@
+//
+// Kontrola průchozího režimu (dmx_thru.h) na PC bez druhého DMX portu:
+// rámce jdou přímo do DmxThru::input/output/idle a výstup se porovnává
+// s očekávaným slučováním podle priorit (dmx_merge.h).
+//
+//   - vstup bez dalších zdrojů projde beze změny
+//   - scéna nad vstupem kanály přepíše, na stejné prioritě HTP
+//   - vadný start kód se nepropustí, výstup drží poslední platný vstup
+//   - bez vstupu se dál vysílá (framesHeld) až do DMX_THRU_HOLD_MS,
+//     pak se vstup uvolní a zůstane jen scéna
+//   - latence vstup → výstup a překročení intervalu rámců
+//
+// Překlad a spuštění: tools/host_bench.py thru
+//
+#include <Arduino.h>
+#include <stdio.h>
+#include "dmx_thru.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { printf("FAIL line %d: ", __LINE__); printf(__VA_ARGS__); printf("\n"); failures++; } \
+  } while (0)
+
+static uint8_t in[1 + MERGE_CHANNELS], out[1 + MERGE_CHANNELS];
+
+static void makeInput(uint16_t channels, uint8_t base) {
+  in[0] = 0x00;
+  for (uint16_t ch = 1; ch <= channels; ch++) in[ch] = (uint8_t)(base + ch * 3);
+}
+
+int main() {
+  DmxMerger merger;
+  DmxThru thru(merger);
+  uint32_t now = 1000000;
+
+  // čistý průchod
+  makeInput(24, 10);
+  CHECK(thru.input(in, 25, now), "valid frame rejected");
+  uint16_t len = thru.output(out, now + 150);
+  CHECK(len == 25, "output length %u, expected 25", len);
+  CHECK(memcmp(in, out, 25) == 0, "pass-through changed the universe");
+  CHECK(thru.stats().lastLatencyUs == 150, "latency %u us, expected 150", thru.stats().lastLatencyUs);
+
+  // scéna (priorita 100) nad vstupem (50) přepíše kanály 1..8, i nižší hodnotou
+  uint8_t scene[8];
+  memset(scene, 5, sizeof(scene));
+  merger.setLevels(MERGE_SRC_SCENE, scene, sizeof(scene));
+  now += 22700;
+  makeInput(24, 20);
+  thru.input(in, 25, now);
+  len = thru.output(out, now + 100);
+  CHECK(len == 25, "output length %u with scene", len);
+  for (int ch = 1; ch <= 8; ch++) CHECK(out[ch] == 5, "ch %d = %u, scene should override", ch, out[ch]);
+  for (int ch = 9; ch <= 24; ch++) CHECK(out[ch] == in[ch], "ch %d = %u, input %u should pass", ch, out[ch], in[ch]);
+  CHECK(thru.stats().frameUs == 22700, "frame interval %u us", thru.stats().frameUs);
+
+  // stejná priorita = HTP vkládání
+  merger.setPriority(MERGE_SRC_SCENE, merger.priority(MERGE_SRC_INPUT));
+  scene[0] = 255;
+  merger.setLevels(MERGE_SRC_SCENE, scene, sizeof(scene));
+  len = thru.output(out, now + 200);
+  CHECK(out[1] == 255, "HTP ch 1 = %u, expected 255", out[1]);
+  for (int ch = 2; ch <= 8; ch++) {
+    uint8_t exp = in[ch] > 5 ? in[ch] : 5;
+    CHECK(out[ch] == exp, "HTP ch %d = %u, expected %u", ch, out[ch], exp);
+  }
+
+  // vadný start kód: nepropustí se, výstup drží poslední platný vstup
+  uint8_t keep = out[12];
+  uint8_t bad[25];
+  memset(bad, 0x77, sizeof(bad));
+  bad[0] = 0xCC;
+  CHECK(!thru.input(bad, sizeof(bad), now + 1000), "bad start code accepted");
+  CHECK(thru.stats().badStartCodes == 1, "bad start codes %u", thru.stats().badStartCodes);
+  thru.output(out, now + 1100);
+  CHECK(out[12] == keep, "ch 12 = %u after bad frame, expected held %u", out[12], keep);
+
+  // bez vstupu se dál vysílá (znovu poslední stav) až do DMX_THRU_HOLD_MS
+  uint32_t held = thru.stats().framesHeld;
+  uint32_t last = now;
+  for (int i = 1; i * 22700 < DMX_THRU_HOLD_MS * 1000; i++) {
+    thru.idle(last + i * 22700);
+    len = thru.output(out, last + i * 22700);
+    CHECK(len == 25 && out[12] == keep, "re-send %d: len %u ch 12 = %u", i, len, out[12]);
+  }
+  CHECK(thru.inputPresent(), "input dropped before hold time");
+  CHECK(thru.stats().framesHeld > held + 100, "held frames %u", thru.stats().framesHeld - held);
+
+  // po DMX_THRU_HOLD_MS se vstup uvolní, zůstane jen scéna
+  thru.idle(last + DMX_THRU_HOLD_MS * 1000);
+  CHECK(!thru.inputPresent(), "input still present after hold time");
+  CHECK(thru.stats().inputLosses == 1, "input losses %u", thru.stats().inputLosses);
+  len = thru.output(out, last + DMX_THRU_HOLD_MS * 1000 + 100);
+  CHECK(len == 9, "output length %u after input loss, expected scene only (9)", len);
+  merger.release(MERGE_SRC_SCENE);
+  CHECK(thru.output(out, last + DMX_THRU_HOLD_MS * 1000 + 200) == 0, "output without any source");
+
+  // výstup pozdější než interval rámců se počítá
+  now = last + 10000000;
+  makeInput(24, 30);
+  thru.input(in, 25, now);
+  thru.input(in, 25, now + 22700);
+  thru.output(out, now + 22700 + 30000);
+  CHECK(thru.stats().overTarget == 1, "over target %u, expected 1", thru.stats().overTarget);
+  CHECK(thru.stats().maxLatencyUs == 30000, "max latency %u", thru.stats().maxLatencyUs);
+
+  printf("%s\n", failures ? "FAILED" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+//
+// Benchmark vykreslování OLED widgetů (ui_widgets.h) na PC proti stub GFX.
+//
+// Obrazovky jsou sestavené stejně jako v main.cpp (DMX→IR: titulek, 6 × úroveň
+// a kód, stav; menu se 7 položkami). Stejný sled změn se vykreslí:
+//   full      jako před widgety: smazat displej, nakreslit vše, poslat framebuffer
+//   retained  UiScreen::render() – jen změněné widgety, framebuffer jen při změně
+// Měří se čas a počet zapsaných pixelů na aktualizaci a podíl aktualizací,
+// po kterých je potřeba poslat framebuffer (na desce ~25 ms po I2C).
+//
+// Kontroly (návratový kód 1 při chybě): po každé aktualizaci se framebuffer
+// retained shoduje s full; po přepnutí obrazovky (smazání + invalidateAll)
+// se nezměněný seznam nakreslí celý; plná obrazovka add() odmítne.
+//
+// Překlad a spuštění: tools/host_bench.py ui_render [aktualizací]
+//
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <chrono>
+#include <stdio.h>
+#include "ui_widgets.h"
+
+static uint32_t rng = 1;
+static uint32_t nextRand() {
+  rng = rng * 1664525u + 1013904223u;
+  return rng >> 8;
+}
+
+struct DmxView {
+  UiScreen screen;
+  UiLabel  title{0, 0, UI_MAX_COLS};
+  UiValue  level[6] = {
+    UiValue(0,  8, "CH1:", 3), UiValue(0, 16, "CH2:", 3), UiValue(0, 24, "CH3:", 3),
+    UiValue(0, 32, "CH4:", 3), UiValue(0, 40, "CH5:", 3), UiValue(0, 48, "CH6:", 3)
+  };
+  UiLabel  code[6] = {
+    UiLabel(54,  8, 8), UiLabel(54, 16, 8), UiLabel(54, 24, 8),
+    UiLabel(54, 32, 8), UiLabel(54, 40, 8), UiLabel(54, 48, 8)
+  };
+  UiLabel  status{0, 56, UI_MAX_COLS};
+  int      added = 0;
+
+  DmxView() {
+    added += screen.add(&title);
+    for (int i = 0; i < 6; i++) {
+      added += screen.add(&level[i]);
+      added += screen.add(&code[i]);
+    }
+    added += screen.add(&status);
+    title.setText("Mode: DMX->IR");
+  }
+};
+
+struct MenuView {
+  UiScreen screen;
+  UiLabel  title{0, 0, UI_MAX_COLS};
+  UiList   list{0, 8, 7};
+
+  MenuView() {
+    screen.add(&title);
+    screen.add(&list);
+    title.setText("IR Learn");
+    list.setCount(7);
+    char buf[16];
+    for (int i = 0; i < 6; i++) {
+      snprintf(buf, sizeof(buf), "Learn CH%d", i + 1);
+      list.setItem(i, buf);
+    }
+    list.setItem(6, "Exit");
+    list.setSelected(0);
+  }
+};
+
+// Jedna aktualizace DMX→IR: jako updateDmxToIrView() při pomalém faderu –
+// většinou se změní jeden kanál, občas kód a stav (Hz/chyby jednou za s)
+static void stepDmx(DmxView &v, uint32_t n) {
+  uint32_t r = nextRand();
+  if (r % 100 < 40) {
+    int ch = r / 100 % 6;
+    int32_t val = v.level[ch].getValue() + (int32_t)(r / 600 % 7) - 3;
+    v.level[ch].setValue(val < 0 ? 0 : (val > 255 ? 255 : val));
+  }
+  if (r % 500 == 7) v.code[r / 500 % 6].setTextf("%08X", (unsigned)nextRand());
+  if (n % 50 == 0) v.status.setTextf("%uHz E%u SC00:%u", 44 - (r & 1), (unsigned)(n / 5000), (unsigned)n);
+}
+
+static void stepMenu(MenuView &v, uint32_t n) {
+  uint32_t r = nextRand();
+  if (r % 100 < 30) v.list.setSelected((v.list.getSelected() + (r & 256 ? 1 : 6)) % 7);
+}
+
+struct Result {
+  double   us;
+  uint64_t pixels;
+  uint32_t flushes;
+};
+
+static void report(const char *name, uint32_t updates, const Result &full, const Result &ret) {
+  printf("%-8s full     %7.3f us  %6.0f px  flush 100.0 %%\n", name,
+         full.us / updates, (double)full.pixels / updates);
+  printf("%-8s retained %7.3f us  %6.0f px  flush %5.1f %%\n", name,
+         ret.us / updates, (double)ret.pixels / updates, 100.0 * ret.flushes / updates);
+}
+
+// Projde stejný sled změn oběma způsoby; false = framebuffery se rozešly
+template <typename View, typename Step>
+static bool run(const char *name, uint32_t updates, Step step) {
+  Adafruit_GFX gfxFull(128, 64), gfxRet(128, 64);
+  View full, ret;
+  Result rf = {}, rr = {};
+  bool ok = true;
+
+  gfxRet.clear();
+  ret.screen.invalidateAll();
+  ret.screen.render(gfxRet);
+  gfxRet.pixels = 0;
+
+  uint32_t seed = 12345;
+  for (uint32_t n = 0; n < updates; n++) {
+    rng = seed;
+    step(full, n);
+    auto t0 = std::chrono::steady_clock::now();
+    gfxFull.clear();
+    full.screen.invalidateAll();
+    full.screen.render(gfxFull);
+    auto t1 = std::chrono::steady_clock::now();
+    rf.flushes++;
+
+    rng = seed;
+    step(ret, n);
+    seed = rng;
+    auto t2 = std::chrono::steady_clock::now();
+    if (ret.screen.render(gfxRet)) rr.flushes++;
+    auto t3 = std::chrono::steady_clock::now();
+
+    rf.us += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    rr.us += std::chrono::duration<double, std::micro>(t3 - t2).count();
+    if (ok && memcmp(gfxFull.buffer, gfxRet.buffer, sizeof(gfxRet.buffer)) != 0) {
+      printf("FAIL %s: framebuffer differs after update %u\n", name, n);
+      ok = false;
+    }
+  }
+  rf.pixels = gfxFull.pixels;
+  rr.pixels = gfxRet.pixels;
+  report(name, updates, rf, rr);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  uint32_t updates = argc > 1 ? strtoul(argv[1], NULL, 10) : 20000;
+  bool ok = true;
+
+  ok &= run<DmxView>("dmx", updates, stepDmx);
+  ok &= run<MenuView>("menu", updates, stepMenu);
+
+  // přepnutí obrazovky (showScreen): smazat displej a překreslit vše,
+  // i nezměněné řádky seznamu
+  {
+    Adafruit_GFX gfx(128, 64);
+    MenuView v;
+    v.screen.render(gfx);
+    uint8_t before[sizeof(gfx.buffer)];
+    memcpy(before, gfx.buffer, sizeof(before));
+    gfx.clear();
+    v.screen.invalidateAll();
+    v.screen.render(gfx);
+    if (memcmp(before, gfx.buffer, sizeof(before)) != 0) {
+      printf("FAIL switch: menu list not redrawn after invalidateAll\n");
+      ok = false;
+    }
+  }
+
+  // kapacita: celá DMX→IR obrazovka se vejde, přes UI_MAX_WIDGETS add() odmítne
+  {
+    DmxView v;
+    if (v.added != 14) {
+      printf("FAIL capacity: DMX->IR screen holds %d of 14 widgets\n", v.added);
+      ok = false;
+    }
+    UiLabel extra(0, 0, 1);
+    int more = 0;
+    while (v.screen.add(&extra) && more < 64) more++;
+    if (14 + more != UI_MAX_WIDGETS) {
+      printf("FAIL capacity: add() accepted %d widgets, limit %d\n", 14 + more, UI_MAX_WIDGETS);
+      ok = false;
+    }
+  }
+
+  printf("%s\n", ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
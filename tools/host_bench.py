@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Host benchmarky a kontroly jednotlivých modulů firmwaru – přeloží program
+z tools/host/ spolu s moduly (g++, -O2) a spustí ho; parametry jdou dál.
+Na rozdíl od soak.py (celá signálová cesta na simulovaném čase) měří
+skutečný čas PC, takže čísla jsou jen poměrová (změna vs. původní postup).
+
+  host_bench.py ui_render      OLED widgety: překreslení změn vs. celý displej
+  host_bench.py merge          slučování DMX: fuzz merge() proti mergeScalar(), benchmark
+  host_bench.py thru           průchozí režim: priority, držení a ztráta vstupu
+  host_bench.py dmx_change     DMX→IR za rámec a za překreslení: s detekcí změn vs. bez ní
+  host_bench.py serial         protokol na UART0: firmware ↔ tools/serial_ctl.py oběma směry
+
+Návratový kód 1 = kontrola selhala (výsledek se liší od referenčního postupu).
+"""
+import os
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BENCHES = {
+    "ui_render": ["src/ui_widgets.cpp", "tools/host/ui_render_bench.cpp"],
+    "merge": ["src/dmx_merge.cpp", "tools/host/merge_bench.cpp"],
+    "thru": ["src/dmx_merge.cpp", "src/dmx_thru.cpp", "tools/host/thru_check.cpp"],
+    "dmx_change": ["src/dmx_change.cpp", "src/ui_widgets.cpp", "tools/host/dmx_change_bench.cpp"],
+    "serial": ["src/serial_proto.cpp", "tools/host/serial_check.cpp"],
+}
+COMMON = ["tools/host/host_sim.cpp"]
+HEADER_DIRS = ["include", "tools/host", "tools/host/sim"]
+
+
+def newest_input(sources):
+    paths = [os.path.join(ROOT, s) for s in sources]
+    for d in HEADER_DIRS:
+        for base, _, files in os.walk(os.path.join(ROOT, d)):
+            paths += [os.path.join(base, f) for f in files if f.endswith(".h")]
+    return max(os.path.getmtime(p) for p in paths)
+
+
+def build(name):
+    sources = BENCHES[name] + COMMON
+    binary = os.path.join(ROOT, ".pio", "build", "host", name)
+    if os.path.exists(binary) and os.path.getmtime(binary) >= newest_input(sources):
+        return binary
+    os.makedirs(os.path.dirname(binary), exist_ok=True)
+    cmd = [os.environ.get("CXX", "g++"), "-std=gnu++17", "-O2", "-Wall", "-o", binary]
+    cmd += ["-I" + os.path.join(ROOT, d) for d in HEADER_DIRS]
+    cmd += [os.path.join(ROOT, s) for s in sources]
+    print("building %s" % os.path.relpath(binary, ROOT), file=sys.stderr)
+    return binary if subprocess.call(cmd) == 0 else None
+
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] not in BENCHES:
+        print("usage: host_bench.py {%s} [args]" % ",".join(sorted(BENCHES)), file=sys.stderr)
+        sys.exit(2)
+    binary = build(sys.argv[1])
+    if not binary:
+        sys.exit(2)
+    sys.exit(subprocess.call([binary] + sys.argv[2:]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,395 @@
+#!/usr/bin/env python3
+"""
+Referenční klient binárního protokolu na UART0 (include/serial_proto.h).
+
+  serial_ctl.py PORT ping
+  serial_ctl.py PORT config-get zaloha.bin      stejný blob jako GET /config
+  serial_ctl.py PORT config-set zaloha.bin      převodník po importu restartuje
+  serial_ctl.py PORT scenes-get scenes.json
+  serial_ctl.py PORT scenes-set scenes.json
+  serial_ctl.py PORT ir-get ir.json
+  serial_ctl.py PORT ir-set ir.json
+  serial_ctl.py PORT inject 1-8=255 12=40       kanály 1..n jako zdroj "web"; --release uvolní
+  serial_ctl.py PORT frame                      poslední rámec (jako /dmx)
+  serial_ctl.py PORT stream [--period 200]      metriky, dokud se nepřeruší (Ctrl+C)
+  serial_ctl.py selftest                        kodér/dekodér bez zařízení
+  serial_ctl.py crosscheck FW.bin PY.bin        proti serial_proto.cpp (host_bench.py serial)
+
+Řádky logu, které přijdou mezi rámci, se vypisují na stderr.
+Potřebuje pyserial (pip install pyserial).
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+import zlib
+
+BAUD = 921600
+MAX_PAYLOAD = 2048
+
+PING, GET_CONFIG, SET_CONFIG, GET_SCENES, SET_SCENES = 0x01, 0x02, 0x03, 0x04, 0x05
+GET_IR, SET_IR, INJECT, GET_FRAME, STREAM = 0x06, 0x07, 0x08, 0x09, 0x0A
+REPLY, METRICS, NAK = 0x80, 0xC0, 0xFF
+
+NAK_NAMES = {1: "unknown type", 2: "bad length", 3: "busy", 4: "failed"}
+MODE_NAMES = ["menu", "dmx-to-ir", "ir-to-dmx", "ir-learn", "dmx-thru"]
+IR_NAME = 24
+
+# SerialMetrics v pořadí polí (serialMetricsEncode)
+METRICS_FORMAT = "<IBBHHHIIIIIIIIIHIIIII"
+METRICS_FIELDS = ("uptime_ms mode signal_present frames_per_sec errors_per_sec slots_last "
+                  "frames_total frames_published frames_unchanged uart_errors signal_losses "
+                  "interval_max_us jitter_us merge_last_us merge_max_us merge_channels "
+                  "curve_last_us ir_decoded ir_repeats log_dropped free_heap").split()
+
+
+class ProtoError(Exception):
+    pass
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out.append(len(block) + 1)
+            out += block
+            block = bytearray()
+            continue
+        block.append(b)
+        if len(block) == 254:
+            out.append(255)
+            out += block
+            block = bytearray()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ProtoError("bad COBS")
+        out += data[i + 1:i + code]
+        i += code
+        if code != 255 and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode(msg_type, seq, payload=b""):
+    if len(payload) > MAX_PAYLOAD:
+        raise ProtoError("payload too long")
+    raw = struct.pack("<BBH", msg_type, seq, len(payload)) + payload
+    raw += struct.pack("<I", zlib.crc32(raw) & 0xFFFFFFFF)
+    return b"\0" + cobs_encode(raw) + b"\0"
+
+
+def decode(chunk):
+    """Úsek mezi nulami -> (typ, seq, payload), nebo None (text logu, poškozený rámec)."""
+    try:
+        raw = cobs_decode(chunk)
+    except ProtoError:
+        return None
+    if len(raw) < 8:
+        return None
+    msg_type, seq, length = struct.unpack_from("<BBH", raw)
+    if length != len(raw) - 8:
+        return None
+    if zlib.crc32(raw[:-4]) & 0xFFFFFFFF != struct.unpack_from("<I", raw, len(raw) - 4)[0]:
+        return None
+    return msg_type, seq, raw[4:-4]
+
+
+class Splitter:
+    """Rozdělí proud z UARTu na rámce a text logu."""
+
+    def __init__(self, on_text):
+        self.buf = bytearray()
+        self.on_text = on_text
+
+    def feed(self, data):
+        frames = []
+        for b in data:
+            if b != 0:
+                self.buf.append(b)
+                continue
+            if self.buf:
+                frame = decode(bytes(self.buf))
+                if frame:
+                    frames.append(frame)
+                else:
+                    self.on_text(bytes(self.buf))
+            self.buf = bytearray()
+        return frames
+
+
+def print_log(text):
+    sys.stderr.write(text.decode("utf-8", "replace"))
+    sys.stderr.flush()
+
+
+class Link:
+    def __init__(self, port, baud=BAUD):
+        import serial   # pyserial; selftest ho nepotřebuje
+        self.ser = serial.Serial()
+        self.ser.port = port
+        self.ser.baudrate = baud
+        self.ser.timeout = 0.05
+        # DTR/RTS na USB převodníku jinak ESP32 resetují
+        self.ser.dtr = False
+        self.ser.rts = False
+        self.ser.open()
+        self.split = Splitter(print_log)
+        self.seq = 0
+
+    def frames(self, timeout):
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            data = self.ser.read(4096)
+            for frame in self.split.feed(data):
+                yield frame
+
+    def request(self, msg_type, payload=b"", timeout=2.0):
+        self.seq = (self.seq + 1) & 0xFF
+        self.ser.write(encode(msg_type, self.seq, payload))
+        for rtype, rseq, rpayload in self.frames(timeout):
+            if rseq != self.seq or rtype == METRICS:
+                continue
+            if rtype == NAK:
+                reason = NAK_NAMES.get(rpayload[0], "error %d" % rpayload[0]) if rpayload else "?"
+                raise ProtoError("request 0x%02X rejected: %s" % (msg_type, reason))
+            if rtype == msg_type | REPLY:
+                return rpayload
+        raise ProtoError("request 0x%02X: no reply" % msg_type)
+
+
+def parse_levels(specs):
+    levels = {}
+    for spec in specs:
+        rng, _, value = spec.partition("=")
+        first, _, last = rng.partition("-")
+        for ch in range(int(first), int(last or first) + 1):
+            if not 1 <= ch <= 512:
+                raise ProtoError("channel %d out of range" % ch)
+            levels[ch] = max(0, min(255, int(value)))
+    frame = bytearray(max(levels) if levels else 0)
+    for ch, v in levels.items():
+        frame[ch - 1] = v
+    return bytes(frame)
+
+
+def format_metrics(payload):
+    m = dict(zip(METRICS_FIELDS, struct.unpack(METRICS_FORMAT, payload)))
+    if m["mode"] < len(MODE_NAMES):
+        m["mode"] = MODE_NAMES[m["mode"]]
+    return " ".join("%s=%s" % kv for kv in m.items())
+
+
+def cmd_ping(link, args):
+    t = time.monotonic()
+    p = link.request(PING)
+    version, max_payload, uptime = struct.unpack("<BHI", p)
+    print("protocol %d, max payload %d B, uptime %.1f s, round trip %.1f ms"
+          % (version, max_payload, uptime / 1000, (time.monotonic() - t) * 1000))
+
+
+def cmd_config_get(link, args):
+    blob = link.request(GET_CONFIG)
+    with open(args.file, "wb") as f:
+        f.write(blob)
+    print("config %d B -> %s" % (len(blob), args.file))
+
+
+def cmd_config_set(link, args):
+    with open(args.file, "rb") as f:
+        blob = f.read()
+    link.request(SET_CONFIG, blob, timeout=5.0)
+    print("config imported, device restarting")
+
+
+def cmd_scenes_get(link, args):
+    p = link.request(GET_SCENES)
+    count, channels = p[0], p[1]
+    scenes = [list(p[2 + i * channels:2 + (i + 1) * channels]) for i in range(count)]
+    with open(args.file, "w") as f:
+        json.dump({"scenes": scenes}, f)
+    print("%d scenes x %d channels -> %s" % (count, channels, args.file))
+
+
+def cmd_scenes_set(link, args):
+    with open(args.file) as f:
+        scenes = json.load(f)["scenes"]
+    if len(scenes) != 6 or any(len(s) != 64 for s in scenes):
+        raise ProtoError("expected 6 scenes x 64 channels")
+    payload = bytes([6, 64]) + b"".join(bytes(max(0, min(255, v)) for v in s) for s in scenes)
+    link.request(SET_SCENES, payload, timeout=5.0)
+    print("scenes uploaded")
+
+
+def cmd_ir_get(link, args):
+    p = link.request(GET_IR)
+    codes = ["%08X" % c for c in struct.unpack_from("<6I", p)]
+    library = []
+    for i in range(p[24]):
+        off = 25 + i * (IR_NAME + 4)
+        name = p[off:off + IR_NAME].split(b"\0")[0].decode("utf-8", "replace")
+        library.append({"name": name, "code": "%08X" % struct.unpack_from("<I", p, off + IR_NAME)[0]})
+    with open(args.file, "w") as f:
+        json.dump({"channels": codes, "library": library}, f, indent=1)
+    print("6 channel codes, %d library entries -> %s" % (len(library), args.file))
+
+
+def cmd_ir_set(link, args):
+    with open(args.file) as f:
+        ir = json.load(f)
+    codes = [int(str(c), 16) for c in ir["channels"]]
+    library = ir.get("library", [])
+    if len(codes) != 6 or len(library) > 64:
+        raise ProtoError("expected 6 channel codes and at most 64 library entries")
+    payload = struct.pack("<6IB", *codes, len(library))
+    for e in library:
+        payload += e["name"].encode()[:IR_NAME - 1].ljust(IR_NAME, b"\0")
+        payload += struct.pack("<I", int(str(e["code"]), 16))
+    link.request(SET_IR, payload, timeout=5.0)
+    print("IR table uploaded")
+
+
+def cmd_inject(link, args):
+    frame = b"" if args.release else parse_levels(args.levels)
+    link.request(INJECT, frame)
+    print("released" if not frame else "injected channels 1-%d" % len(frame))
+
+
+def cmd_frame(link, args):
+    p = link.request(GET_FRAME)
+    seq = struct.unpack_from("<I", p)[0]
+    slots = p[4:]
+    print("seq %d, start code %s, %d channels" % (seq, slots[0] if slots else "-", max(0, len(slots) - 1)))
+    for base in range(1, len(slots), 16):
+        print("%3d: %s" % (base, " ".join("%3d" % v for v in slots[base:base + 16])))
+
+
+def cmd_stream(link, args):
+    link.request(STREAM, struct.pack("<H", args.period))
+    try:
+        while True:
+            for rtype, _, payload in link.frames(1.0):
+                if rtype == METRICS:
+                    print(format_metrics(payload), flush=True)
+    except KeyboardInterrupt:
+        link.request(STREAM, struct.pack("<H", 0))
+
+
+def selftest():
+    import random
+    rnd = random.Random(1)
+    text = []
+    split = Splitter(text.append)
+    sent, got = [], []
+    for i in range(500):
+        n = rnd.choice([0, 1, 253, 254, 255, 508, 509, rnd.randrange(MAX_PAYLOAD + 1)])
+        payload = bytes(rnd.choice([0, rnd.randrange(256)]) for _ in range(n))
+        sent.append((i % 256, i & 0xFF, payload))
+        stream = encode(i % 256, i & 0xFF, payload)
+        if i % 7 == 0:
+            stream = b"  12.345 I log line %d\n" % i + stream
+        # dávky libovolné délky jako z UARTu
+        while stream:
+            k = rnd.randrange(1, 64)
+            got += split.feed(stream[:k])
+            stream = stream[k:]
+    corrupt = bytearray(encode(PING, 1, b"abc"))
+    corrupt[3] ^= 0x40
+    got += split.feed(bytes(corrupt))
+    ok = got == sent and len(text) == (500 + 6) // 7 + 1
+    print("selftest: %d frames, %d text chunks: %s" % (len(got), len(text), "ok" if ok else "FAILED"))
+    return 0 if ok else 1
+
+
+def crosscheck(fw_path, py_path):
+    """Protějšek tools/host/serial_check.cpp: rámce z firmwaru dekóduje a vypíše,
+    vlastní rámce (s textem logu a jedním poškozeným) zapíše pro SerialFrameDecoder."""
+    text = []
+    split = Splitter(text.append)
+    with open(fw_path, "rb") as f:
+        frames = split.feed(f.read())
+    for msg_type, seq, payload in frames:
+        print("frame %d %d %d %08X" % (msg_type, seq, len(payload), zlib.crc32(payload) & 0xFFFFFFFF))
+        if msg_type == METRICS:
+            if len(payload) != struct.calcsize(METRICS_FORMAT):
+                print("metrics-length %d" % len(payload))
+                continue
+            print("metrics " + " ".join(str(v) for v in struct.unpack(METRICS_FORMAT, payload)))
+    print("text %d" % len(text))
+
+    import random
+    rnd = random.Random(2)
+    stream = bytearray()
+    for i, n in enumerate([0, 1, 253, 254, 255, 508, 509, 1000, MAX_PAYLOAD]):
+        # liché bez nul (celé bloky COBS po 254 B), sudé převážně nuly
+        if i % 2:
+            payload = bytes(rnd.randrange(1, 256) for _ in range(n))
+        else:
+            payload = bytes(rnd.choice([0, 0, rnd.randrange(256)]) for _ in range(n))
+        msg_type = [PING, SET_CONFIG, SET_SCENES, SET_IR, INJECT][i % 5]
+        stream += b"  %d.%03d I log line %d\n" % (i, i * 7, i) + encode(msg_type, i + 1, payload)
+        print("sent %d %d %d %08X" % (msg_type, i + 1, n, zlib.crc32(payload) & 0xFFFFFFFF))
+    # bajt payloadu (ne kód COBS) – rámec projde COBS, ale ne CRC
+    corrupt = bytearray(encode(SET_SCENES, 99, b"\x55" * 40))
+    corrupt[12] ^= 0x20
+    stream += corrupt + encode(PING, 100)
+    print("sent %d %d 0 %08X" % (PING, 100, 0))
+    with open(py_path, "wb") as f:
+        f.write(stream)
+    return 0
+
+
+COMMANDS = {
+    "ping": (cmd_ping, []),
+    "config-get": (cmd_config_get, ["file"]),
+    "config-set": (cmd_config_set, ["file"]),
+    "scenes-get": (cmd_scenes_get, ["file"]),
+    "scenes-set": (cmd_scenes_set, ["file"]),
+    "ir-get": (cmd_ir_get, ["file"]),
+    "ir-set": (cmd_ir_set, ["file"]),
+    "inject": (cmd_inject, []),
+    "frame": (cmd_frame, []),
+    "stream": (cmd_stream, []),
+}
+
+
+def main(argv):
+    if len(argv) == 2 and argv[1] == "selftest":
+        return selftest()
+    if len(argv) == 4 and argv[1] == "crosscheck":
+        return crosscheck(argv[2], argv[3])
+    ap = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=BAUD)
+    sub = ap.add_subparsers(dest="command", required=True)
+    for name, (_, params) in COMMANDS.items():
+        p = sub.add_parser(name)
+        for param in params:
+            p.add_argument(param)
+        if name == "inject":
+            p.add_argument("levels", nargs="*", help="CH=V or FIRST-LAST=V")
+            p.add_argument("--release", action="store_true")
+        if name == "stream":
+            p.add_argument("--period", type=int, default=200, help="ms")
+    args = ap.parse_args(argv[1:])
+    try:
+        link = Link(args.port, args.baud)
+        COMMANDS[args.command][0](link, args)
+    except ProtoError as e:
+        print(e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Čtečka záznamu DMX show (*.dmxs) pro analýzu na PC.
+
+Formát je popsaný v include/show_format.h. Záznam se stáhne z
+http://<zařízení>/show.dmxs.
+
+  show_dump.py show.dmxs                 souhrn (počet rámců, délka, typy záznamů)
+  show_dump.py show.dmxs --csv 1-16      čas_ms;ch1;...;ch16 pro každý rámec
+"""
+import argparse
+import sys
+
+MAGIC = b"DMXS"
+VERSION = 1
+HEADER_SIZE = 16
+MAX_SLOTS = 513
+
+
+class ShowError(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def byte(self):
+        if self.pos >= len(self.data):
+            raise EOFError
+        b = self.data[self.pos]
+        self.pos += 1
+        return b
+
+    def varint(self):
+        v = 0
+        for shift in range(0, 35, 7):
+            c = self.byte()
+            v |= (c & 0x7F) << shift
+            if not c & 0x80:
+                return v
+        raise ShowError("varint too long at offset %d" % self.pos)
+
+    def bytes(self, n):
+        if self.pos + n > len(self.data):
+            raise EOFError
+        b = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return b
+
+
+def frames(data, stats=None):
+    """Generátor (čas_ms, sloty) – sloty[0] je start kód."""
+    if data[:4] != MAGIC:
+        raise ShowError("not a .dmxs file")
+    if data[4] != VERSION:
+        raise ShowError("unsupported version %d" % data[4])
+    rd = Reader(data)
+    rd.pos = HEADER_SIZE
+    slots = bytearray(MAX_SLOTS)
+    length = 0
+    t = 0
+    if stats is None:
+        stats = {}
+    stats.update(key=0, delta=0, runs=0, end=False, truncated=False)
+    while True:
+        try:
+            typ = rd.byte()
+            if typ == ord("E"):
+                stats["end"] = True
+                return
+            t += rd.varint()
+            if typ == ord("K"):
+                n = rd.varint()
+                if n > MAX_SLOTS:
+                    raise ShowError("key frame too long at offset %d" % rd.pos)
+                slots[:n] = rd.bytes(n)
+                length = n
+                stats["key"] += 1
+            elif typ == ord("D"):
+                pos = 0
+                for _ in range(rd.varint()):
+                    pos += rd.varint()
+                    n = rd.varint()
+                    if pos + n > MAX_SLOTS:
+                        raise ShowError("delta run out of range at offset %d" % rd.pos)
+                    slots[pos:pos + n] = rd.bytes(n)
+                    pos += n
+                    length = max(length, pos)
+                    stats["runs"] += 1
+                stats["delta"] += 1
+            else:
+                raise ShowError("unknown record 0x%02x at offset %d" % (typ, rd.pos - 1))
+        except EOFError:
+            # záznam přerušený výpadkem napájení nebo plnou flash – vrátí se, co je celé
+            stats["truncated"] = True
+            return
+        yield t, bytes(slots[:length])
+
+
+def parse_range(text):
+    a, _, b = text.partition("-")
+    lo = int(a)
+    hi = int(b) if b else lo
+    if not 1 <= lo <= hi <= MAX_SLOTS - 1:
+        raise argparse.ArgumentTypeError("channels must be within 1-512")
+    return lo, hi
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("file")
+    ap.add_argument("--csv", type=parse_range, metavar="A-B", help="print channels A..B per frame")
+    args = ap.parse_args()
+
+    with open(args.file, "rb") as f:
+        data = f.read()
+
+    stats = {}
+    try:
+        if args.csv:
+            lo, hi = args.csv
+            print("time_ms;" + ";".join("ch%d" % c for c in range(lo, hi + 1)))
+            for t, slots in frames(data, stats):
+                vals = [str(slots[c]) if c < len(slots) else "" for c in range(lo, hi + 1)]
+                print("%d;%s" % (t, ";".join(vals)))
+            return 0
+
+        count = 0
+        last_t = 0
+        max_len = 0
+        for t, slots in frames(data, stats):
+            count += 1
+            last_t = t
+            max_len = max(max_len, len(slots))
+    except ShowError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    print("file:        %s (%d B)" % (args.file, len(data)))
+    print("frames:      %d (key %d, delta %d, runs %d)" % (count, stats["key"], stats["delta"], stats["runs"]))
+    print("duration:    %.3f s" % (last_t / 1000.0))
+    print("slots:       %d" % max_len)
+    if count:
+        print("bytes/frame: %.1f" % ((len(data) - HEADER_SIZE) / count))
+    print("complete:    %s" % ("yes" if stats["end"] else "no (truncated)"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Soak harness signálové cesty na PC – přeloží tools/soak/ spolu s moduly
+firmwaru (g++) a spustí ho; parametry jdou beze změny dál.
+
+  soak.py                                 1 h DMX→IR + 1 h IR→DMX, seed 1
+  soak.py --hours 8 --seed 7              delší náhodný provoz
+  soak.py --bad-permille 5                5 ‰ vadných DMX rámců na vstupu
+  soak.py --script tools/soak/short_pulses.txt
+
+Vypíše rozložení latencí DMX→IR, IR→DMX a web→DMX a zmeškané hrany/stisky
+s časem. Návratový kód 1 = něco se zmeškalo (viz tools/soak/soak.cpp).
+"""
+import os
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCES = [
+    "src/signal_task.cpp",
+    "src/ir_receiver.cpp",
+    "src/dmx_stats.cpp",
+    "src/dmx_merge.cpp",
+    "src/dmx_thru.cpp",
+    "src/cue_engine.cpp",
+    "src/output_curves.cpp",
+    "src/dmx_change.cpp",
+    "src/ir_nudge.cpp",
+    "tools/soak/sim_world.cpp",
+    "tools/soak/soak.cpp",
+]
+HEADER_DIRS = ["include", "tools/soak", "tools/soak/sim"]
+BINARY = os.path.join(ROOT, ".pio", "build", "soak", "soak")
+
+
+def newest_input():
+    paths = [os.path.join(ROOT, s) for s in SOURCES]
+    for d in HEADER_DIRS:
+        for base, _, files in os.walk(os.path.join(ROOT, d)):
+            paths += [os.path.join(base, f) for f in files if f.endswith(".h")]
+    return max(os.path.getmtime(p) for p in paths)
+
+
+def build():
+    if os.path.exists(BINARY) and os.path.getmtime(BINARY) >= newest_input():
+        return True
+    os.makedirs(os.path.dirname(BINARY), exist_ok=True)
+    cmd = [os.environ.get("CXX", "g++"), "-std=gnu++17", "-O2", "-Wall", "-o", BINARY]
+    cmd += ["-I" + os.path.join(ROOT, d) for d in HEADER_DIRS]
+    cmd += [os.path.join(ROOT, s) for s in SOURCES]
+    print("building %s" % os.path.relpath(BINARY, ROOT), file=sys.stderr)
+    return subprocess.call(cmd) == 0
+
+
+def main():
+    if not build():
+        sys.exit(2)
+    sys.exit(subprocess.call([BINARY] + sys.argv[1:]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,38 @@
+#pragma once
+//
+// Arduino/ESP32 API pro soak harness (tools/soak). Čas běží jen tehdy, když
+// firmware čeká (delay, vTaskDelay, DMX/IR driver) – viz sim_world.h.
+//
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define LOW    0
+#define HIGH   1
+#define INPUT  0
+#define OUTPUT 1
+
+class String;
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+// Výpisy firmwaru harness zahazuje – výsledek je souhrn na konci běhu
+struct SimSerial {
+  template <typename T> void print(const T &) {}
+  template <typename T> void print(const T &, int) {}
+  template <typename T> void println(const T &) {}
+  template <typename T> void println(const T &, int) {}
+  void println() {}
+  void printf(const char *, ...) {}
+};
+extern SimSerial Serial;
@@ -0,0 +1,25 @@
+#pragma once
+//
+// IRrecv pro soak harness: decode() vydá zprávu naplánovanou přes
+// simIrCapture(), jakmile od jejího konce uplyne timeout přijímače.
+//
+#include <IRremoteESP8266.h>
+
+struct decode_results {
+  decode_type_t decode_type;
+  uint64_t value;
+  uint16_t bits;
+  bool     repeat;
+  bool     overflow;
+};
+
+class IRrecv {
+ public:
+  IRrecv(uint16_t, uint16_t = 1024, uint8_t timeoutMs = 15, bool = false) : timeoutMs_(timeoutMs) {}
+  void enableIRIn() {}
+  void setUnknownThreshold(uint16_t) {}
+  bool decode(decode_results *results);
+
+ private:
+  uint8_t timeoutMs_;
+};
@@ -0,0 +1,4 @@
+#pragma once
+#include <stdint.h>
+
+enum decode_type_t { UNKNOWN = -1, UNUSED = 0, RC5, RC6, NEC, SONY, PANASONIC, SAMSUNG, LG };
@@ -0,0 +1,13 @@
+#pragma once
+//
+// IRsend pro soak harness: sendNEC() blokuje po celou délku NEC zprávy
+// (včetně mezery do 108 ms jako v IRremoteESP8266) a ohlásí odeslání harnessu.
+//
+#include <IRremoteESP8266.h>
+
+class IRsend {
+ public:
+  explicit IRsend(uint16_t) {}
+  void begin() {}
+  void sendNEC(uint64_t data, uint16_t nbits = 32, uint16_t repeat = 0);
+};
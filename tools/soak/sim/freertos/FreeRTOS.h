@@ -0,0 +1,12 @@
+#pragma once
+// FreeRTOS pro soak harness: 1 tick = 1 ms simulovaného času
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef void    *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdPASS 1
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
@@ -0,0 +1,217 @@
+#include <Arduino.h>
+#include <esp_dmx.h>
+#include <IRrecv.h>
+#include <IRsend.h>
+#include <deque>
+#include <queue>
+#include <vector>
+#include "sim_world.h"
+
+SimSerial Serial;
+
+namespace sim {
+
+std::function<void(uint32_t, uint64_t, uint64_t)> onIrSend;
+std::function<void(const uint8_t *, uint16_t, uint64_t, uint64_t)> onDmxSent;
+
+struct Event {
+  uint64_t t;
+  uint64_t order;
+  std::function<void()> fn;
+};
+
+struct Later {
+  bool operator()(const Event &a, const Event &b) const {
+    return a.t != b.t ? a.t > b.t : a.order > b.order;
+  }
+};
+
+static std::priority_queue<Event, std::vector<Event>, Later> calendar;
+static uint64_t clockUs = 0;
+static uint64_t nextOrder = 0;
+
+struct RxPort {
+  uint8_t  slots[DMX_PACKET_SIZE];
+  uint16_t len;
+  uint32_t seq;
+  int      err;
+  bool     fresh;        // doběhl rámec, který firmware ještě nevyzvedl
+  uint32_t readSeq;
+  uint32_t overwritten;
+};
+static RxPort rx = {};
+
+struct TxPort {
+  uint8_t  slots[DMX_PACKET_SIZE];
+  uint64_t busyUntil;
+};
+static TxPort tx[3] = {};
+
+struct Capture {
+  uint64_t endUs;
+  decode_results results;
+};
+static std::deque<Capture> captures;
+
+uint64_t now() {
+  return clockUs;
+}
+
+void at(uint64_t t, std::function<void()> fn) {
+  calendar.push(Event{ t, nextOrder++, std::move(fn) });
+}
+
+bool advanceUntil(uint64_t t, const std::function<bool()> &done) {
+  if (done && done()) return true;
+  while (!calendar.empty() && calendar.top().t <= t) {
+    Event ev = calendar.top();
+    calendar.pop();
+    if (ev.t > clockUs) clockUs = ev.t;
+    ev.fn();
+    if (done && done()) return true;
+  }
+  if (t > clockUs) clockUs = t;
+  return false;
+}
+
+void advanceTo(uint64_t t) {
+  advanceUntil(t, nullptr);
+}
+
+void dmxInput(const uint8_t *slots, uint16_t len, uint32_t seq, int err) {
+  if (rx.fresh) rx.overwritten++;
+  if (len > DMX_PACKET_SIZE) len = DMX_PACKET_SIZE;
+  memcpy(rx.slots, slots, len);
+  rx.len = len;
+  rx.seq = seq;
+  rx.err = err;
+  rx.fresh = true;
+}
+
+uint32_t dmxReadSeq() {
+  return rx.readSeq;
+}
+
+uint32_t dmxOverwritten() {
+  return rx.overwritten;
+}
+
+void irCapture(decode_type_t protocol, uint64_t value, uint16_t bits, bool repeat) {
+  Capture c;
+  c.endUs = clockUs;
+  c.results.decode_type = protocol;
+  c.results.value = value;
+  c.results.bits = bits;
+  c.results.repeat = repeat;
+  c.results.overflow = false;
+  captures.push_back(c);
+}
+
+size_t irPending() {
+  return captures.size();
+}
+
+}  // namespace sim
+
+using sim::clockUs;
+
+// ========================
+// Arduino / FreeRTOS
+
+uint32_t millis() {
+  return (uint32_t)(clockUs / 1000);
+}
+
+uint32_t micros() {
+  return (uint32_t)clockUs;   // přetéká po 71 minutách jako na ESP32
+}
+
+void delay(uint32_t ms) {
+  sim::advanceTo(clockUs + (uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+  sim::advanceTo(clockUs + us);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  sim::advanceTo(clockUs + (uint64_t)ticks * 1000);
+}
+
+void vTaskDelayUntil(TickType_t *previousWake, TickType_t increment) {
+  *previousWake += increment;
+  uint64_t wakeUs = (uint64_t)*previousWake * 1000;
+  if (wakeUs > clockUs) sim::advanceTo(wakeUs);   // zpožděné probuzení se nečeká
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(clockUs / 1000);
+}
+
+// ========================
+// esp_dmx
+
+size_t dmx_receive(dmx_port_t port, dmx_packet_t *packet, TickType_t wait) {
+  uint64_t deadline = clockUs + (uint64_t)wait * 1000;
+  bool got = port == DMX_NUM_1 && sim::advanceUntil(deadline, [] { return sim::rx.fresh; });
+  packet->sc = 0;
+  packet->size = 0;
+  packet->is_rdm = false;
+  if (!got) {
+    if (port != DMX_NUM_1) sim::advanceTo(deadline);
+    packet->err = DMX_ERR_TIMEOUT;
+    return 0;
+  }
+  sim::rx.fresh = false;
+  packet->err = sim::rx.err;
+  if (sim::rx.err != DMX_OK) return 0;
+  packet->sc = sim::rx.slots[0];
+  packet->size = sim::rx.len;
+  return sim::rx.len;
+}
+
+size_t dmx_read(dmx_port_t port, void *dest, size_t size) {
+  if (port != DMX_NUM_1) return 0;
+  if (size > sim::rx.len) size = sim::rx.len;
+  memcpy(dest, sim::rx.slots, size);
+  sim::rx.readSeq = sim::rx.seq;
+  return size;
+}
+
+size_t dmx_write(dmx_port_t port, const void *src, size_t size) {
+  if (size > DMX_PACKET_SIZE) size = DMX_PACKET_SIZE;
+  memcpy(sim::tx[port].slots, src, size);
+  return size;
+}
+
+size_t dmx_send(dmx_port_t port, size_t size) {
+  sim::TxPort &p = sim::tx[port];
+  uint64_t start = p.busyUntil > clockUs ? p.busyUntil : clockUs;
+  p.busyUntil = start + SIM_DMX_BREAK_US + (uint64_t)size * SIM_DMX_SLOT_US;
+  if (sim::onDmxSent) sim::onDmxSent(p.slots, (uint16_t)size, start, p.busyUntil);
+  return size;
+}
+
+bool dmx_wait_sent(dmx_port_t port, TickType_t) {
+  if (sim::tx[port].busyUntil > clockUs) sim::advanceTo(sim::tx[port].busyUntil);
+  return true;
+}
+
+// ========================
+// IRremoteESP8266
+
+bool IRrecv::decode(decode_results *results) {
+  if (sim::captures.empty()) return false;
+  const sim::Capture &c = sim::captures.front();
+  if (clockUs < c.endUs + (uint64_t)timeoutMs_ * 1000) return false;
+  *results = c.results;
+  sim::captures.pop_front();
+  return true;
+}
+
+void IRsend::sendNEC(uint64_t data, uint16_t, uint16_t repeat) {
+  uint64_t start = clockUs;
+  uint64_t end = start + (uint64_t)(1 + repeat) * SIM_NEC_MESSAGE_US;
+  if (sim::onIrSend) sim::onIrSend((uint32_t)data, start, end);
+  sim::advanceTo(end);
+}
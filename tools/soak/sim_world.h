@@ -0,0 +1,51 @@
+#pragma once
+//
+// Simulovaný svět soak harnessu: hodiny v µs, kalendář událostí a "hardware"
+// kolem signálové úlohy (DMX vstup na portu 1, vysílání DMX, IR přijímač a LED).
+//
+// Firmware běží v jednom vlákně. Čas se posouvá jen v jeho blokujících voláních
+// (vTaskDelay/Until, dmx_receive, dmx_wait_sent, sendNEC) a cestou se v pořadí
+// spouští naplánované události – příchod DMX rámců, dokončené IR zprávy, tick
+// IR úlohy, příkazy z webu. Hodina provozu tak trvá zlomek sekundy.
+//
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <IRremoteESP8266.h>
+
+// NEC zpráva i s mezerou za ní (kNecMinCommandLength v IRremoteESP8266)
+#define SIM_NEC_MESSAGE_US 108000
+// Vysílání DMX rámce: break + MAB + 11 bitů na slot při 250 kbit/s
+#define SIM_DMX_BREAK_US   188
+#define SIM_DMX_SLOT_US    44
+
+namespace sim {
+
+uint64_t now();
+
+// Událost v čase t (µs); události se stejným časem běží v pořadí naplánování
+void at(uint64_t t, std::function<void()> fn);
+
+// Posune čas na t a cestou spustí všechny události
+void advanceTo(uint64_t t);
+// Totéž, ale skončí hned po události, po které done() vrátí true (true = splněno)
+bool advanceUntil(uint64_t t, const std::function<bool()> &done);
+
+// DMX vstup (port 1): rámec právě doběhl po lince. Nepřečtený předchozí
+// rámec se přepíše – esp_dmx drží jen poslední.
+void dmxInput(const uint8_t *slots, uint16_t len, uint32_t seq, int err);
+// Pořadové číslo rámce, který firmware naposledy přečetl (dmx_read)
+uint32_t dmxReadSeq();
+// Rámce přepsané dřív, než si je firmware vyzvedl
+uint32_t dmxOverwritten();
+
+// IR zpráva právě doběhla; IRrecv::decode() ji vydá po timeoutu přijímače
+void irCapture(decode_type_t protocol, uint64_t value, uint16_t bits, bool repeat);
+// Zachycené zprávy, které ještě neprošly decode()
+size_t irPending();
+
+// Pozorovatelé výstupů firmwaru
+extern std::function<void(uint32_t code, uint64_t startUs, uint64_t endUs)> onIrSend;
+extern std::function<void(const uint8_t *slots, uint16_t len, uint64_t startUs, uint64_t endUs)> onDmxSent;
+
+}  // namespace sim
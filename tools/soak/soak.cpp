@@ -0,0 +1,676 @@
+//
+// Soak harness: signálová cesta firmwaru (signal_task.cpp, ir_receiver.cpp,
+// slučování, cue engine) přeložená pro PC a puštěná na simulovaném čase
+// (sim_world.h). Do DMX vstupu jde skriptovaný nebo náhodně generovaný
+// provoz, do IR přijímače zprávy z ovladače, do fronty příkazů požadavky
+// z webu. Měří se:
+//
+//   DMX→IR   rámec s hranou na 255 na lince → začátek odeslání IR kódu
+//   IR→DMX   konec IR zprávy → konec rámce, ve kterém je vybraná scéna
+//   web→DMX  požadavek z webu (CMD_SET_WEB_LEVEL) → rámec s novou hodnotou
+//
+// Hrana, pro kterou se IR nikdy neodeslal, a stisk / požadavek, který se ve
+// výstupu neobjevil dřív, než ho přebil další, se vypíšou s časem. Hodiny
+// provozu se projdou za pár sekund.
+//
+// Překlad a spuštění: tools/soak.py [parametry] (parametry viz usage()).
+//
+#include <Arduino.h>
+#include <IRremoteESP8266.h>
+#include <esp_dmx.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <stdio.h>
+#include <vector>
+#include "signal_task.h"
+#include "ir_receiver.h"
+#include "show_recorder.h"
+#include "scene_bank.h"
+#include "boot_timing.h"
+#include "trace.h"
+#include "log.h"
+#include "sim_world.h"
+
+#define SOAK_FRAME_US      22700     // plné univerzum (513 slotů) na lince, ~44 Hz
+#define SOAK_SIG_CH        63        // kanál 64 nese číslo scény (podpis)
+#define SOAK_WEB_CHANNELS  8         // web mění kanály 1..8 – liché hodnoty, scény mají sudé
+#define SOAK_SETTLE_US     2000000   // co je na konci běhu mladší, se nehodnotí
+#define SOAK_SUPERSEDE_US  (2 * CUE_TICK_MS * 1000)  // přebití dalším požadavkem dřív = není chyba
+#define SOAK_UI_TICK_US    20000     // UI úloha vybírá události signálové úlohy
+#define SOAK_LIST_DEFAULT  10
+
+// ========================
+// Moduly, které harness nepřekládá (LittleFS, oddíl flash, boot, trasování, log)
+
+void showCaptureFrame(const uint8_t *, uint16_t, uint32_t) {}
+const uint8_t *showPlaybackFrame(uint32_t, uint16_t &len) {
+  len = 0;
+  return NULL;
+}
+bool sceneBankMapped() { return false; }
+const uint8_t *sceneBankAcquire(uint16_t &count, uint16_t &channels) {
+  count = channels = 0;
+  return NULL;
+}
+void bootMark(BootPhase) {}
+void traceRecord(TraceId, TracePhase, uint16_t) {}
+volatile uint8_t logRuntimeLevel = LOG_LEVEL_NONE;
+void logWrite(uint8_t, const char *, ...) {}
+
+// ========================
+// Scénář
+
+enum SoakOp : uint8_t {
+  OP_MODE,       // a = SignalMode
+  OP_DMX,        // a = kanál 1..512, b = hodnota na vstupní lince
+  OP_IR,         // a = scéna 1..6 (stisk jejího kódu)
+  OP_IR_REPEAT,  // NEC repeat (držené tlačítko)
+  OP_WEB,        // a = kanál 1..512, b = hodnota (živé přepsání z webu)
+  OP_SAVE        // uložení scén z webu – dávka CMD_SET_SCENE_VALUE
+};
+
+struct SoakEvent {
+  uint64_t us;
+  SoakOp   op;
+  uint16_t a;
+  uint8_t  b;
+};
+
+struct Options {
+  double      hours = 1.0;
+  const char *mode = "both";
+  uint32_t    seed = 1;
+  const char *script = NULL;
+  uint32_t    frameUs = SOAK_FRAME_US;
+  uint32_t    badPermille = 0;
+  int         list = SOAK_LIST_DEFAULT;
+};
+
+static Options opt;
+
+static uint32_t sceneCode(int scene) {
+  uint8_t cmd = 0x10 + scene;
+  return 0x00FF0000u | (cmd << 8) | (uint8_t)~cmd;   // NEC: adresa 0x00, příkaz
+}
+
+static uint8_t sceneSignature(int scene) {
+  return (uint8_t)(scene * 0x20);
+}
+
+static uint8_t scenes[SIGNAL_SCENES][SIGNAL_SCENE_CH];
+
+static void initScenes() {
+  for (int s = 0; s < SIGNAL_SCENES; s++) {
+    for (int ch = 0; ch < SIGNAL_SCENE_CH; ch++) scenes[s][ch] = (uint8_t)((s * 40 + ch * 6) & 0xFE);
+    scenes[s][SOAK_SIG_CH] = sceneSignature(s + 1);
+  }
+}
+
+// ========================
+// Měření
+
+struct Latency {
+  std::vector<uint32_t> us;
+
+  void add(uint64_t v) { us.push_back(v > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)v); }
+
+  double pct(double p) const {
+    size_t i = (size_t)(p / 100.0 * (us.size() - 1) + 0.5);
+    return us[i] / 1000.0;
+  }
+
+  void print(const char *name) {
+    if (us.empty()) {
+      printf("  %-8s no samples\n", name);
+      return;
+    }
+    std::sort(us.begin(), us.end());
+    printf("  %-8s ms  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+           name, pct(50), pct(90), pct(99), pct(99.9), us.back() / 1000.0);
+  }
+};
+
+struct Edge {
+  uint64_t riseUs;
+  uint64_t fallUs;     // 0 = kanál ještě drží 255
+  uint32_t seq;        // rámec, ve kterém hrana přišla
+  uint8_t  ch;
+  bool     sent;
+};
+
+struct Request {       // stisk IR nebo požadavek z webu
+  uint64_t us;
+  uint16_t ch;         // web: kanál 0..511
+  uint8_t  value;      // IR: scéna 1..6, web: hodnota
+  bool     seen;
+};
+
+struct IrBusy {
+  uint64_t startUs;
+  uint64_t endUs;
+  int      ch;
+};
+
+static std::vector<Edge>   edges;
+static std::vector<size_t> chEdges[7];       // indexy do edges po kanálech 1..6
+static size_t              chCursor[7];      // starší hrany už jsou vyřízené
+static std::vector<IrBusy> irBusy;
+static uint32_t            irSpurious;
+
+static std::vector<Request> presses;
+static size_t               pressCursor;
+static std::vector<Request> webSets[SOAK_WEB_CHANNELS];
+static size_t               webCursor[SOAK_WEB_CHANNELS];
+
+static Latency dmxToIr, irToDmx, webToDmx;
+static uint32_t framesOut;
+
+// ========================
+// Vstupní DMX linka
+
+static uint8_t  wire[DMX_PACKET_SIZE];
+static bool     wireHigh[7];
+static int      openEdge[7];
+static bool     inputOn;
+static bool     inputRunning;
+static uint32_t inputSeq;
+static uint32_t inputBad;
+static std::mt19937 noise;
+
+static void closeOpenEdges() {
+  for (int ch = 1; ch <= 6; ch++) {
+    if (wireHigh[ch] && openEdge[ch] >= 0) edges[openEdge[ch]].fallUs = sim::now();
+    wireHigh[ch] = false;
+    openEdge[ch] = -1;
+  }
+}
+
+static void inputFrame() {
+  if (!inputOn) {
+    inputRunning = false;
+    return;
+  }
+  inputSeq++;
+  int err = DMX_OK;
+  if (opt.badPermille && noise() % 1000 < opt.badPermille) {
+    err = DMX_ERR_UART_OVERFLOW;
+    inputBad++;
+  }
+  sim::dmxInput(wire, DMX_PACKET_SIZE, inputSeq, err);
+
+  // hrany na lince – i ve vadném rámci, firmware je pak chytí o rámec později
+  for (int ch = 1; ch <= 6; ch++) {
+    bool high = wire[ch] == 255;
+    if (high && !wireHigh[ch]) {
+      openEdge[ch] = (int)edges.size();
+      chEdges[ch].push_back(edges.size());
+      edges.push_back(Edge{ sim::now(), 0, inputSeq, (uint8_t)ch, false });
+    } else if (!high && wireHigh[ch]) {
+      edges[openEdge[ch]].fallUs = sim::now();
+      openEdge[ch] = -1;
+    }
+    wireHigh[ch] = high;
+  }
+  sim::at(sim::now() + opt.frameUs, inputFrame);
+}
+
+// ========================
+// UI úloha: příkazy do signálové fronty (při plné frontě čeká 1 ms jako
+// signalPostCmd) a vybírání událostí, aby se fronta událostí nezaplnila
+
+static std::deque<SignalCmd> uiPending;
+static bool     uiPumping;
+static uint32_t uiWaits;
+
+static void uiPump() {
+  while (!uiPending.empty() && signalCmdQueue.push(uiPending.front())) uiPending.pop_front();
+  if (uiPending.empty()) {
+    uiPumping = false;
+    return;
+  }
+  uiWaits++;
+  sim::at(sim::now() + 1000, uiPump);
+}
+
+static void uiPost(SignalCmdType type, uint8_t a = 0, uint8_t b = 0, uint32_t value = 0) {
+  uiPending.push_back(SignalCmd{ type, a, b, value });
+  if (!uiPumping) {
+    uiPumping = true;
+    uiPump();
+  }
+}
+
+static void uiTick() {
+  SignalEvt evt;
+  while (signalEvtQueue.pop(evt)) {}
+  sim::at(sim::now() + SOAK_UI_TICK_US, uiTick);
+}
+
+// ========================
+// IR úloha: decode() každý tick, dokud je co dekódovat
+
+static bool irTaskArmed;
+
+static void irTaskTick() {
+  while (irReceiverPoll()) {}
+  if (sim::irPending()) {
+    sim::at((sim::now() / 1000 + 1) * 1000, irTaskTick);
+  } else {
+    irTaskArmed = false;
+  }
+}
+
+static void irMessage(decode_type_t protocol, uint64_t value, uint16_t bits, bool repeat) {
+  sim::irCapture(protocol, value, bits, repeat);
+  if (!irTaskArmed) {
+    irTaskArmed = true;
+    sim::at((sim::now() / 1000 + 1) * 1000, irTaskTick);
+  }
+}
+
+// ========================
+// Výstupy firmwaru
+
+static int channelOfCode(uint32_t code) {
+  for (int ch = 1; ch <= 6; ch++) {
+    if (code == sceneCode(ch)) return ch;
+  }
+  return -1;
+}
+
+static void onIrSend(uint32_t code, uint64_t startUs, uint64_t endUs) {
+  int ch = channelOfCode(code);
+  irBusy.push_back(IrBusy{ startUs, endUs, ch });
+  if (ch < 0) {
+    irSpurious++;
+    return;
+  }
+  // poslední nevyřízená hrana z rámců, které už firmware přečetl;
+  // starší nevyřízené hrany téhož kanálu tím zůstávají zmeškané
+  uint32_t readSeq = sim::dmxReadSeq();
+  const std::vector<size_t> &list = chEdges[ch];
+  size_t match = list.size();
+  for (size_t k = chCursor[ch]; k < list.size() && edges[list[k]].seq <= readSeq; k++) {
+    if (!edges[list[k]].sent) match = k;
+  }
+  if (match == list.size()) {
+    irSpurious++;
+    return;
+  }
+  Edge &e = edges[list[match]];
+  e.sent = true;
+  dmxToIr.add(startUs - e.riseUs);
+  chCursor[ch] = match + 1;
+}
+
+// Nejnovější nevyřízený požadavek (od cursor, starší než rámec), který rámec
+// splňuje; starší nevyřízené tím zůstávají zmeškané
+template <typename Match>
+static void resolve(std::vector<Request> &list, size_t &cursor, uint64_t startUs, uint64_t endUs,
+                    Latency &lat, Match matches) {
+  size_t hit = list.size();
+  for (size_t k = cursor; k < list.size() && list[k].us <= startUs; k++) {
+    if (matches(list[k])) hit = k;
+  }
+  if (hit == list.size()) return;
+  list[hit].seen = true;
+  lat.add(endUs - list[hit].us);
+  cursor = hit + 1;
+}
+
+static void onDmxSent(const uint8_t *slots, uint16_t len, uint64_t startUs, uint64_t endUs) {
+  framesOut++;
+  if (len <= SOAK_SIG_CH + 1) return;
+  uint8_t sig = slots[SOAK_SIG_CH + 1];
+  resolve(presses, pressCursor, startUs, endUs, irToDmx,
+          [sig](const Request &r) { return sceneSignature(r.value) == sig; });
+  for (int ch = 0; ch < SOAK_WEB_CHANNELS; ch++) {
+    uint8_t level = slots[ch + 1];
+    resolve(webSets[ch], webCursor[ch], startUs, endUs, webToDmx,
+            [level](const Request &r) { return r.value == level; });
+  }
+}
+
+// ========================
+// Přehrání scénáře
+
+static void runEvent(const SoakEvent &ev) {
+  switch (ev.op) {
+    case OP_MODE:
+      uiPost(CMD_SET_MODE, (uint8_t)ev.a);
+      closeOpenEdges();   // firmware po vstupu do režimu bere 255 jako novou hranu
+      inputOn = ev.a == SIG_DMX_TO_IR;
+      if (inputOn && !inputRunning) {
+        inputRunning = true;
+        sim::at(sim::now(), inputFrame);
+      }
+      break;
+    case OP_DMX:
+      if (ev.a >= 1 && ev.a < DMX_PACKET_SIZE) wire[ev.a] = ev.b;
+      break;
+    case OP_IR:
+      irMessage(NEC, sceneCode(ev.a), 32, false);
+      presses.push_back(Request{ sim::now(), 0, (uint8_t)ev.a, false });
+      break;
+    case OP_IR_REPEAT:
+      irMessage(NEC, 0xFFFFFFFFFFFFFFFFULL, 0, true);
+      break;
+    case OP_WEB:
+      uiPost(CMD_SET_WEB_LEVEL, 0, 0, (uint32_t)(ev.a - 1) << 8 | ev.b);
+      if (ev.a >= 1 && ev.a <= SOAK_WEB_CHANNELS) {
+        webSets[ev.a - 1].push_back(Request{ sim::now(), (uint16_t)(ev.a - 1), ev.b, false });
+      }
+      break;
+    case OP_SAVE:
+      // /scenes posílá všechny hodnoty – tytéž, výstup se nemění, jen fronta
+      for (int s = 0; s < SIGNAL_SCENES; s++) {
+        for (int ch = 0; ch < SIGNAL_SCENE_CH; ch++) uiPost(CMD_SET_SCENE_VALUE, s, ch, scenes[s][ch]);
+      }
+      break;
+  }
+}
+
+// ========================
+// Generátor provozu
+
+static uint64_t msUs(double ms) {
+  return (uint64_t)(ms * 1000.0);
+}
+
+static void generateDmxToIr(std::mt19937 &rng, uint64_t start, uint64_t end, std::vector<SoakEvent> &out) {
+  std::uniform_real_distribution<double> u(0.0, 1.0);
+  out.push_back(SoakEvent{ start, OP_MODE, SIG_DMX_TO_IR, 0 });
+  for (int ch = 1; ch <= 6; ch++) {
+    uint64_t t = start + msUs(u(rng) * 2000);
+    while (t < end) {
+      // pulzy: 10 % krátkých (1–4 rámce), 70 % běžných, 20 % dlouhých
+      double r = u(rng);
+      double hold = r < 0.1 ? 20 + u(rng) * 70 : r < 0.8 ? 100 + u(rng) * 1400 : 1500 + u(rng) * 3500;
+      out.push_back(SoakEvent{ t, OP_DMX, (uint16_t)ch, 255 });
+      t += msUs(hold);
+      out.push_back(SoakEvent{ t, OP_DMX, (uint16_t)ch, (uint8_t)(rng() % 255) });
+      t += msUs(50 + u(rng) * 3950);
+    }
+  }
+}
+
+static void generateIrToDmx(std::mt19937 &rng, uint64_t start, uint64_t end, std::vector<SoakEvent> &out) {
+  std::uniform_real_distribution<double> u(0.0, 1.0);
+  std::exponential_distribution<double> pause(1.0 / 2000);   // ms
+  std::exponential_distribution<double> webPause(1.0 / 3000);
+  out.push_back(SoakEvent{ start, OP_MODE, SIG_IR_TO_DMX, 0 });
+
+  uint64_t t = start + msUs(500);
+  int last = 0;
+  while (t < end) {
+    int scene;
+    do scene = 1 + rng() % 6; while (scene == last);
+    last = scene;
+    out.push_back(SoakEvent{ t, OP_IR, (uint16_t)scene, 0 });
+    if (u(rng) < 0.15) {
+      int repeats = 1 + rng() % 10;
+      for (int k = 0; k < repeats; k++) {
+        t += SIM_NEC_MESSAGE_US;
+        out.push_back(SoakEvent{ t, OP_IR_REPEAT, 0, 0 });
+      }
+    }
+    // 20 % rychlých sérií (zpráva po zprávě), jinak pauza
+    t += u(rng) < 0.2 ? msUs(110 + u(rng) * 140) : msUs(150 + pause(rng));
+  }
+
+  uint8_t webLevel[SOAK_WEB_CHANNELS] = {0};
+  for (t = start + msUs(webPause(rng)); t < end; t += msUs(webPause(rng))) {
+    int ch = rng() % SOAK_WEB_CHANNELS;
+    uint8_t v;
+    do v = (uint8_t)(rng() | 1); while (v == webLevel[ch]);
+    webLevel[ch] = v;
+    out.push_back(SoakEvent{ t, OP_WEB, (uint16_t)(ch + 1), v });
+  }
+}
+
+static void generateSaves(std::mt19937 &rng, uint64_t start, uint64_t end, std::vector<SoakEvent> &out) {
+  std::exponential_distribution<double> pause(1.0 / 60000);
+  for (uint64_t t = start + msUs(pause(rng)); t < end; t += msUs(pause(rng))) {
+    out.push_back(SoakEvent{ t, OP_SAVE, 0, 0 });
+  }
+}
+
+// ========================
+// Skript: řádek = "<čas ms> <op> [argumenty]", # komentář
+//   mode idle|dmx2ir|ir2dmx   dmx <kanál> <hodnota>   ir <scéna 1..6>
+//   repeat                    web <kanál> <hodnota>   save          end
+
+static bool parseMode(const char *name, uint16_t &mode) {
+  if (!strcmp(name, "idle"))   mode = SIG_IDLE;
+  else if (!strcmp(name, "dmx2ir")) mode = SIG_DMX_TO_IR;
+  else if (!strcmp(name, "ir2dmx")) mode = SIG_IR_TO_DMX;
+  else return false;
+  return true;
+}
+
+static bool loadScript(const char *path, std::vector<SoakEvent> &out, uint64_t &endUs) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return false;
+  }
+  char line[256];
+  int lineNo = 0;
+  bool ok = true;
+  endUs = 0;
+  while (ok && fgets(line, sizeof(line), f)) {
+    lineNo++;
+    char *hash = strchr(line, '#');
+    if (hash) *hash = 0;
+    double ms = 0;
+    char op[16], arg[16] = "";
+    int a = 0, b = 0;
+    int n = sscanf(line, "%lf %15s %15s %d", &ms, op, arg, &b);
+    if (n == EOF) continue;
+    SoakEvent ev = { msUs(ms), OP_MODE, 0, 0 };
+    if (n < 2) {
+      ok = false;
+    } else if (!strcmp(op, "end")) {
+      endUs = ev.us;
+      continue;
+    } else if (n >= 3 && !strcmp(op, "mode")) {
+      ok = parseMode(arg, ev.a);
+    } else if (!strcmp(op, "repeat")) {
+      ev.op = OP_IR_REPEAT;
+    } else if (!strcmp(op, "save")) {
+      ev.op = OP_SAVE;
+    } else if (n >= 3 && !strcmp(op, "ir")) {
+      ev.op = OP_IR;
+      a = atoi(arg);
+      ok = a >= 1 && a <= 6;
+    } else if (n >= 4 && (!strcmp(op, "dmx") || !strcmp(op, "web"))) {
+      ev.op = op[0] == 'd' ? OP_DMX : OP_WEB;
+      a = atoi(arg);
+      ok = a >= 1 && a <= 512 && b >= 0 && b <= 255;
+    } else {
+      ok = false;
+    }
+    if (ev.op != OP_MODE) ev.a = (uint16_t)a;
+    ev.b = (uint8_t)b;
+    if (ok) out.push_back(ev);
+    else fprintf(stderr, "%s:%d: bad line\n", path, lineNo);
+  }
+  fclose(f);
+  if (ok && !endUs) {
+    for (const SoakEvent &ev : out) endUs = std::max(endUs, ev.us);
+    endUs += 5000000;
+  }
+  return ok;
+}
+
+// ========================
+// Souhrn
+
+static void printTime(uint64_t us) {
+  uint64_t ms = us / 1000;
+  printf("%02u:%02u:%02u.%03u", (unsigned)(ms / 3600000), (unsigned)(ms / 60000 % 60),
+         (unsigned)(ms / 1000 % 60), (unsigned)(ms % 1000));
+}
+
+static const IrBusy *irBusyDuring(uint64_t from, uint64_t to) {
+  auto it = std::lower_bound(irBusy.begin(), irBusy.end(), from,
+                             [](const IrBusy &b, uint64_t t) { return b.endUs <= t; });
+  return it != irBusy.end() && it->startUs <= to ? &*it : NULL;
+}
+
+static int reportEdges(uint64_t judgedUntil) {
+  int judged = 0, sent = 0, missed = 0;
+  for (const Edge &e : edges) {
+    if (e.riseUs > judgedUntil) continue;
+    judged++;
+    if (e.sent) {
+      sent++;
+      continue;
+    }
+    if (missed++ >= opt.list) continue;
+    printf("    missed edge  ");
+    printTime(e.riseUs);
+    printf("  ch%u  pulse ", e.ch);
+    if (e.fallUs) printf("%.1f ms", (e.fallUs - e.riseUs) / 1000.0);
+    else printf("open");
+    const IrBusy *busy = irBusyDuring(e.riseUs, e.fallUs ? e.fallUs : e.riseUs);
+    if (busy) printf("  (IR send of ch%d in progress)", busy->ch);
+    printf("\n");
+  }
+  printf("DMX->IR  edges %d  sent %d  missed %d  spurious sends %u\n", judged, sent, missed, irSpurious);
+  dmxToIr.print("latency");
+  return missed;
+}
+
+static int reportRequests(const char *name, const char *what, std::vector<Request> *lists, int count,
+                          bool ir, Latency &lat, uint64_t judgedUntil) {
+  int judged = 0, seen = 0, superseded = 0, missed = 0;
+  for (int l = 0; l < count; l++) {
+    const std::vector<Request> &list = lists[l];
+    for (size_t k = 0; k < list.size(); k++) {
+      const Request &r = list[k];
+      if (r.us > judgedUntil) continue;
+      judged++;
+      if (r.seen) {
+        seen++;
+        continue;
+      }
+      // další přišel dřív, než mohl odejít rámec – nejde o chybu firmwaru
+      if (k + 1 < list.size() && list[k + 1].us - r.us < SOAK_SUPERSEDE_US) {
+        superseded++;
+        continue;
+      }
+      if (missed++ >= opt.list) continue;
+      printf("    missed %-6s ", what);
+      printTime(r.us);
+      if (ir) printf("  scene %u\n", r.value);
+      else printf("  ch%u = %u\n", r.ch + 1, r.value);
+    }
+  }
+  printf("%-8s %s %d  in output %d  superseded %d  missed %d\n", name, what, judged, seen, superseded, missed);
+  lat.print("latency");
+  return missed;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: soak [--hours H] [--mode both|dmx2ir|ir2dmx] [--seed N] [--script FILE]\n"
+          "            [--frame-us US] [--bad-permille N] [--list N]\n"
+          "  --hours H        simulated time per mode (default 1)\n"
+          "  --script FILE    play FILE instead of generated traffic (see soak.cpp)\n"
+          "  --frame-us US    input DMX frame period (default %d)\n"
+          "  --bad-permille N corrupt N of 1000 input frames (UART overflow)\n"
+          "  --list N         print at most N missed items per kind (default %d)\n"
+          "exit status: 0 = nothing missed, 1 = missed edges/presses, 2 = usage\n",
+          SOAK_FRAME_US, SOAK_LIST_DEFAULT);
+}
+
+static bool parseArgs(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!val) return false;
+    if (!strcmp(arg, "--hours")) opt.hours = atof(val);
+    else if (!strcmp(arg, "--mode")) opt.mode = val;
+    else if (!strcmp(arg, "--seed")) opt.seed = strtoul(val, NULL, 0);
+    else if (!strcmp(arg, "--script")) opt.script = val;
+    else if (!strcmp(arg, "--frame-us")) opt.frameUs = strtoul(val, NULL, 0);
+    else if (!strcmp(arg, "--bad-permille")) opt.badPermille = strtoul(val, NULL, 0);
+    else if (!strcmp(arg, "--list")) opt.list = atoi(val);
+    else return false;
+    i++;
+  }
+  return opt.hours > 0 && opt.frameUs >= 1000 &&
+         (!strcmp(opt.mode, "both") || !strcmp(opt.mode, "dmx2ir") || !strcmp(opt.mode, "ir2dmx"));
+}
+
+int main(int argc, char **argv) {
+  if (!parseArgs(argc, argv)) {
+    usage();
+    return 2;
+  }
+
+  std::vector<SoakEvent> script;
+  uint64_t endUs = 0;
+  if (opt.script) {
+    if (!loadScript(opt.script, script, endUs)) return 2;
+  } else {
+    std::mt19937 rng(opt.seed);
+    uint64_t phaseUs = (uint64_t)(opt.hours * 3600e6);
+    uint64_t t = 0;
+    if (strcmp(opt.mode, "ir2dmx")) {
+      generateDmxToIr(rng, t, t + phaseUs, script);
+      t += phaseUs;
+    }
+    if (strcmp(opt.mode, "dmx2ir")) {
+      generateIrToDmx(rng, t, t + phaseUs, script);
+      t += phaseUs;
+    }
+    generateSaves(rng, 0, t, script);
+    endUs = t;
+  }
+  noise.seed(opt.seed + 1);
+
+  // konfigurace jako po startu: kód kanálu i = scéna i, žádné cue, výchozí priority
+  initScenes();
+  uint32_t codes[8] = {0};
+  for (int ch = 1; ch <= 6; ch++) codes[ch] = sceneCode(ch);
+  CueList cues = {};
+  Chase chase = {};
+  const uint32_t cueCodes[3] = {0};
+  const uint8_t prios[MERGE_SOURCES] = MERGE_DEFAULT_PRIORITIES;
+  const uint8_t ltp[MERGE_CHANNELS / 8] = {0};
+  installDmxDriver();
+  signalInitConfig(codes, scenes);
+  signalInitCues(cues, chase, CUE_MODE_OFF, cueCodes);
+  signalInitMerge(prios, ltp);
+
+  for (int ch = 0; ch < 7; ch++) openEdge[ch] = -1;
+  sim::onIrSend = onIrSend;
+  sim::onDmxSent = onDmxSent;
+  for (const SoakEvent &ev : script) sim::at(ev.us, [ev] { runEvent(ev); });
+  sim::at(0, uiTick);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  while (sim::now() < endUs) signalTaskStep();
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+  uint64_t judgedUntil = endUs > SOAK_SETTLE_US ? endUs - SOAK_SETTLE_US : 0;
+  printf("soak: %.1f s simulated in %.2f s (%.0fx), %zu events, %s\n", endUs / 1e6, wall,
+         wall > 0 ? endUs / 1e6 / wall : 0.0, script.size(), opt.script ? opt.script : "generated");
+  if (!opt.script) printf("  seed %u, mode %s\n", opt.seed, opt.mode);
+  int missed = reportEdges(judgedUntil);
+  missed += reportRequests("IR->DMX", "presses", &presses, 1, true, irToDmx, judgedUntil);
+  missed += reportRequests("web->DMX", "sets", webSets, SOAK_WEB_CHANNELS, false, webToDmx, judgedUntil);
+
+  const IrRxStats &ir = irRxStats();
+  printf("DMX in   frames %u  corrupted %u  overwritten before read %u\n",
+         inputSeq, inputBad, sim::dmxOverwritten());
+  printf("DMX out  frames %u\n", framesOut);
+  printf("IR rx    decoded %u  repeats %u  queue dropped %u  max pickup %.1f ms\n",
+         ir.decoded, ir.repeats, irEvents.dropped(), ir.maxLatencyUs / 1000.0);
+  printf("UI       queue-full waits %u ms  signal events dropped %u\n", uiWaits, signalEvtQueue.dropped());
+  return missed ? 1 : 0;
+}
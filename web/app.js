@@ -0,0 +1,121 @@
+// Stránka IR kódů – statická (gzip ve flash, ETag); dynamická jsou jen
+// uložená čísla kódů z /api/ircodes a importovaná knihovna z /api/irlib.
+// Formulář posílá channelN_method a codeN_manual, codeN_library_*,
+// codeN_learned nebo codeN_imported.
+var libraryData = {
+  'Samsung': {
+    'TV': {
+      'Power': 'E0E040BF', 'Volume Up': 'E0E0E01F', 'Volume Down': 'E0E0D02F',
+      'Channel Up': 'E0E048B7', 'Channel Down': 'E0E008F7'
+    },
+    'Soundbar': {
+      'Power': 'E0E0F00F', 'Mute': 'E0E0D00F', 'Volume Up': 'E0E0E01F'
+    }
+  },
+  'LG': {
+    'TV': {
+      'Power': '20DF10EF', 'Volume Up': '20DF8877', 'Volume Down': '20DF9867',
+      'Input HDMI1': '20DF00FF'
+    }
+  },
+  'Sony': {
+    'TV': {
+      'Power': 'A90', 'Volume Up': '490', 'Volume Down': 'C90', 'Mute': '290'
+    }
+  },
+  'Panasonic': {
+    'TV': {
+      'Power': '4004', 'Volume Up': '400C', 'Volume Down': '400E'
+    },
+    'DVD': {
+      'Play': '500F', 'Pause': '5010', 'Stop': '500B'
+    }
+  },
+  'Philips': {
+    'TV': {
+      'Power': '30CF', 'Volume Up': '30DF', 'Volume Down': '30EF'
+    }
+  },
+  'Yamaha': {
+    'AV Receiver': {
+      'Power': 'A55A', 'Mute': 'A45A', 'Volume Up': 'A15E', 'Volume Down': 'A05E'
+    }
+  },
+  'Generic': {
+    'Air Conditioner': {
+      'Power': '20DF10EF', 'Temp Up': '20DF40BF', 'Temp Down': '20DF807F',
+      'Mode Cool': '20DFC03F', 'Mode Heat': '20DF20DF'
+    }
+  }
+};
+var manuNames = { 'Generic': 'Air Conditioner' };
+
+function el(id) { return document.getElementById(id); }
+
+function options(keys, label) {
+  return keys.map(function (k) {
+    return "<option value='" + k + "'>" + (label ? label(k) : k) + "</option>";
+  }).join('');
+}
+
+function channelHtml(i, codes, lib) {
+  var c = 'code' + i, m = 'channel' + i + '_method';
+  var radio = function (v, text, checked) {
+    return "<input type='radio' name='" + m + "' value='" + v + "'" + (checked ? ' checked' : '') +
+           " onclick='showOptions(" + i + ")'> " + text + ' ';
+  };
+  var learned = "<option value='0'>None</option>";
+  for (var j = 1; j <= 6; j++) {
+    if (codes[j] != '00000000') learned += "<option value='" + codes[j] + "'>Code " + j + ' (0x' + codes[j] + ')</option>';
+  }
+  var imported = lib.map(function (e) {
+    return "<option value='" + e.code + "'>" + e.name + ' (0x' + e.code + ')</option>';
+  }).join('') || "<option value='0'>None</option>";
+  return "<div class='channel'><h3>Kanál " + i + '</h3>' +
+    radio('manual', 'Manual', true) + radio('library', 'Library') + radio('learned', 'Learned') +
+    radio('imported', 'Imported') +
+    "<div class='opts' id='code_manual_" + i + "'>Manual: <input type='text' name='" + c + "_manual' value='" + codes[i] + "'></div>" +
+    "<div class='opts' id='code_library_" + i + "' style='display:none'>" +
+      "Manufacturer: <select name='" + c + "_library_manufacturer' id='code_library_" + i + "_manufacturer' onchange='updateDeviceType(" + i + ")'>" +
+        options(Object.keys(libraryData), function (k) { return manuNames[k] || k; }) + '</select><br>' +
+      "Device Type: <select name='" + c + "_library_devicetype' id='code_library_" + i + "_devicetype' onchange='updateCommand(" + i + ")'></select><br>" +
+      "Command: <select name='" + c + "_library_command' id='code_library_" + i + "_command'></select>" +
+    '</div>' +
+    "<div class='opts' id='code_learned_" + i + "' style='display:none'>Learned: <select name='" + c + "_learned'>" + learned + '</select></div>' +
+    "<div class='opts' id='code_imported_" + i + "' style='display:none'>Imported (<a href='/irimport'>import</a>): " +
+      "<select name='" + c + "_imported'>" + imported + '</select></div>' +
+    '</div>';
+}
+
+function updateDeviceType(channel) {
+  var manu = el('code_library_' + channel + '_manufacturer').value;
+  el('code_library_' + channel + '_devicetype').innerHTML = options(Object.keys(libraryData[manu]));
+  updateCommand(channel);
+}
+
+function updateCommand(channel) {
+  var manu = el('code_library_' + channel + '_manufacturer').value;
+  var cmds = libraryData[manu][el('code_library_' + channel + '_devicetype').value];
+  el('code_library_' + channel + '_command').innerHTML =
+    options(Object.keys(cmds), function (k) { return k + ' (0x' + cmds[k] + ')'; });
+}
+
+function showOptions(channel) {
+  var m = document.querySelector('input[name="channel' + channel + '_method"]:checked').value;
+  el('code_manual_'  + channel).style.display = (m == 'manual')  ? 'block' : 'none';
+  el('code_library_' + channel).style.display = (m == 'library') ? 'block' : 'none';
+  el('code_learned_' + channel).style.display = (m == 'learned') ? 'block' : 'none';
+  el('code_imported_' + channel).style.display = (m == 'imported') ? 'block' : 'none';
+  if (m == 'library') updateDeviceType(channel);
+}
+
+function getJson(url) { return fetch(url).then(function (r) { return r.json(); }); }
+
+Promise.all([getJson('/api/ircodes'), getJson('/api/irlib')]).then(function (d) {
+  var codes = [''].concat(d[0].codes);   // index 1..6 = kanál
+  var html = '';
+  for (var i = 1; i <= 6; i++) html += channelHtml(i, codes, d[1].codes);
+  el('channels').innerHTML = html;
+}).catch(function () {
+  el('channels').innerText = 'Nepodařilo se načíst uložené kódy.';
+});